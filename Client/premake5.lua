@@ -3,8 +3,8 @@ project "Client"
     cppdialect "C++20"
 	staticruntime "off"
 
-    targetdir (outputdir .. "$(Configuration)/$(ProjectName)")
-	objdir (intoutputdir .. "$(Configuration)/$(ProjectName)")
+    targetdir (outputdir .. "%{cfg.buildcfg}/%{prj.name}")
+	objdir (intoutputdir .. "%{cfg.buildcfg}/%{prj.name}")
 
     pchheader "pch.h"
 	pchsource "src/pch.cpp"
@@ -18,14 +18,15 @@ project "Client"
     includedirs
     {
         "src",
-        "$(SolutionDir)Core/src",
-        "$(SolutionDir)vendor/imgui/src",
-        "$(SolutionDir)vendor/ImGuiDatePicker",
+        "%{wks.location}/Core/src",
+        "%{wks.location}/vendor/imgui/src",
+        "%{wks.location}/vendor/ImGuiDatePicker",
     }
 
     links
     {
         "Core",
+        "CoreUI",
         "ImGui",
     }
 
@@ -0,0 +1,188 @@
+#include "pch.h"
+#include "ClientCache.h"
+#include "Debugging/Log.h"
+
+namespace Client
+{
+	bool ClientCache::Open(uint32_t userId)
+	{
+		Close();
+
+		std::error_code error;
+		std::filesystem::path directory = std::filesystem::current_path() / "cache";
+		std::filesystem::create_directories(directory, error);
+
+		path = directory / ("user_" + std::to_string(userId) + ".cache");
+		load();
+
+		file.open(path, std::ios::binary | std::ios::app);
+		if (!file)
+		{
+			ERROR("Failed to open cache file {0}", path.string());
+			entries.clear();
+			return false;
+		}
+
+		TRACE("Cache loaded: {0} entries, {1} bytes", (uint32_t)entries.size(), (uint64_t)liveSize);
+		return true;
+	}
+
+	void ClientCache::Close()
+	{
+		file.close();
+		entries.clear();
+		fileSize = 0;
+		liveSize = 0;
+	}
+
+	bool ClientCache::Get(MessageResponses type, uint32_t key, Core::Response& response) const
+	{
+		auto entry = entries.find(getKey(type, key));
+		if (entry == entries.end())
+			return false;
+
+		Ref<Buffer> buffer = CreateRef<Buffer>((uint32_t)entry->second.Data.size());
+		memcpy(buffer->GetData(), entry->second.Data.data(), entry->second.Data.size());
+		response.Deserialize(buffer);
+
+		return true;
+	}
+
+	bool ClientCache::Store(MessageResponses type, uint32_t key, const Core::Response& response)
+	{
+		if (!IsOpen())
+			return true;
+
+		Ref<Buffer> buffer;
+		response.Serialize(buffer);
+
+		return storeRecord(type, key, buffer->GetData(), buffer->GetSize());
+	}
+
+	bool ClientCache::GetSyncEntries(std::vector<Core::SyncEntry>& syncEntries) const
+	{
+		auto entry = entries.find(getKey(MessageResponses::None, 0));
+		if (entry == entries.end())
+			return false;
+
+		syncEntries.resize(entry->second.Data.size() / sizeof(Core::SyncEntry));
+		memcpy(syncEntries.data(), entry->second.Data.data(), syncEntries.size() * sizeof(Core::SyncEntry));
+
+		return true;
+	}
+
+	void ClientCache::StoreSyncEntries(const std::vector<Core::SyncEntry>& syncEntries)
+	{
+		if (IsOpen())
+			storeRecord(MessageResponses::None, 0, (const char*)syncEntries.data(), syncEntries.size() * sizeof(Core::SyncEntry));
+	}
+
+	bool ClientCache::storeRecord(MessageResponses type, uint32_t key, const char* data, size_t size)
+	{
+		uint64_t version = hash(data, size);
+		Entry& entry = entries[getKey(type, key)];
+		if (entry.Version == version && entry.Data.size() == size)
+			return false;
+
+		RecordHeader header = { Magic, (uint32_t)type, key, (uint32_t)size, version };
+		file.write((const char*)&header, sizeof(header));
+		file.write(data, size);
+		file.flush();
+
+		size_t recordSize = sizeof(header) + size;
+		liveSize += recordSize - (entry.Version ? sizeof(header) + entry.Data.size() : 0);
+		fileSize += recordSize;
+
+		entry.Version = version;
+		entry.Data.assign(data, data + size);
+
+		if (fileSize > MinCompactSize && fileSize > liveSize * 2)
+		{
+			file.close();
+			compact();
+			file.open(path, std::ios::binary | std::ios::app);
+		}
+
+		return true;
+	}
+
+	// FNV-1a
+	uint64_t ClientCache::hash(const char* data, size_t size)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= (uint8_t)data[i];
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	void ClientCache::load()
+	{
+		std::ifstream input(path, std::ios::binary);
+		if (!input)
+			return;
+
+		RecordHeader header;
+		while (input.read((char*)&header, sizeof(header)))
+		{
+			if (header.Magic != Magic)
+				break;
+
+			std::vector<char> data(header.Size);
+			if (!input.read(data.data(), header.Size) || hash(data.data(), data.size()) != header.Version)
+				break;
+
+			Entry& entry = entries[getKey((MessageResponses)header.Type, header.Key)];
+			if (entry.Version)
+				liveSize -= sizeof(header) + entry.Data.size();
+
+			liveSize += sizeof(header) + data.size();
+			fileSize += sizeof(header) + data.size();
+
+			entry.Version = header.Version;
+			entry.Data = std::move(data);
+		}
+
+		input.close();
+
+		// Damaged end is cut, so records appended after it can be read next time
+		std::error_code error;
+		if (fileSize != std::filesystem::file_size(path, error) && !error)
+		{
+			WARN("Cache file {0} has damaged end, it's ignored", path.string());
+			std::filesystem::resize_file(path, fileSize, error);
+		}
+	}
+
+	// Rewrites file with newest records only, new file replaces old one after it's fully written
+	void ClientCache::compact()
+	{
+		std::filesystem::path temporaryPath = path;
+		temporaryPath += ".tmp";
+
+		std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+		for (auto& [key, entry] : entries)
+		{
+			RecordHeader header = { Magic, (uint32_t)(key >> 32), (uint32_t)key, (uint32_t)entry.Data.size(), entry.Version };
+			output.write((const char*)&header, sizeof(header));
+			output.write(entry.Data.data(), entry.Data.size());
+		}
+
+		output.close();
+		if (!output)
+		{
+			ERROR("Failed to compact cache file {0}", path.string());
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+			return;
+
+		fileSize = liveSize;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+#include "Client/MessageResponses.h"
+#include "Database/Response.h"
+#include "Networking/Sync.h"
+
+namespace Client
+{
+	// Last responses of read requests of one user, kept on disk, so UI is rendered from them right after login
+	// File is append-only, record is written only when response changed and newest record of type and key wins when file is loaded
+	// Partially written record at the end of file (crash) is ignored, file is rewritten with live records only when it grows too much
+	class ClientCache
+	{
+	public:
+		ClientCache() = default;
+		~ClientCache() { Close(); }
+
+		ClientCache(const ClientCache&) = delete;
+
+		// Loads cache of user from cache directory
+		bool Open(uint32_t userId);
+		void Close();
+
+		inline bool IsOpen() const { return file.is_open(); }
+
+		// Key separates responses of the same type (team id for team data), returns false if nothing is cached
+		bool Get(MessageResponses type, uint32_t key, Core::Response& response) const;
+		// Returns false if response is the same as cached one
+		bool Store(MessageResponses type, uint32_t key, const Core::Response& response);
+
+		// Sequences of scopes from last sync with server, stored as record of type None
+		bool GetSyncEntries(std::vector<Core::SyncEntry>& syncEntries) const;
+		void StoreSyncEntries(const std::vector<Core::SyncEntry>& syncEntries);
+	private:
+		struct RecordHeader
+		{
+			uint32_t Magic;
+			uint32_t Type;
+			uint32_t Key;
+			uint32_t Size;
+			uint64_t Version; // Hash of serialized response
+		};
+
+		struct Entry
+		{
+			uint64_t Version = 0;
+			std::vector<char> Data;
+		};
+
+		static constexpr uint32_t Magic = 0x43504D44; // DMPC
+		static constexpr size_t MinCompactSize = 256 * 1024;
+
+		static inline uint64_t getKey(MessageResponses type, uint32_t key) { return (uint64_t)type << 32 | key; }
+		static uint64_t hash(const char* data, size_t size);
+
+		bool storeRecord(MessageResponses type, uint32_t key, const char* data, size_t size);
+
+		void load();
+		void compact();
+
+		std::filesystem::path path;
+		std::ofstream file;
+		size_t fileSize = 0;
+		size_t liveSize = 0; // Size of newest records
+
+		std::unordered_map<uint64_t, Entry> entries;
+	};
+}
\ No newline at end of file
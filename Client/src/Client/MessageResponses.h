@@ -0,0 +1,70 @@
+#pragma once
+
+namespace Client
+{
+	// Enum of server response ids (instead of using raw numbers, casting them to uint32 anyway)
+	enum class MessageResponses : uint32_t
+	{
+		None = 0, // No response
+		Login,
+		Register,
+		CheckEmail,
+		LinkTeamToUser,
+		UpdateTeams, // Reserved by server
+		UpdateMessages, // Reserved by server
+		UpdateUsers, // Reserved by server
+		UpdateInvites, // Reserved by server
+		UpdateNotifications, // Reserved by server
+		UpdateAssignments, // Reserved by server
+		ProcessAssignmentAttachments, // Reserved by server
+		LinkAssignmentToUser,
+		UpdateLoggedUser,
+		CheckInvite,
+		CheckTeam,
+		ChangeUsername,
+		ChangePassword,
+		ProcessTeams,
+		ProcessTeamMessages,
+		ProcessTeamUsers,
+		ProcessInvites,
+		ProcessNotifications,
+		ProcessAssignments,
+		ProcessAssignmentsUsers,
+		ProcessNewTeamMessages,
+	};
+
+	inline const char* GetMessageResponseName(MessageResponses response)
+	{
+		switch (response)
+		{
+			case MessageResponses::None: return "None";
+			case MessageResponses::Login: return "Login";
+			case MessageResponses::Register: return "Register";
+			case MessageResponses::CheckEmail: return "CheckEmail";
+			case MessageResponses::LinkTeamToUser: return "LinkTeamToUser";
+			case MessageResponses::UpdateTeams: return "UpdateTeams";
+			case MessageResponses::UpdateMessages: return "UpdateMessages";
+			case MessageResponses::UpdateUsers: return "UpdateUsers";
+			case MessageResponses::UpdateInvites: return "UpdateInvites";
+			case MessageResponses::UpdateNotifications: return "UpdateNotifications";
+			case MessageResponses::UpdateAssignments: return "UpdateAssignments";
+			case MessageResponses::ProcessAssignmentAttachments: return "ProcessAssignmentAttachments";
+			case MessageResponses::LinkAssignmentToUser: return "LinkAssignmentToUser";
+			case MessageResponses::UpdateLoggedUser: return "UpdateLoggedUser";
+			case MessageResponses::CheckInvite: return "CheckInvite";
+			case MessageResponses::CheckTeam: return "CheckTeam";
+			case MessageResponses::ChangeUsername: return "ChangeUsername";
+			case MessageResponses::ChangePassword: return "ChangePassword";
+			case MessageResponses::ProcessTeams: return "ProcessTeams";
+			case MessageResponses::ProcessTeamMessages: return "ProcessTeamMessages";
+			case MessageResponses::ProcessTeamUsers: return "ProcessTeamUsers";
+			case MessageResponses::ProcessInvites: return "ProcessInvites";
+			case MessageResponses::ProcessNotifications: return "ProcessNotifications";
+			case MessageResponses::ProcessAssignments: return "ProcessAssignments";
+			case MessageResponses::ProcessAssignmentsUsers: return "ProcessAssignmentsUsers";
+			case MessageResponses::ProcessNewTeamMessages: return "ProcessNewTeamMessages";
+		}
+
+		return "Unknown";
+	}
+}
\ No newline at end of file
@@ -2,18 +2,36 @@
 
 namespace Client
 {
+	// Position of message parts in chat list, computed once for width of list
+	struct MessageLayout
+	{
+		float Height = 0.0f; // Height of whole message including item spacing
+		float NameX = 0.0f;
+		float ContentX = 0.0f;
+	};
+
 	class Message
 	{
 	public:
-		// Constructor for initializing author name and message content
-		Message(const char* author, const char* message) : authorName(author), content(message) {}
+		// Constructor for initializing id, author, message content and if message was sent by logged user
+		Message(uint32_t id, uint32_t authorId, const char* author, const char* message, bool mine) : id(id), authorId(authorId), authorName(author), content(message), isMine(mine) {}
 
 		// Getters
+		inline uint32_t GetId() const { return id; }
+		inline uint32_t GetAuthorId() const { return authorId; }
 		inline const std::string& GetAuthorName() const { return authorName; }
 		inline const std::string& GetContent() const { return content; }
 		inline uint32_t GetContentSize() const { return content.size(); }
+		inline bool IsMine() const { return isMine; }
+
+		inline MessageLayout& GetLayout() { return layout; }
 	private:
+		uint32_t id;
+		uint32_t authorId;
 		std::string authorName;
 		std::string content;
+		bool isMine;
+
+		MessageLayout layout;
 	};
 }
\ No newline at end of file
@@ -22,10 +22,24 @@ namespace Client
 		// Message getters
 		inline const uint32_t GetMessageCount() const { return messages.size(); }
 		inline const std::vector<Ref<Message>>& GetMessages() const { return messages; }
+		inline uint32_t GetLastMessageId() const { return messages.empty() ? 0 : messages.back()->GetId(); }
 
 		// Message vector wrappers
 		inline void AddMessage(const Ref<Message>& message) { messages.push_back(message); }
-		inline void ClearMessages() { messages.clear(); }
+		inline void ClearMessages() { messages.clear(); messageOffsets.clear(); }
+
+		// Vertical offsets of messages in chat list (one more than messages, last is list height)
+		// Offsets are valid for layout width, only missing ones are appended after new messages arrive
+		inline std::vector<float>& GetMessageOffsets(float width)
+		{
+			if (width != layoutWidth || messageOffsets.size() > messages.size() + 1)
+			{
+				layoutWidth = width;
+				messageOffsets.clear();
+			}
+
+			return messageOffsets;
+		}
 
 		// Users getters
 		inline const uint32_t GetUserCount() const { return users.size(); }
@@ -40,6 +54,8 @@ namespace Client
 		std::string name;
 
 		std::vector<Ref<Message>> messages;
+		std::vector<float> messageOffsets;
+		float layoutWidth = -1.0f;
 		std::vector<Ref<User>> users;
 	};
 }
\ No newline at end of file
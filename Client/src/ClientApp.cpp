@@ -9,6 +9,7 @@
 #include "Resources/Fonts.h"
 #include "Database/Response.h"
 #include "Database/Hash.h"
+#include "Database/Statements.h"
 
 #include "Utils/FileDialog.h"
 #include "Utils/FileReader.h"
@@ -34,6 +35,10 @@ namespace Client
 	// Global int to store id of invited user
 	uint32_t invitedUserId = 0;
 
+	// Team messages are read in pages of this size, with this number of values per message
+	constexpr uint32_t MessagesPageSize = 40;
+	constexpr uint32_t MessageColumns = 5;
+
 	void SetFileExtension(const char* fileName)
 	{
 		const char* dot = strrchr(fileName, '.');
@@ -50,6 +55,8 @@ namespace Client
 
 		LoadConfig();
 		networkInterface = Core::NetworkClientInterface::Create(address, port, messageQueue);
+
+		AttachWindow(Core::Window::Create(specs.WindowWidth, specs.WindowHeight, specs.Title));
 		window->SetRenderFunction([this]() { Render(); });
 		SetStyle();
 
@@ -99,6 +106,18 @@ namespace Client
 
 	void ClientApp::ProcessMessageQueue()
 	{
+		if (newSession.exchange(false))
+		{
+			// Responses of pending requests will never come
+			requests.Clear();
+			syncPending = false;
+			syncRequested = false;
+
+			// Server could have been restarted, sync tells what changed meanwhile
+			if (state == ClientState::Home)
+				SendSyncMessage();
+		}
+
 		for (uint32_t i = 0; i < messageQueue.GetCount(); i++)
 			ProcessMessage();
 	}
@@ -107,222 +126,229 @@ namespace Client
 	{
 		Core::Message& message = messageQueue.Get();
 
+		// Responses to requests with callback are handled by it
+		if (requests.Complete(message))
+		{
+			messageQueue.Pop();
+			return;
+		}
+
 		if (message.GetType() == Core::MessageType::Response)
 		{
 			Core::Response response;
 			response.Deserialize(message.Body.Content);
 
-			switch ((MessageResponses)response.GetTaskId())
+			ProcessResponse(response);
+		}
+		else if (message.GetType() == Core::MessageType::DownloadFile)
+		{
+			auto path = FileDialog::SaveFile(downloadFileExtension.c_str());
+			if (!path.empty())
+				FileWriter::WriteFile(path, message.Body.Content);
+		}
+
+		messageQueue.Pop();
+	}
+
+	void ClientApp::ProcessResponse(Core::Response& response)
+	{
+		switch ((MessageResponses)response.GetTaskId())
+		{
+			case MessageResponses::Login: // Login
 			{
-				case MessageResponses::Login: // Login
+				// Response: id, password hash, first name, last name, email, role
+				if (response.HasData() && Core::ValidateHash(loginData.Password, response.GetString(1)))
 				{
-					// Response: id, password hash, first name, last name, email, role
-					if (response.HasData() && Core::ValidateHash(loginData.Password, response[1].GetValueCharPtr()))
-					{
-						loggedUser.SetId(response[0].GetValue<int>());
-						loggedUser.SetName(std::string(response[2].GetValueCharPtr()) + " " + response[3].GetValueCharPtr());
-						loggedUser.SetEmail(response[4].GetValueCharPtr());
+					loggedUser.SetId(response.GetInt(0));
+					loggedUser.SetName(std::string(response.GetString(2)) + " " + response.GetString(3));
+					loggedUser.SetEmail(response.GetString(4));
 
-						if (!strcmp(response[5].GetValueCharPtr(), "admin"))
-							loggedUser.SetAdminPrivileges(true);
-						else
-							loggedUser.SetAdminPrivileges(false);
+					if (!strcmp(response.GetString(5), "admin"))
+						loggedUser.SetAdminPrivileges(true);
+					else
+						loggedUser.SetAdminPrivileges(false);
+
+					loginData = LoginData();
+					state = ClientState::Home;
+
+					// State from last session is shown before server responds
+					syncEntries.clear();
+					LoadCache();
 
-						loginData = LoginData();
-						state = ClientState::Home;
+					// Sync is sent before reads, so it's response sets sequences reads are consistent with
+					// With sequences of last session only data changed since then is read
+					bool synced = !syncEntries.empty() && syncEntries[0].Sequence;
+					SendSyncMessage();
 
+					if (!synced)
+					{
 						ReadUsersTeams();
 						ReadUsersInvites();
 						ReadUsersNotifications();
 					}
-					else
-						loginData.Error = LoginErrorType::Incorrect;
+				}
+				else
+					loginData.Error = LoginErrorType::Incorrect;
 
-					break;
+				break;
+			}
+			case MessageResponses::Register: // Register
+			{
+				if (response.GetBool(0))
+				{
+					registerData = RegisterData();
+					state = ClientState::Login;
 				}
-				case MessageResponses::Register: // Register
+				else
+					registerData.Error = RegisterErrorType::Error;
+
+				break;
+			}
+			case MessageResponses::CheckEmail: // Check email
+			{
+				// Respsonse: id, email
+				if (state == ClientState::Home)
 				{
-					if (response[0].GetValue<bool>())
+					if (!loggedUser.HasSelectedTeam() || !loggedUser.IsTeamOwner(loggedUser.GetSelectedTeam()))
+						break;
+
+					if (response.HasData())
 					{
-						registerData = RegisterData();
-						state = ClientState::Login;
+						invitedUserId = response.GetInt(0);
+						SendCheckInviteMessage(invitedUserId);
 					}
 					else
-						registerData.Error = RegisterErrorType::Error;
-
-					break;
+						inviteState = InviteState::NotExisting;
 				}
-				case MessageResponses::CheckEmail: // Check email
+				else
 				{
-					// Respsonse: id, email
-					if (state == ClientState::Home)
-					{
-						if (!loggedUser.HasSelectedTeam() || !loggedUser.IsTeamOwner(loggedUser.GetSelectedTeam()))
-							break;
-
-						if (response.HasData())
-						{
-							invitedUserId = response[0].GetValue<int>();
-							SendCheckInviteMessage(invitedUserId);
-						}
-						else
-							inviteState = InviteState::NotExisting;
-					}
+					if (!response.HasData())
+						SendRegisterMessage();
 					else
-					{
-						if (!response.HasData())
-							SendRegisterMessage();
-						else
-							registerData.Error = RegisterErrorType::Existing;
-					}
+						registerData.Error = RegisterErrorType::Existing;
+				}
 
+				break;
+			}
+			case MessageResponses::CheckInvite:
+			{
+				if (!loggedUser.HasSelectedTeam() || !loggedUser.IsTeamOwner(loggedUser.GetSelectedTeam()))
 					break;
-				}
-				case MessageResponses::CheckInvite:
-				{
-					if (!loggedUser.HasSelectedTeam() || !loggedUser.IsTeamOwner(loggedUser.GetSelectedTeam()))
-						break;
 
-					if (!response.HasData())
-						SendCheckTeamMessage(invitedUserId);
-					else
-						inviteState = InviteState::AlreadyInvited;
+				if (!response.HasData())
+					SendCheckTeamMessage(invitedUserId);
+				else
+					inviteState = InviteState::AlreadyInvited;
 
+				break;
+			}
+			case MessageResponses::CheckTeam:
+			{
+				if (!loggedUser.HasSelectedTeam() || !loggedUser.IsTeamOwner(loggedUser.GetSelectedTeam()))
 					break;
-				}
-				case MessageResponses::CheckTeam:
+
+				if (!response.HasData())
 				{
-					if (!loggedUser.HasSelectedTeam() || !loggedUser.IsTeamOwner(loggedUser.GetSelectedTeam()))
-						break;
+					inviteState = InviteState::InviteSuccessful;
 
-					if (!response.HasData())
-					{
-						inviteState = InviteState::InviteSuccessful;
+					Core::Command command((uint32_t)MessageResponses::None);
+					command.SetType(Core::CommandType::Command);
 
-						Core::Command command((uint32_t)MessageResponses::None);
-						command.SetType(Core::CommandType::Command);
+					command.SetCommandString(Core::Statements::InsertInvite);
+					command.AddInt(invitedUserId);
+					command.AddInt(loggedUser.GetSelectedTeam().GetId());
 
-						command.SetCommandString("INSERT INTO invites (user_id, team_id) VALUES (?, ?);");
-						command.AddData(new Core::DatabaseInt(invitedUserId));
-						command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
+					SendCommandMessage(command);
 
-						SendCommandMessage(command);
+					std::string message = "You have been invited to ";
+					message += loggedUser.GetSelectedTeam().GetName();
+					SendNotificationMessage(invitedUserId, message.c_str());
+				}
+				else
+					inviteState = InviteState::AlreadyInTeam;
 
-						std::string message = "You have been invited to ";
-						message += loggedUser.GetSelectedTeam().GetName();
-						SendNotificationMessage(invitedUserId, message.c_str());
-					}
-					else
-						inviteState = InviteState::AlreadyInTeam;
+				break;
+			}
+			case MessageResponses::LinkTeamToUser: // Create users_teams relationship
+			{
+				if (response.GetBool(0))
+				{
+					int id = response.GetInt(1);
+					
+					Core::Command command((uint32_t)MessageResponses::None);
+					command.SetType(Core::CommandType::Command);
 
-					break;
+					command.SetCommandString(Core::Statements::InsertTeamMember);
+					command.AddInt(loggedUser.GetId());
+					command.AddInt(id);
+
+					SendCommandMessage(command);
 				}
-				case MessageResponses::LinkTeamToUser: // Create users_teams relationship
+				else
+					ERROR("Team addition failed!");
+
+				break;
+			}
+			case MessageResponses::LinkAssignmentToUser: // Create users_assignments relationship and create it's attachments
+			{
+				if (response.GetBool(0))
 				{
-					if (response[0].GetValue<bool>())
+					int assignmentId = response.GetInt(1);
+
+					for (auto& [id, assignmentUser] : editingAssignmentData.GetUsers())
 					{
-						int id = response[1].GetValue<int>();
-						
 						Core::Command command((uint32_t)MessageResponses::None);
 						command.SetType(Core::CommandType::Command);
 
-						command.SetCommandString("INSERT INTO users_teams (user_id, team_id) VALUES (?, ?);");
-						command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
-						command.AddData(new Core::DatabaseInt(id));
-
+						command.SetCommandString(Core::Statements::InsertAssignmentUser);
+						command.AddInt(id);
+						command.AddInt(assignmentId);
 						SendCommandMessage(command);
 					}
-					else
-						ERROR("Team addition failed!");
 
-					break;
-				}
-				case MessageResponses::LinkAssignmentToUser: // Create users_assignments relationship and create it's attachments
-				{
-					if (response[0].GetValue<bool>())
+					// Create attachments
+					for (Ref<File>& attachment : editingAssignmentData.GetAttachments())
 					{
-						int assignmentId = response[1].GetValue<int>();
-
-						for (auto& [id, assignmentUser] : editingAssignmentData.GetUsers())
-						{
-							Core::Command command((uint32_t)MessageResponses::None);
-							command.SetType(Core::CommandType::Command);
-
-							command.SetCommandString("INSERT INTO users_assignments (user_id, assignment_id) VALUES (?, ?);");
-							command.AddData(new Core::DatabaseInt(id));
-							command.AddData(new Core::DatabaseInt(assignmentId));
-							SendCommandMessage(command);
-						}
-
-						// Create attachments
-						for (Ref<File>& attachment : editingAssignmentData.GetAttachments())
-						{
-							attachment->SetId(assignmentId);
-							SendAttachment(attachment);
-						}
-
-						editingAssignmentData = AssignmentData();
+						attachment->SetId(assignmentId);
+						SendAttachment(attachment);
 					}
-					else
-						ERROR("Assignment addition failed!");
 
-					break;
-				}
-				case MessageResponses::UpdateTeams: // Update teams
-				{
-					ReadUsersTeams();
-
-					break;
+					editingAssignmentData = AssignmentData();
 				}
-				case MessageResponses::UpdateMessages: // Update messages
-				{
-					if (loggedUser.HasSelectedTeam())
-						ReadSelectedTeamMessages();
-
-					break;
-				}
-				case MessageResponses::UpdateUsers: // Update users
-				{
-					if (state == ClientState::Home)
-						UpdateLoggedUser();
-
-					if (loggedUser.HasSelectedTeam())
-						ReadSelectedTeamUsers();
-
-					break;
-				}
-				case MessageResponses::UpdateInvites:
-				{
-					ReadUsersInvites();
-
-					break;
-				}
-				case MessageResponses::UpdateNotifications:
-				{
-					ReadUsersNotifications();
+				else
+					ERROR("Assignment addition failed!");
 
-					break;
-				}
-				case MessageResponses::UpdateAssignments:
-				{
-					if (loggedUser.HasSelectedTeam())
-						ReadAssignments();
+				break;
+			}
+			// Server broadcasts updates after every change, sync tells which of them concern this user
+			case MessageResponses::UpdateTeams:
+			case MessageResponses::UpdateMessages:
+			case MessageResponses::UpdateUsers:
+			case MessageResponses::UpdateInvites:
+			case MessageResponses::UpdateNotifications:
+			case MessageResponses::UpdateAssignments:
+			{
+				if (state == ClientState::Home)
+					SendSyncMessage();
 
-					break;
-				}
-				case MessageResponses::UpdateLoggedUser:
-				{
-					loggedUser.SetName(std::string(response[0].GetValueCharPtr()) + " " + std::string(response[1].GetValueCharPtr()));
-					loggedUser.SetEmail(response[2].GetValueCharPtr());
+				break;
+			}
+			case MessageResponses::UpdateLoggedUser:
+			{
+				loggedUser.SetName(std::string(response.GetString(0)) + " " + std::string(response.GetString(1)));
+				loggedUser.SetEmail(response.GetString(2));
 
-					if (std::string(response[3].GetValueCharPtr()) == "user")
-						loggedUser.SetAdminPrivileges(false);
-					else
-						loggedUser.SetAdminPrivileges(true);
+				if (std::string(response.GetString(3)) == "user")
+					loggedUser.SetAdminPrivileges(false);
+				else
+					loggedUser.SetAdminPrivileges(true);
 
-					break;
-				}
-				case MessageResponses::ProcessTeams: // Process teams
+				break;
+			}
+			case MessageResponses::ProcessTeams: // Process teams
+			{
+				// Teams are rebuilt only if they changed, so unchanged teams keep their loaded messages and users
+				if (cache.Store(MessageResponses::ProcessTeams, 0, response) || !loggedUser.HasTeams())
 				{
 					loggedUser.ClearTeams();
 
@@ -332,9 +358,9 @@ namespace Client
 					{
 						// Store first team reference
 						if (i != 0)
-							loggedUser.AddTeam(new Team(response[i].GetValue<int>(), response[i + 1].GetValue<int>(), response[i + 2].GetValueCharPtr())); // Add a team to team vector
+							loggedUser.AddTeam(new Team(response.GetInt(i), response.GetInt(i + 1), response.GetString(i + 2))); // Add a team to team vector
 						else
-							firstTeam = loggedUser.AddTeam(new Team(response[i].GetValue<int>(), response[i + 1].GetValue<int>(), response[i + 2].GetValueCharPtr())); // Add a team to team vector and store it's reference
+							firstTeam = loggedUser.AddTeam(new Team(response.GetInt(i), response.GetInt(i + 1), response.GetString(i + 2))); // Add a team to team vector and store it's reference
 					}
 
 					if (!loggedUser.IsSelectedTeamValid())
@@ -346,162 +372,337 @@ namespace Client
 						else
 							loggedUser.UnselectTeam();
 					}
+				}
 
-					// Read team messages and users if team is selected
-					if (loggedUser.HasSelectedTeam())
-					{
-						ReadSelectedTeamMessages();
-						ReadSelectedTeamUsers();
-						ReadAssignments();
-					}
-					
-					break;
+				// Read team messages and users if team is selected
+				if (loggedUser.HasSelectedTeam())
+				{
+					ReadSelectedTeamMessages();
+					ReadSelectedTeamUsers();
+					ReadAssignments();
 				}
-				case MessageResponses::ProcessTeamMessages: // Process team messages
+				
+				break;
+			}
+			case MessageResponses::ProcessTeamMessages: // Process team messages
+			{
+				if (loggedUser.HasSelectedTeam())
 				{
-					if (loggedUser.HasSelectedTeam())
-					{
-						loggedUser.GetSelectedTeam().ClearMessages();
+					Team& team = loggedUser.GetSelectedTeam();
+					cache.Store(MessageResponses::ProcessTeamMessages, team.GetId(), response);
 
-						// Load messages
-						for (uint32_t i = 0; i < response.GetDataCount(); i += 4) // Response: id, content, first name, last name 
-						{
-							// Construct full name
-							std::string name = std::string(response[i + 2].GetValueCharPtr()) + " " + response[i + 3].GetValueCharPtr();
-							// Add message
-							loggedUser.GetSelectedTeam().AddMessage(new Message(name.c_str(), response[i + 1].GetValueCharPtr()));
-						}
-					}
+					team.ClearMessages();
+					AddTeamMessages(team, response);
+				}
 
+				break;
+			}
+			case MessageResponses::ProcessNewTeamMessages: // Process messages newer than the last loaded one
+			{
+				if (!loggedUser.HasSelectedTeam())
 					break;
-				}
-				case MessageResponses::ProcessTeamUsers:
+
+				Team& team = loggedUser.GetSelectedTeam();
+				Core::Response messages((uint32_t)MessageResponses::ProcessTeamMessages);
+
+				// Full page could leave gap between loaded and new messages, so it replaces them
+				if (response.GetDataCount() >= MessagesPageSize * MessageColumns)
+					team.ClearMessages();
+				else
 				{
-					if (loggedUser.HasSelectedTeam())
+					// Cached page is extended by new messages and keeps the newest ones
+					Core::Response cached;
+					if (cache.Get(MessageResponses::ProcessTeamMessages, team.GetId(), cached))
 					{
-						loggedUser.GetSelectedTeam().ClearUsers();
+						uint32_t first = FindNewMessages(response, cached.HasData() ? cached.GetInt(cached.GetDataCount() - MessageColumns) : 0);
+						uint32_t keep = std::min(cached.GetDataCount(), MessagesPageSize * MessageColumns - (response.GetDataCount() - first));
 
-						// Load team users
-						for (uint32_t i = 0; i < response.GetDataCount(); i += 3) // Response: id, first name, last name 
-						{
-							// Construct full name
-							std::string name = std::string(response[i + 1].GetValueCharPtr()) + " " + response[i + 2].GetValueCharPtr();
-							// Add user
-							loggedUser.GetSelectedTeam().AddUser(new User(response[i].GetValue<int>(), name));
-						}
+						messages.AppendData(cached, cached.GetDataCount() - keep, keep);
+						messages.AppendData(response, first, response.GetDataCount() - first);
 					}
-
-					break;
 				}
-				case MessageResponses::ProcessInvites:
-				{
-					loggedUser.ClearInvites();
-
-					// Load user invites
-					for (uint32_t i = 0; i < response.GetDataCount(); i += 3) // Response: id, team id, team name
-						loggedUser.AddInvite(new Invite(response[i].GetValue<int>(), response[i + 1].GetValue<int>(), response[i + 2].GetValueCharPtr())); // Add invite
 
-					break;
-				}
-				case MessageResponses::ProcessNotifications:
-				{
-					loggedUser.ClearNotifications();
+				if (!messages.HasData())
+					messages.AppendData(response);
 
-					// Load user notifications
-					for (uint32_t i = 0; i < response.GetDataCount(); i += 2) // Response: id, message
-						loggedUser.AddNotification(new Notification(response[i].GetValue<int>(), response[i + 1].GetValueCharPtr())); // Add notification
+				cache.Store(MessageResponses::ProcessTeamMessages, team.GetId(), messages);
+				AddTeamMessages(team, response);
 
-					break;
-				}
-				case MessageResponses::ProcessAssignments:
+				break;
+			}
+			case MessageResponses::ProcessTeamUsers:
+			{
+				if (loggedUser.HasSelectedTeam())
 				{
-					loggedUser.ClearAssignments();
+					cache.Store(MessageResponses::ProcessTeamUsers, loggedUser.GetSelectedTeam().GetId(), response);
+					loggedUser.GetSelectedTeam().ClearUsers();
 
-					for (uint32_t i = 0; i < response.GetDataCount(); i += 8) // Response: id, name, description, status, rating, rating_description, deadline, submitted_at
+					// Load team users
+					for (uint32_t i = 0; i < response.GetDataCount(); i += 3) // Response: id, first name, last name 
 					{
-						const char* dbStatus = response[i + 3].GetValueCharPtr();
-						AssignmentStatus status;
+						// Construct full name
+						std::string name = std::string(response.GetString(i + 1)) + " " + response.GetString(i + 2);
+						// Add user
+						loggedUser.GetSelectedTeam().AddUser(new User(response.GetInt(i), name));
+					}
+				}
 
-						if (!strcmp(dbStatus, "in_progress"))
-							status = AssignmentStatus::InProgress;
-						else if (!strcmp(dbStatus, "submitted"))
-							status = AssignmentStatus::Submitted;
-						else
-							status = AssignmentStatus::Rated;
+				break;
+			}
+			case MessageResponses::ProcessInvites:
+			{
+				cache.Store(MessageResponses::ProcessInvites, 0, response);
+				loggedUser.ClearInvites();
 
-						Ref<Assignment> assignment = new Assignment(response[i].GetValue<int>(), response[i + 1].GetValueCharPtr(), response[i + 2].GetValueCharPtr(), status, response[i + 4].GetValue<int>(), response[i + 5].GetValueCharPtr(), response[i + 6].GetValue<time_t>(), response[i + 7].GetValue<time_t>());
-						loggedUser.AddAssignment(response[i].GetValue<int>(), assignment); // Add assignment
-						ReadAssignmentsUsers(assignment); // Read assignment's users
-						ReadAssignmentsAttachments(assignment); // Read assignment's attachments
-					}
+				// Load user invites
+				for (uint32_t i = 0; i < response.GetDataCount(); i += 3) // Response: id, team id, team name
+					loggedUser.AddInvite(new Invite(response.GetInt(i), response.GetInt(i + 1), response.GetString(i + 2))); // Add invite
 
-					break;
-				}
-				case MessageResponses::ProcessAssignmentsUsers:
-				{
-					if (response.HasData())
-					{
-						Ref<Assignment> assignment = loggedUser.GetAssignments()[response[0].GetValue<int>()];
-						if (assignment)
-						{
-							assignment->ClearUsers();
+				break;
+			}
+			case MessageResponses::ProcessNotifications:
+			{
+				cache.Store(MessageResponses::ProcessNotifications, 0, response);
+				loggedUser.ClearNotifications();
 
-							for (uint32_t i = 0; i < response.GetDataCount(); i += 4) // Response: assignment id, user id, first_name, last_name
-							{
-								// Construct full name
-								std::string name = std::string(response[i + 2].GetValueCharPtr()) + " " + response[i + 3].GetValueCharPtr();
-								// Add user to assignment
-								Ref<User> user = new User(response[i + 1].GetValue<int>(), name);
-								assignment->AddUser(user);
-							}
-						}
-					}
+				// Load user notifications
+				for (uint32_t i = 0; i < response.GetDataCount(); i += 2) // Response: id, message
+					loggedUser.AddNotification(new Notification(response.GetInt(i), response.GetString(i + 1))); // Add notification
 
-					break;
-				}
-				case MessageResponses::ProcessAssignmentAttachments:
-				{
-					if (response.HasData())
-					{
-						Ref<Assignment> assignment = loggedUser.GetAssignments()[response[0].GetValue<int>()];
-						if (assignment)
-						{
-							assignment->ClearAttachments();
+				break;
+			}
+			case MessageResponses::ProcessAssignments:
+			{
+				if (loggedUser.HasSelectedTeam())
+					cache.Store(MessageResponses::ProcessAssignments, loggedUser.GetSelectedTeam().GetId(), response);
 
-							for (uint32_t i = 0; i < response.GetDataCount(); i += 4) // Response: assignment id, attachment id, file name, by_user
-								assignment->AddAttachment(new File(response[i + 1].GetValue<int>(), response[i + 2].GetValueCharPtr(), response[i + 3].GetValue<bool>()));
-						}
-					}
+				loggedUser.ClearAssignments();
 
-					break;
-				}
-				case MessageResponses::ChangeUsername:
+				for (uint32_t i = 0; i < response.GetDataCount(); i += 8) // Response: id, name, description, status, rating, rating_description, deadline, submitted_at
 				{
-					changeUsernameState = response[0].GetValue<int>() ? ChangeUsernameState::ChangeSuccessful : ChangeUsernameState::Error;
+					const char* dbStatus = response.GetString(i + 3);
+					AssignmentStatus status;
 
-					break;
-				}
-				case MessageResponses::ChangePassword:
-				{
-					changePasswordState = response[0].GetValue<int>() ? ChangePasswordState::ChangeSuccessful : ChangePasswordState::Error;
+					if (!strcmp(dbStatus, "in_progress"))
+						status = AssignmentStatus::InProgress;
+					else if (!strcmp(dbStatus, "submitted"))
+						status = AssignmentStatus::Submitted;
+					else
+						status = AssignmentStatus::Rated;
 
-					break;
+					Ref<Assignment> assignment = new Assignment(response.GetInt(i), response.GetString(i + 1), response.GetString(i + 2), status, response.GetInt(i + 4), response.GetString(i + 5), response.GetTimestamp(i + 6), response.GetTimestamp(i + 7));
+					loggedUser.AddAssignment(response.GetInt(i), assignment); // Add assignment
+
+					// Users and attachments are not cached, they are read when server sends assignments
+					if (processingCache)
+						continue;
+
+					ReadAssignmentsUsers(assignment); // Read assignment's users
+					ReadAssignmentsAttachments(assignment); // Read assignment's attachments
 				}
+
+				break;
+			}
+			case MessageResponses::ChangeUsername:
+			{
+				changeUsernameState = response.GetInt(0) ? ChangeUsernameState::ChangeSuccessful : ChangeUsernameState::Error;
+
+				break;
+			}
+			case MessageResponses::ChangePassword:
+			{
+				changePasswordState = response.GetInt(0) ? ChangePasswordState::ChangeSuccessful : ChangePasswordState::Error;
+
+				break;
 			}
 		}
-		else if (message.GetType() == Core::MessageType::DownloadFile)
+	}
+
+	// Opens cache of logged user and processes cached responses as if they came from server
+	void ClientApp::LoadCache()
+	{
+		if (!cache.Open(loggedUser.GetId()))
+			return;
+
+		cache.GetSyncEntries(syncEntries);
+
+		ApplyCached(MessageResponses::ProcessTeams, 0);
+		ApplyCached(MessageResponses::ProcessInvites, 0);
+		ApplyCached(MessageResponses::ProcessNotifications, 0);
+	}
+
+	// Asks server what changed in user's and his teams' data since last sync, only one sync is pending at a time
+	void ClientApp::SendSyncMessage()
+	{
+		if (syncPending)
 		{
-			auto path = FileDialog::SaveFile(downloadFileExtension.c_str());
-			if (!path.empty())
-				FileWriter::WriteFile(path, message.Body.Content);
+			syncRequested = true;
+			return;
 		}
 
-		messageQueue.Pop();
+		std::vector<Core::SyncEntry> entries;
+		auto addScope = [&](Core::ChangeScope scope, uint32_t id) {
+			Core::SyncEntry entry;
+			entry.Scope = scope;
+			entry.Id = id;
+
+			for (const Core::SyncEntry& synced : syncEntries)
+			{
+				if (synced.Scope == scope && synced.Id == id)
+					entry.Sequence = synced.Sequence;
+			}
+
+			entries.push_back(entry);
+		};
+
+		addScope(Core::ChangeScope::User, loggedUser.GetId());
+		for (auto& [id, team] : loggedUser.GetTeams())
+		{
+			if (entries.size() == Core::MaxSyncEntries)
+				break;
+
+			addScope(Core::ChangeScope::Team, id);
+		}
+
+		Ref<Core::Message> message = CreateRef<Core::Message>();
+		message->Header.Type = Core::MessageType::Sync;
+		message->Body.Content = CreateRef<Buffer>(entries.size() * sizeof(Core::SyncEntry));
+		memcpy(message->Body.Content->GetData(), entries.data(), entries.size() * sizeof(Core::SyncEntry));
+		message->Header.Size = message->Body.Content->GetSize();
+		message->Header.RequestId = requests.Register([this, entries](Core::Message& response) { ProcessSyncResponse(response, entries); });
+
+		syncPending = true;
+		networkInterface->SendMessagePackets(message);
+	}
+
+	// Reads data of entities which changed since last sync
+	void ClientApp::ProcessSyncResponse(Core::Message& message, const std::vector<Core::SyncEntry>& requested)
+	{
+		syncPending = false;
+		if (state != ClientState::Home)
+			return;
+
+		uint32_t count = message.Body.Content ? (uint32_t)(message.Body.Content->GetSize() / sizeof(Core::SyncEntry)) : 0;
+		std::vector<Core::SyncEntry> entries(count);
+		if (count)
+			memcpy(entries.data(), message.Body.Content->GetData(), count * sizeof(Core::SyncEntry));
+
+		int selectedTeamId = loggedUser.HasSelectedTeam() ? (int)loggedUser.GetSelectedTeam().GetId() : -1;
+
+		uint32_t changes = 0;
+		for (uint32_t i = 0; i < count && i < requested.size(); i++)
+		{
+			const Core::SyncEntry& entry = entries[i];
+			bool selected = entry.Scope == Core::ChangeScope::Team && (int)entry.Id == selectedTeamId;
+
+			// First sync of scope only sets it's sequence, data were read with it
+			// Selected team without sequence could be shown from cache of older session, so it's read whole
+			if (!requested[i].Sequence)
+			{
+				if (selected && entries[0].Scope == Core::ChangeScope::User && requested[0].Sequence)
+					changes |= Core::AllChangeEntities & ~(uint32_t)Core::ChangeEntity::Teams;
+
+				continue;
+			}
+
+			if (entry.FullResync)
+				TRACE("Full resync of scope {0} {1}", (uint32_t)entry.Scope, entry.Id);
+
+			// Other teams' data are read when they are selected, only their renames and deletes are visible
+			if (entry.Scope == Core::ChangeScope::Team && !selected)
+				changes |= entry.Changes & (uint32_t)Core::ChangeEntity::Teams;
+			else
+				changes |= entry.Changes;
+		}
+
+		syncEntries = std::move(entries);
+
+		// Sequences of request are stored, reads sent now could be lost with client closed before their responses come
+		// Next session then asks for these changes again
+		cache.StoreSyncEntries(requested);
+
+		if (changes & (uint32_t)Core::ChangeEntity::Teams)
+			ReadUsersTeams(); // Reads selected team's data too
+		if (changes & (uint32_t)Core::ChangeEntity::Invites)
+			ReadUsersInvites();
+		if (changes & (uint32_t)Core::ChangeEntity::Notifications)
+			ReadUsersNotifications();
+		if (changes & (uint32_t)Core::ChangeEntity::Users)
+			UpdateLoggedUser();
+
+		if (loggedUser.HasSelectedTeam() && !(changes & (uint32_t)Core::ChangeEntity::Teams))
+		{
+			if (changes & (uint32_t)Core::ChangeEntity::Messages)
+				ReadSelectedTeamMessages();
+			if (changes & (uint32_t)Core::ChangeEntity::Users)
+				ReadSelectedTeamUsers();
+			if (changes & (uint32_t)Core::ChangeEntity::Assignments)
+				ReadAssignments();
+		}
+
+		if (syncRequested)
+		{
+			syncRequested = false;
+			SendSyncMessage();
+		}
+	}
+
+	// Reads called while cached response is processed are answered from cache too
+	bool ClientApp::ApplyCached(MessageResponses type, uint32_t key)
+	{
+		Core::Response response;
+		if (!cache.Get(type, key, response))
+			return false;
+
+		bool processing = processingCache;
+		processingCache = true;
+		ProcessResponse(response);
+		processingCache = processing;
+
+		return true;
+	}
+
+	// Index of first message in response newer than lastId
+	uint32_t ClientApp::FindNewMessages(const Core::Response& response, uint32_t lastId)
+	{
+		uint32_t first = 0;
+		while (first < response.GetDataCount() && (uint32_t)response.GetInt(first) <= lastId)
+			first += MessageColumns;
+
+		return first;
+	}
+
+	// Adds messages of response (id, content, first name, last name, author id) which are newer than the last one of team
+	// Responses of two reads sent before the first one was processed can contain the same messages
+	void ClientApp::AddTeamMessages(Team& team, const Core::Response& response)
+	{
+		for (uint32_t i = FindNewMessages(response, team.GetLastMessageId()); i < response.GetDataCount(); i += MessageColumns)
+		{
+			// Construct full name
+			std::string name = std::string(response.GetString(i + 2)) + " " + response.GetString(i + 3);
+			uint32_t authorId = response.GetInt(i + 4);
+			// Add message
+			team.AddMessage(new Message(response.GetInt(i), authorId, name.c_str(), response.GetString(i + 1), authorId == loggedUser.GetId()));
+		}
+	}
+
+	// Responses of selected team reads are dropped if other team was selected meanwhile, so they are not cached under wrong team
+	ClientApp::ResponseCallback ClientApp::SelectedTeamCallback()
+	{
+		uint32_t teamId = loggedUser.GetSelectedTeam().GetId();
+		return [this, teamId](Core::Response& response) {
+			if (loggedUser.HasSelectedTeam() && loggedUser.GetSelectedTeam().GetId() == teamId)
+				ProcessResponse(response);
+		};
 	}
 
 	void ClientApp::OnConnect(Core::ConnectedEvent& e)
 	{
 		TRACE("Connected to {0} on port {1}", e.GetDomain(), e.GetPort());
+
+		// Resumed session delivers responses and updates of lost connection, new one is handled on main thread
+		if (!e.IsResumed())
+			newSession = true;
 	}
 
 	void ClientApp::OnDisconnect(Core::DisconnectedEvent& e)
@@ -577,6 +778,60 @@ namespace Client
 		}
 	}
 
+	// Computes layout of messages which don't have one for current width of chat list yet
+	// Text sizes are measured here only once, not every frame
+	void ClientApp::UpdateMessagesLayout(Team& team, float width)
+	{
+		std::vector<float>& offsets = team.GetMessageOffsets(width);
+		if (offsets.size() == team.GetMessageCount() + 1)
+			return;
+
+		if (offsets.empty())
+			offsets.push_back(0.0f);
+
+		float spacing = ImGui::GetStyle().ItemSpacing.y;
+		float startX = ImGui::GetCursorPosX();
+		float available = ImGui::GetContentRegionAvail().x;
+
+		for (uint32_t i = offsets.size() - 1; i < team.GetMessageCount(); i++)
+		{
+			Message& message = team.GetMessages()[i].Get();
+			MessageLayout& layout = message.GetLayout();
+
+			ImGui::PushFont(fonts["Regular16"]);
+			const char* name = message.GetAuthorName().c_str();
+			float nameHeight;
+			if (message.IsMine())
+			{
+				// Own messages are aligned to the right side and wrapped at half of the list
+				layout.NameX = available - std::clamp(ImGui::CalcTextSize(name).x, 0.0f, width / 2);
+				nameHeight = ImGui::CalcTextSize(name, nullptr, false, width - layout.NameX).y;
+			}
+			else
+			{
+				layout.NameX = startX;
+				nameHeight = ImGui::CalcTextSize(name, nullptr, false, width / 2 - startX).y;
+			}
+			ImGui::PopFont();
+
+			const char* content = message.GetContent().c_str();
+			float contentHeight;
+			if (message.IsMine())
+			{
+				layout.ContentX = available - std::clamp(ImGui::CalcTextSize(content).x, 0.0f, width / 2);
+				contentHeight = ImGui::CalcTextSize(content, nullptr, false, width - layout.ContentX).y;
+			}
+			else
+			{
+				layout.ContentX = startX;
+				contentHeight = ImGui::CalcTextSize(content, nullptr, false, width / 2 - startX).y;
+			}
+
+			layout.Height = nameHeight + spacing + contentHeight + spacing;
+			offsets.push_back(offsets.back() + layout.Height);
+		}
+	}
+
 	void ClientApp::RenderLoginWindow(ImGuiWindowFlags flags)
 	{
 		ImGuiIO& io = ImGui::GetIO();
@@ -995,36 +1250,45 @@ namespace Client
 			ImGui::TextColored(ImVec4(0.1f, 0.1f, 0.1f, 1.0f), "There are no messages yet");
 		}
 
-		for (uint32_t i = 0; i < loggedUser.GetSelectedTeam().GetMessageCount(); i++)
-		{
-			Ref<Message> message = loggedUser.GetSelectedTeam().GetMessages()[i];
+		// Only visible messages are rendered, others are skipped by their cached heights
+		Team& team = loggedUser.GetSelectedTeam();
+		float listWidth = ImGui::GetWindowWidth();
+		UpdateMessagesLayout(team, listWidth);
 
-			if (message->GetAuthorName() == loggedUser.GetName())
-			{
-				ImGui::PushFont(fonts["Regular16"]);
+		const std::vector<float>& offsets = team.GetMessageOffsets(listWidth);
+		uint32_t messageCount = team.GetMessageCount();
 
-				float nameWidth = std::clamp(ImGui::CalcTextSize(message->GetAuthorName().c_str()).x, 0.0f, ImGui::GetWindowWidth() / 2);
-				ImGui::SetCursorPosX(ImGui::GetContentRegionAvail().x - nameWidth);
+		float startY = ImGui::GetCursorPosY();
+		float top = ImGui::GetScrollY() - startY;
+		float bottom = top + ImGui::GetWindowHeight();
 
-				ImGui::PushTextWrapPos(ImGui::GetWindowWidth());
-				ImGui::TextWrapped(message->GetAuthorName().c_str());
-				ImGui::PopFont();
+		uint32_t first = std::upper_bound(offsets.begin(), offsets.begin() + messageCount, top) - offsets.begin();
+		first = first ? first - 1 : 0;
+		uint32_t last = std::lower_bound(offsets.begin() + first, offsets.begin() + messageCount, bottom) - offsets.begin();
 
-				float messageWidth = std::clamp(ImGui::CalcTextSize(message->GetContent().c_str()).x, 0.0f, ImGui::GetWindowWidth() / 2);
-				ImGui::SetCursorPosX(ImGui::GetContentRegionAvail().x - messageWidth);
-				ImGui::TextWrapped(message->GetContent().c_str());
-				ImGui::PopTextWrapPos();
-			}
-			else
-			{
-				ImGui::PushFont(fonts["Regular16"]);
-				ImGui::PushTextWrapPos(ImGui::GetWindowWidth() / 2);
-				ImGui::TextWrapped(message->GetAuthorName().c_str());
-				ImGui::PopFont();
+		ImGui::SetCursorPosY(startY + offsets[first]);
+		for (uint32_t i = first; i < last; i++)
+		{
+			Message& message = team.GetMessages()[i].Get();
+			const MessageLayout& layout = message.GetLayout();
 
-				ImGui::TextWrapped(message->GetContent().c_str());
-				ImGui::PopTextWrapPos();
-			}
+			ImGui::PushTextWrapPos(message.IsMine() ? listWidth : listWidth / 2);
+
+			ImGui::PushFont(fonts["Regular16"]);
+			ImGui::SetCursorPosX(layout.NameX);
+			ImGui::TextWrapped("%s", message.GetAuthorName().c_str());
+			ImGui::PopFont();
+
+			ImGui::SetCursorPosX(layout.ContentX);
+			ImGui::TextWrapped("%s", message.GetContent().c_str());
+			ImGui::PopTextWrapPos();
+		}
+
+		// Keep height of whole list for scrolling
+		if (last < messageCount)
+		{
+			ImGui::SetCursorPosY(startY + offsets[messageCount] - ImGui::GetStyle().ItemSpacing.y);
+			ImGui::Dummy(ImVec2(0.0f, 0.0f));
 		}
 
 		// Auto scroll messages to buttom on load and after messages get updated
@@ -1049,10 +1313,10 @@ namespace Client
 
 			std::string message(messageBuffer);
 
-			command.SetCommandString("INSERT INTO messages (content, team_id, author_id) VALUES (?, ?, ?)");
-			command.AddData(new Core::DatabaseString(messageBuffer));
-			command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
-			command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+			command.SetCommandString(Core::Statements::InsertMessage);
+			command.AddString(messageBuffer);
+			command.AddInt(loggedUser.GetSelectedTeam().GetId());
+			command.AddInt(loggedUser.GetId());
 
 			SendCommandMessage(command);
 
@@ -1231,9 +1495,9 @@ namespace Client
 									Core::Command command((uint32_t)MessageResponses::None);
 									command.SetType(Core::CommandType::Update);
 
-									command.SetCommandString("UPDATE assignments set status = 'submitted', submitted_at = ? WHERE id = ?;");
-									command.AddData(new Core::DatabaseTimestamp(time(nullptr)));
-									command.AddData(new Core::DatabaseInt(assignment->GetId()));
+									command.SetCommandString(Core::Statements::SubmitAssignment);
+									command.AddTimestamp(time(nullptr));
+									command.AddInt(assignment->GetId());
 
 									SendCommandMessage(command);
 
@@ -1519,9 +1783,9 @@ namespace Client
 							Core::Command command((uint32_t)MessageResponses::None);
 							command.SetType(Core::CommandType::Command);
 
-							command.SetCommandString("DELETE FROM users_teams WHERE user_id = ? AND team_id = ?;");
-							command.AddData(new Core::DatabaseInt(teamUser->GetId()));
-							command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
+							command.SetCommandString(Core::Statements::DeleteTeamMember);
+							command.AddInt(teamUser->GetId());
+							command.AddInt(loggedUser.GetSelectedTeam().GetId());
 							SendCommandMessage(command);
 
 							std::string message = "You have been removed from ";
@@ -1583,9 +1847,9 @@ namespace Client
 				Core::Command command((uint32_t)MessageResponses::LinkTeamToUser);
 				command.SetType(Core::CommandType::Command);
 
-				command.SetCommandString("INSERT INTO teams (name, owner_id) VALUES (?, ?);");
-				command.AddData(new Core::DatabaseString(teamNameBuffer));
-				command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+				command.SetCommandString(Core::Statements::InsertTeam);
+				command.AddString(teamNameBuffer);
+				command.AddInt(loggedUser.GetId());
 
 				SendCommandMessage(command);
 
@@ -1851,11 +2115,11 @@ namespace Client
 						Core::Command command((uint32_t)MessageResponses::LinkAssignmentToUser);
 						command.SetType(Core::CommandType::Command);
 
-						command.SetCommandString("INSERT INTO assignments (team_id, name, description, deadline) VALUES (?, ?, ?, ?);");
-						command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
-						command.AddData(new Core::DatabaseString(editingAssignmentData.Name));
-						command.AddData(new Core::DatabaseString(editingAssignmentData.Description));
-						command.AddData(new Core::DatabaseTimestamp(editingAssignmentData.DeadLine));
+						command.SetCommandString(Core::Statements::InsertAssignment);
+						command.AddInt(loggedUser.GetSelectedTeam().GetId());
+						command.AddString(editingAssignmentData.Name);
+						command.AddString(editingAssignmentData.Description);
+						command.AddTimestamp(editingAssignmentData.DeadLine);
 						SendCommandMessage(command);
 
 						// Send notifications to users about new assignment
@@ -1867,9 +2131,9 @@ namespace Client
 							std::string message = "You have new assignment in ";
 							message += loggedUser.GetSelectedTeam().GetName();
 
-							notificationCommand.SetCommandString("INSERT INTO notifications (user_id, message) VALUES (?, ?);");
-							notificationCommand.AddData(new Core::DatabaseInt(id));
-							notificationCommand.AddData(new Core::DatabaseString(message));
+							notificationCommand.SetCommandString(Core::Statements::InsertNotification);
+							notificationCommand.AddInt(id);
+							notificationCommand.AddString(message);
 							SendCommandMessage(notificationCommand);
 						}
 
@@ -1954,11 +2218,11 @@ namespace Client
 						Core::Command command((uint32_t)MessageResponses::None);
 						command.SetType(Core::CommandType::Update);
 
-						command.SetCommandString("UPDATE assignments set name = ?, description = ?, deadline = ? WHERE id = ?;");
-						command.AddData(new Core::DatabaseString(editingAssignmentData.Name));
-						command.AddData(new Core::DatabaseString(editingAssignmentData.Description));
-						command.AddData(new Core::DatabaseTimestamp(editingAssignmentData.DeadLine));
-						command.AddData(new Core::DatabaseInt(editingAssignmentData.AssignmentId));
+						command.SetCommandString(Core::Statements::UpdateAssignment);
+						command.AddString(editingAssignmentData.Name);
+						command.AddString(editingAssignmentData.Description);
+						command.AddTimestamp(editingAssignmentData.DeadLine);
+						command.AddInt(editingAssignmentData.AssignmentId);
 
 						SendCommandMessage(command);
 
@@ -2062,10 +2326,10 @@ namespace Client
 				Core::Command command((uint32_t)MessageResponses::None);
 				command.SetType(Core::CommandType::Update);
 
-				command.SetCommandString("UPDATE assignments set status = 'rated', rating = ?, rating_description = ? WHERE id = ?;");
-				command.AddData(new Core::DatabaseInt(editingAssignmentData.Rating));
-				command.AddData(new Core::DatabaseString(editingAssignmentData.Description));
-				command.AddData(new Core::DatabaseInt(editingAssignmentData.AssignmentId));
+				command.SetCommandString(Core::Statements::RateAssignment);
+				command.AddInt(editingAssignmentData.Rating);
+				command.AddString(editingAssignmentData.Description);
+				command.AddInt(editingAssignmentData.AssignmentId);
 
 				SendCommandMessage(command);
 
@@ -2188,9 +2452,9 @@ namespace Client
 					Core::Command command((uint32_t)MessageResponses::None);
 					command.SetType(Core::CommandType::Command);
 
-					command.SetCommandString("INSERT INTO users_teams (user_id, team_id) VALUES (?, ?);");
-					command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
-					command.AddData(new Core::DatabaseInt(invite->GetTeamId()));
+					command.SetCommandString(Core::Statements::InsertTeamMember);
+					command.AddInt(loggedUser.GetId());
+					command.AddInt(invite->GetTeamId());
 
 					SendCommandMessage(command);
 
@@ -2234,10 +2498,10 @@ namespace Client
 				Core::Command command((uint32_t)MessageResponses::ChangeUsername);
 				command.SetType(Core::CommandType::Update);
 
-				command.SetCommandString("UPDATE users set first_name = ?, last_name = ? WHERE id = ?;");
-				command.AddData(new Core::DatabaseString(firstNameBuffer));
-				command.AddData(new Core::DatabaseString(lastNameBuffer));
-				command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+				command.SetCommandString(Core::Statements::UpdateUserName);
+				command.AddString(firstNameBuffer);
+				command.AddString(lastNameBuffer);
+				command.AddInt(loggedUser.GetId());
 
 				SendCommandMessage(command);
 
@@ -2284,9 +2548,9 @@ namespace Client
 					Core::Command command((uint32_t)MessageResponses::ChangePassword);
 					command.SetType(Core::CommandType::Update);
 
-					command.SetCommandString("UPDATE users set password = ? WHERE id = ?;");
-					command.AddData(new Core::DatabaseString(hash));
-					command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+					command.SetCommandString(Core::Statements::UpdateUserPassword);
+					command.AddString(hash);
+					command.AddInt(loggedUser.GetId());
 
 					SendCommandMessage(command);
 
@@ -2402,13 +2666,28 @@ namespace Client
 	}
 
 	// Method to send command as message
-	void ClientApp::SendCommandMessage(Core::Command& command)
+	void ClientApp::SendCommandMessage(Core::Command& command, const ResponseCallback& callback)
 	{
 		Ref<Core::Message> message = CreateRef<Core::Message>();
 		message->Header.Type = Core::MessageType::Command;
 		command.Serialize(message->Body.Content);
 		message->Header.Size = message->Body.Content->GetSize();
 
+		// Register request, so it's response can be matched even if more requests of the same type are pending
+		// Commands without task id are not responded
+		if (!command.GetTaskId() && command.GetType() != Core::CommandType::Query)
+			message->Header.RequestId = 0;
+		else if (callback)
+		{
+			message->Header.RequestId = requests.Register([callback](Core::Message& responseMessage) {
+				Core::Response response;
+				response.Deserialize(responseMessage.Body.Content);
+				callback(response);
+			});
+		}
+		else
+			message->Header.RequestId = requests.Register();
+
 		networkInterface->SendMessagePackets(message);
 	}
 
@@ -2426,6 +2705,7 @@ namespace Client
 	{
 		Ref<Core::Message> message = CreateRef<Core::Message>();
 		message->Header.Type = Core::MessageType::DownloadFile;
+		message->Header.RequestId = requests.Register();
 		message->CreateBody<uint32_t>(attachmentId);
 
 		networkInterface->SendMessagePackets(message);
@@ -2436,8 +2716,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::CheckEmail);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT id, email FROM users WHERE email = ?;");
-		command.AddData(new Core::DatabaseString(email));
+		command.SetCommandString(Core::Statements::SelectUserIdByEmail);
+		command.AddString(email);
 
 		SendCommandMessage(command);
 	}
@@ -2447,9 +2727,9 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::CheckInvite);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT user_id FROM invites WHERE team_id = ? AND user_id = ?;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
-		command.AddData(new Core::DatabaseInt(userId));
+		command.SetCommandString(Core::Statements::SelectInvite);
+		command.AddInt(loggedUser.GetSelectedTeam().GetId());
+		command.AddInt(userId);
 
 		SendCommandMessage(command);
 	}
@@ -2459,9 +2739,9 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::CheckTeam);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT user_id FROM users_teams WHERE team_id = ? AND user_id = ?;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
-		command.AddData(new Core::DatabaseInt(userId));
+		command.SetCommandString(Core::Statements::SelectTeamMember);
+		command.AddInt(loggedUser.GetSelectedTeam().GetId());
+		command.AddInt(userId);
 
 		SendCommandMessage(command);
 	}
@@ -2472,8 +2752,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::Login);
 		command.SetType(Core::CommandType::Query);
 		
-		command.SetCommandString("SELECT id, password, first_name, last_name, email, role FROM users WHERE email = ?;");
-		command.AddData(new Core::DatabaseString(loginData.Email));
+		command.SetCommandString(Core::Statements::SelectLogin);
+		command.AddString(loginData.Email);
 
 		SendCommandMessage(command);
 	}
@@ -2484,11 +2764,11 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::Register);
 		command.SetType(Core::CommandType::Command);
 
-		command.SetCommandString("INSERT INTO users (first_name, last_name, email, password) VALUES (?, ?, ?, ?);");
-		command.AddData(new Core::DatabaseString(registerData.FirstName));
-		command.AddData(new Core::DatabaseString(registerData.LastName));
-		command.AddData(new Core::DatabaseString(registerData.Email));
-		command.AddData(new Core::DatabaseString(Core::GenerateHash(registerData.Password).c_str()));
+		command.SetCommandString(Core::Statements::InsertUser);
+		command.AddString(registerData.FirstName);
+		command.AddString(registerData.LastName);
+		command.AddString(registerData.Email);
+		command.AddString(Core::GenerateHash(registerData.Password));
 
 		SendCommandMessage(command);
 	}
@@ -2498,9 +2778,9 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::None);
 		command.SetType(Core::CommandType::Command);
 
-		command.SetCommandString("INSERT INTO notifications (user_id, message) VALUES (?, ?);");
-		command.AddData(new Core::DatabaseInt(userId));
-		command.AddData(new Core::DatabaseString(message));
+		command.SetCommandString(Core::Statements::InsertNotification);
+		command.AddInt(userId);
+		command.AddString(message);
 		SendCommandMessage(command);
 	}
 
@@ -2509,8 +2789,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::UpdateLoggedUser);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT first_name, last_name, email, role FROM users WHERE id = ?;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+		command.SetCommandString(Core::Statements::SelectUser);
+		command.AddInt(loggedUser.GetId());
 
 		SendCommandMessage(command);
 	}
@@ -2521,8 +2801,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::ProcessTeams);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT teams.id, teams.owner_id, teams.name FROM users_teams JOIN teams ON users_teams.team_id = teams.id WHERE users_teams.user_id = ?;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+		command.SetCommandString(Core::Statements::SelectUserTeams);
+		command.AddInt(loggedUser.GetId());
 
 		SendCommandMessage(command);
 	}
@@ -2533,8 +2813,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::ProcessInvites);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT invites.id, teams.id, teams.name FROM invites JOIN teams ON invites.team_id = teams.id WHERE invites.user_id = ?;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+		command.SetCommandString(Core::Statements::SelectUserInvites);
+		command.AddInt(loggedUser.GetId());
 
 		SendCommandMessage(command);
 	}
@@ -2545,11 +2825,11 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::ProcessAssignments);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT assignments.id, assignments.name, assignments.description, assignments.status, assignments.rating, assignments.rating_description, assignments.deadline, assignments.submitted_at FROM users_assignments JOIN assignments ON users_assignments.assignment_id = assignments.id WHERE users_assignments.user_id = ? AND assignments.team_id = ? ORDER BY deadline LIMIT 200;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
-		command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
+		command.SetCommandString(Core::Statements::SelectUserAssignments);
+		command.AddInt(loggedUser.GetId());
+		command.AddInt(loggedUser.GetSelectedTeam().GetId());
 
-		SendCommandMessage(command);
+		SendCommandMessage(command, SelectedTeamCallback());
 	}
 
 	// Send command to read all logged user's notifications
@@ -2558,8 +2838,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::ProcessNotifications);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT id, message FROM notifications WHERE user_id = ? ORDER BY id DESC;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+		command.SetCommandString(Core::Statements::SelectNotifications);
+		command.AddInt(loggedUser.GetId());
 
 		SendCommandMessage(command);
 	}
@@ -2570,10 +2850,10 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::ProcessAssignments);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT id, name, description, status, rating, rating_description, deadline, submitted_at FROM assignments WHERE team_id = ? ORDER BY deadline LIMIT 200");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
+		command.SetCommandString(Core::Statements::SelectTeamAssignments);
+		command.AddInt(loggedUser.GetSelectedTeam().GetId());
 
-		SendCommandMessage(command);
+		SendCommandMessage(command, SelectedTeamCallback());
 	}
 
 	void ClientApp::ReadAssignmentsUsers(Ref<Assignment> assignment)
@@ -2581,10 +2861,27 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::ProcessAssignmentsUsers);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT assignment_id, users.id, users.first_name, users.last_name FROM users_assignments JOIN users ON users_assignments.user_id = users.id WHERE users_assignments.assignment_id = ?;");
-		command.AddData(new Core::DatabaseInt(assignment->GetId()));
+		command.SetCommandString(Core::Statements::SelectAssignmentUsers);
+		command.AddInt(assignment->GetId());
 
-		SendCommandMessage(command);
+		// Responses for different assignments are matched by request, assignment is looked up again as assignments could be reloaded meanwhile
+		uint32_t assignmentId = assignment->GetId();
+		SendCommandMessage(command, [this, assignmentId](Core::Response& response) {
+			auto assignment = loggedUser.GetAssignments().find(assignmentId);
+			if (assignment == loggedUser.GetAssignments().end())
+				return;
+
+			assignment->second->ClearUsers();
+
+			for (uint32_t i = 0; i < response.GetDataCount(); i += 4) // Response: assignment id, user id, first_name, last_name
+			{
+				// Construct full name
+				std::string name = std::string(response.GetString(i + 2)) + " " + response.GetString(i + 3);
+				// Add user to assignment
+				Ref<User> user = new User(response.GetInt(i + 1), name);
+				assignment->second->AddUser(user);
+			}
+		});
 	}
 
 	void ClientApp::ReadAssignmentsAttachments(Ref<Assignment> assignment)
@@ -2593,36 +2890,76 @@ namespace Client
 		message->Header.Type = Core::MessageType::ReadFileName;
 		message->CreateBody<uint32_t>(assignment->GetId());
 
+		uint32_t assignmentId = assignment->GetId();
+		message->Header.RequestId = requests.Register([this, assignmentId](Core::Message& responseMessage) {
+			Core::Response response;
+			response.Deserialize(responseMessage.Body.Content);
+
+			auto assignment = loggedUser.GetAssignments().find(assignmentId);
+			if (assignment == loggedUser.GetAssignments().end())
+				return;
+
+			assignment->second->ClearAttachments();
+
+			for (uint32_t i = 0; i < response.GetDataCount(); i += 4) // Response: assignment id, attachment id, file name, by_user
+				assignment->second->AddAttachment(new File(response.GetInt(i + 1), response.GetString(i + 2), response.GetBool(i + 3)));
+		});
+
 		networkInterface->SendMessagePackets(message);
 	}
 
-	// Send command to read all selected team messages
+	// Send command to read selected team messages, cached messages are shown immediately and only newer ones are read then
 	void ClientApp::ReadSelectedTeamMessages()
 	{
-		Core::Command command((uint32_t)MessageResponses::ProcessTeamMessages);
-		command.SetType(Core::CommandType::Query);
+		Team& team = loggedUser.GetSelectedTeam();
+		bool cached = !team.HasMessages() && ApplyCached(MessageResponses::ProcessTeamMessages, team.GetId());
 
-		command.SetCommandString("SELECT * FROM (SELECT messages.id, messages.content, users.first_name, users.last_name FROM messages JOIN users ON messages.author_id = users.id WHERE messages.team_id = ? ORDER BY messages.id DESC LIMIT 40) AS subquery ORDER BY subquery.id ASC;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
+		// Messages missing in cache are read even when cache is processed
+		if (processingCache && cached)
+			return;
 
-		SendCommandMessage(command);
+		Core::Command command;
+		if (team.HasMessages())
+		{
+			command = Core::Command((uint32_t)MessageResponses::ProcessNewTeamMessages);
+			command.SetCommandString(Core::Statements::SelectTeamMessagesAfter);
+			command.AddInt(team.GetId());
+			command.AddInt(team.GetLastMessageId());
+		}
+		else
+		{
+			command = Core::Command((uint32_t)MessageResponses::ProcessTeamMessages);
+			command.SetCommandString(Core::Statements::SelectTeamMessages);
+			command.AddInt(team.GetId());
+		}
+
+		command.SetType(Core::CommandType::Query);
+		SendCommandMessage(command, SelectedTeamCallback());
 	}
 
 	// Send command to read all selected team users
 	void ClientApp::ReadSelectedTeamUsers()
 	{
+		bool cached = !loggedUser.GetSelectedTeam().GetUserCount() && ApplyCached(MessageResponses::ProcessTeamUsers, loggedUser.GetSelectedTeam().GetId());
+
+		if (processingCache && cached)
+			return;
+
 		Core::Command command((uint32_t)MessageResponses::ProcessTeamUsers);
 		command.SetType(Core::CommandType::Query);
 
-		command.SetCommandString("SELECT users.id, users.first_name, users.last_name FROM users_teams JOIN users ON users_teams.user_id = users.id WHERE users_teams.team_id = ?;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
+		command.SetCommandString(Core::Statements::SelectTeamMembers);
+		command.AddInt(loggedUser.GetSelectedTeam().GetId());
 
-		SendCommandMessage(command);
+		SendCommandMessage(command, SelectedTeamCallback());
 	}
 
 	// Read all team's assignments or user's assignments based on team ownership
 	void ClientApp::ReadAssignments()
 	{
+		if (processingCache && ApplyCached(MessageResponses::ProcessAssignments, loggedUser.GetSelectedTeam().GetId()))
+			return;
+
 		if (loggedUser.IsTeamOwner(loggedUser.GetSelectedTeam()))
 			ReadSelectedTeamAssignments();
 		else
@@ -2634,8 +2971,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::None);
 		command.SetType(Core::CommandType::Command);
 
-		command.SetCommandString("DELETE FROM invites WHERE id = ?;");
-		command.AddData(new Core::DatabaseInt(inviteId));
+		command.SetCommandString(Core::Statements::DeleteInvite);
+		command.AddInt(inviteId);
 
 		SendCommandMessage(command);
 	}
@@ -2645,8 +2982,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::None);
 		command.SetType(Core::CommandType::Command);
 
-		command.SetCommandString("DELETE FROM invites WHERE user_id = ?;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+		command.SetCommandString(Core::Statements::DeleteUserInvites);
+		command.AddInt(loggedUser.GetId());
 
 		SendCommandMessage(command);
 	}
@@ -2656,8 +2993,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::None);
 		command.SetType(Core::CommandType::Command);
 
-		command.SetCommandString("DELETE FROM notifications WHERE user_id = ?;");
-		command.AddData(new Core::DatabaseInt(loggedUser.GetId()));
+		command.SetCommandString(Core::Statements::DeleteNotifications);
+		command.AddInt(loggedUser.GetId());
 
 		SendCommandMessage(command);
 	}
@@ -2667,14 +3004,14 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::None);
 		command.SetType(Core::CommandType::Command);
 
-		command.AddData(new Core::DatabaseInt(assignmentId));
-		command.SetCommandString("DELETE FROM users_assignments WHERE assignment_id = ?;");
+		command.AddInt(assignmentId);
+		command.SetCommandString(Core::Statements::DeleteAssignmentUsers);
 		SendCommandMessage(command);
 
-		command.SetCommandString("DELETE FROM attachments WHERE assignment_id = ?;");
+		command.SetCommandString(Core::Statements::DeleteAssignmentAttachments);
 		SendCommandMessage(command);
 
-		command.SetCommandString("DELETE FROM assignments WHERE id = ?;");
+		command.SetCommandString(Core::Statements::DeleteAssignment);
 		SendCommandMessage(command);
 	}
 
@@ -2683,8 +3020,8 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::None);
 		command.SetType(Core::CommandType::Command);
 
-		command.SetCommandString("DELETE FROM attachments WHERE id = ?;");
-		command.AddData(new Core::DatabaseInt(attachmentId));
+		command.SetCommandString(Core::Statements::DeleteAttachment);
+		command.AddInt(attachmentId);
 		SendCommandMessage(command);
 	}
 
@@ -2697,17 +3034,17 @@ namespace Client
 		for (auto& [id, assignment] : loggedUser.GetAssignments())
 			DeleteAssignment(id);
 
-		command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
-		command.SetCommandString("DELETE FROM users_teams WHERE team_id = ?;");
+		command.AddInt(loggedUser.GetSelectedTeam().GetId());
+		command.SetCommandString(Core::Statements::DeleteTeamMembers);
 		SendCommandMessage(command);
 
-		command.SetCommandString("DELETE FROM messages WHERE team_id = ?;");
+		command.SetCommandString(Core::Statements::DeleteTeamMessages);
 		SendCommandMessage(command);
 
-		command.SetCommandString("DELETE FROM invites WHERE team_id = ?;");
+		command.SetCommandString(Core::Statements::DeleteTeamInvites);
 		SendCommandMessage(command);
 
-		command.SetCommandString("DELETE FROM teams WHERE id = ?;");
+		command.SetCommandString(Core::Statements::DeleteTeam);
 		SendCommandMessage(command);
 	}
 
@@ -2717,9 +3054,9 @@ namespace Client
 		Core::Command command((uint32_t)MessageResponses::None);
 		command.SetType(Core::CommandType::Update);
 
-		command.SetCommandString("UPDATE teams set name = ? WHERE id = ?;");
-		command.AddData(new Core::DatabaseString(teamName));
-		command.AddData(new Core::DatabaseInt(loggedUser.GetSelectedTeam().GetId()));
+		command.SetCommandString(Core::Statements::UpdateTeamName);
+		command.AddString(teamName);
+		command.AddInt(loggedUser.GetSelectedTeam().GetId());
 
 		SendCommandMessage(command);
 	}
@@ -2733,6 +3070,7 @@ Core::Application* Core::CreateApplication(const Core::CommandArgs& args)
 	specs.Title = "Client";
 	specs.WindowWidth = 1280;
 	specs.WindowHeight = 720;
+	specs.RenderOnDemand = true;
 
 	return new Client::ClientApp(specs);
 }
\ No newline at end of file
@@ -2,9 +2,13 @@
 #include "Core/Application.h"
 #include "Networking/NetworkClientInterface.h"
 #include "Networking/MessageQueue.h"
+#include "Networking/RequestTable.h"
 #include "Client/ErrorTypes.h"
+#include "Client/MessageResponses.h"
 #include "Client/Teams/User.h"
+#include "Client/ClientCache.h"
 #include "Database/Command.h"
+#include "Database/Response.h"
 #include "Client/Assignments/Assignment.h"
 
 #define CHAR_BUFFER_SIZE 256 // Size of char buffers
@@ -14,36 +18,6 @@ struct ImFont;
 
 namespace Client
 {
-	// Enum of server response ids (instead of using raw numbers, casting them to uint32 anyway)
-	enum class MessageResponses : uint32_t
-	{
-		None = 0, // No response
-		Login,
-		Register,
-		CheckEmail,
-		LinkTeamToUser,
-		UpdateTeams, // Reserved by server
-		UpdateMessages, // Reserved by server
-		UpdateUsers, // Reserved by server
-		UpdateInvites, // Reserved by server
-		UpdateNotifications, // Reserved by server
-		UpdateAssignments, // Reserved by server
-		ProcessAssignmentAttachments, // Reserved by server
-		LinkAssignmentToUser,
-		UpdateLoggedUser,
-		CheckInvite,
-		CheckTeam,
-		ChangeUsername,
-		ChangePassword,
-		ProcessTeams,
-		ProcessTeamMessages,
-		ProcessTeamUsers,
-		ProcessInvites,
-		ProcessNotifications,
-		ProcessAssignments,
-		ProcessAssignmentsUsers,
-	};
-
 	// Enum for rendering client states - rendering different windows based on state
 	enum class ClientState
 	{
@@ -77,6 +51,8 @@ namespace Client
 	{
 		// Alias to map fonts to names for easy access
 		using FontMap = std::unordered_map<const char*, ImFont*>;
+		// Alias for functions handling response of specific request
+		using ResponseCallback = std::function<void(Core::Response&)>;
 	public:
 		ClientApp(const Core::ApplicationSpecifications& specs);
 
@@ -95,10 +71,24 @@ namespace Client
 		// Networking methods
 		virtual void ProcessMessageQueue() override;
 		void ProcessMessage();
+		void ProcessResponse(Core::Response& response);
+
+		// Cache methods
+		void LoadCache();
+		bool ApplyCached(MessageResponses type, uint32_t key);
+
+		// Sync methods
+		void SendSyncMessage();
+		void ProcessSyncResponse(Core::Message& message, const std::vector<Core::SyncEntry>& requested);
+
+		uint32_t FindNewMessages(const Core::Response& response, uint32_t lastId);
+		void AddTeamMessages(Team& team, const Core::Response& response);
+		ResponseCallback SelectedTeamCallback();
 
 		// UI functions
 		void SetStyle();
 		void Render();
+		void UpdateMessagesLayout(Team& team, float width);
 
 		// Render windows
 		void RenderLoginWindow(ImGuiWindowFlags flags);
@@ -121,7 +111,7 @@ namespace Client
 		void ResetActionStates();
 
 		// Sending methods
-		void SendCommandMessage(Core::Command& command);
+		void SendCommandMessage(Core::Command& command, const ResponseCallback& callback = ResponseCallback());
 		void SendAttachment(Ref<File> attachment);
 		void DownloadAttachment(uint32_t attachmentId);
 
@@ -163,6 +153,17 @@ namespace Client
 		// Networking
 		Ref<Core::NetworkClientInterface> networkInterface;
 		Core::MessageQueue messageQueue;
+		Core::RequestTable requests; // Requests waiting for response
+		std::atomic<bool> newSession = false; // Connection was not resumed, set on network thread
+
+		// Responses of last session
+		ClientCache cache;
+		bool processingCache = false; // Cached response is being processed, reads are answered from cache too
+
+		// Sequences of user and team scopes from last sync
+		std::vector<Core::SyncEntry> syncEntries;
+		bool syncPending = false; // Sync waits for response
+		bool syncRequested = false; // Update came while sync was pending, another one is sent after response
 
 		// Networking target specifications
 		std::string address;
@@ -12,6 +12,7 @@
 // Data structers
 #include <deque>
 #include <string>
+#include <cstring>
 #include <sstream>
 #include <vector>
 #include <unordered_map>
@@ -23,6 +24,8 @@
 
 // Others
 #include <mutex>
+#include <thread>
+#include <iomanip>
 
 #include <regex>
 #include <ctime>
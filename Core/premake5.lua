@@ -1,11 +1,12 @@
+-- Headless part of Core (application, networking, database, utilities)
 project "Core"
 	kind "StaticLib"
 	language "C++"
 	cppdialect "C++20"
 	staticruntime "off"
 
-	targetdir (outputdir .. "$(Configuration)/$(ProjectName)")
-	objdir (intoutputdir .. "$(Configuration)/$(ProjectName)")
+	targetdir (outputdir .. "%{cfg.buildcfg}/%{prj.name}")
+	objdir (intoutputdir .. "%{cfg.buildcfg}/%{prj.name}")
 
 	pchheader "pch.h"
 	pchsource "src/pch.cpp"
@@ -16,34 +17,92 @@ project "Core"
 		"src/**.cpp",
 	}
 
+	removefiles
+	{
+		"src/Core/Glfw/**",
+		"src/Utils/FileDialog.cpp",
+	}
+
+	includedirs
+	{
+		"src",
+		"%{wks.location}/vendor/asio/asio/include",
+		"%{wks.location}/vendor/mysql connector/include",
+		"%{wks.location}/vendor/Bcrypt/include",
+	}
+
+	defines { "CORE", "STATIC_CONCPP" }
+
+	filter "system:windows"
+		links
+		{
+			"Ws2_32.lib",
+			"Crypt32.lib",
+			"%{wks.location}/vendor/Bcrypt/bcrypt.lib",
+		}
+
+	filter { "system:windows", "configurations:Debug" }
+		links "%{wks.location}/vendor/mysql connector/bin/debug/lib64/debug/vs14/mysqlcppconn-static.lib"
+
+	filter { "system:windows", "configurations:Release or Distribution" }
+		links "%{wks.location}/vendor/mysql connector/bin/release/bin/lib64/vs14/mysqlcppconn-static.lib"
+
+	filter "configurations:Debug"
+		defines "DEBUG_CONFIG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "RELEASE_CONFIG"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Distribution"
+		defines "DISTRIBUTION_CONFIG"
+		runtime "Release"
+		optimize "on"
+
+-- Window and dialogs (GLFW, ImGui, OpenGL), linked only by applications with window
+project "CoreUI"
+	kind "StaticLib"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+
+	targetdir (outputdir .. "%{cfg.buildcfg}/%{prj.name}")
+	objdir (intoutputdir .. "%{cfg.buildcfg}/%{prj.name}")
+
+	pchheader "pch.h"
+	pchsource "src/pch.cpp"
+
+	files
+	{
+		"src/pch.h",
+		"src/pch.cpp",
+		"src/Core/Glfw/**.h",
+		"src/Core/Glfw/**.cpp",
+		"src/Utils/FileDialog.cpp",
+	}
+
 	includedirs
 	{
 		"src",
-		"$(SolutionDir)vendor/glfw/include",
-		"$(SolutionDir)vendor/asio/asio/include",
-		"$(SolutionDir)vendor/mysql connector/include",
-		"$(SolutionDir)vendor/Bcrypt/include",
-		"$(SolutionDir)vendor/imgui/src",
+		"%{wks.location}/vendor/glfw/include",
+		"%{wks.location}/vendor/imgui/src",
 	}
 
 	links
 	{
-		"opengl32.lib",
-		"Ws2_32.lib",
-		"Crypt32.lib",
-		"$(SolutionDir)vendor/Bcrypt/bcrypt.lib",
+		"Core",
 		"GLFW",
 		"ImGui",
 		"ImGuiDatePicker",
 	}
 
-	defines { "CORE", "STATIC_CONCPP" }
-
-	filter { "system:windows", "configurations:Debug" }
-		links "$(SolutionDir)vendor/mysql connector/bin/debug/lib64/debug/vs14/mysqlcppconn-static.lib"
+	defines { "CORE" }
 
-	filter { "system:windows", "configurations:Release or Distribution" }
-		links "$(SolutionDir)vendor/mysql connector/bin/release/bin/lib64/vs14/mysqlcppconn-static.lib"
+	filter "system:windows"
+		links "opengl32.lib"
 
 	filter "configurations:Debug"
 		defines "DEBUG_CONFIG"
@@ -58,4 +117,4 @@ project "Core"
 	filter "configurations:Distribution"
 		defines "DISTRIBUTION_CONFIG"
 		runtime "Release"
-		optimize "on"
\ No newline at end of file
+		optimize "on"
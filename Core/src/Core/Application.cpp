@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Application.h"
 #include "Debugging/Log.h"
+#include "Debugging/Metrics.h"
 #include <csignal>
 
 namespace Core
@@ -11,26 +12,32 @@ namespace Core
 
 		TRACE("{0} application init", specs.Title);
 
-		if (specs.HasWindow)
+		// Window is attached by application itself (see AttachWindow), so headless applications don't link graphics
+		if (!specs.HasWindow)
 		{
-			window = CreateRef<Window>(specs.WindowWidth, specs.WindowHeight, specs.Title);
-			window->SetEventCallbackFunction([this](Event& e) { OnEvent(e); });
-			window->ShowWindow();
-		}
-		else
-		{
-			signal(SIGINT, [](int) {
-				WindowClosedEvent event;
-				Application::Get().OnEvent(event);
-			});
-
-			signal(SIGTERM, [](int) {
-				WindowClosedEvent event;
-				Application::Get().OnEvent(event);
-			});
+			// Only flag is set in handler, shutdown is started from application loop
+			signal(SIGINT, [](int) { shutdownRequested.store(true, std::memory_order_relaxed); });
+			signal(SIGTERM, [](int) { shutdownRequested.store(true, std::memory_order_relaxed); });
 		}
 	}
 
+	void Application::AttachWindow(const Ref<Window>& _window)
+	{
+		window = _window;
+		window->SetEventCallbackFunction([this](Event& e) { OnEvent(e); });
+		window->ShowWindow();
+
+		windowAttached.store(true, std::memory_order_release);
+	}
+
+	void Application::RequestRedraw()
+	{
+		redrawRequested.store(true, std::memory_order_release);
+
+		if (windowAttached.load(std::memory_order_acquire))
+			window->Wake();
+	}
+
 	void Application::LoadConfig()
 	{
 		if (!std::filesystem::exists(configFilePath))
@@ -41,7 +48,11 @@ namespace Core
 
 	void Application::OnEvent(Event& e)
 	{
-		Event::Dispatch<WindowResizedEvent>(e, [this](WindowResizedEvent& e) { window->OnResize(e); });
+		// Window, network and message events change what is displayed
+		if (specs.RenderOnDemand)
+			RequestRedraw();
+
+		Event::Dispatch<WindowResizedEvent>(e, [this](WindowResizedEvent& e) { if (window) window->OnResize(e); });
 		Event::Dispatch<WindowClosedEvent>(e, [this](WindowClosedEvent& e) { OnWindowClose(e); });
 	}
 
@@ -49,16 +60,44 @@ namespace Core
 	{
 		while (isRunning)
 		{
+			if (shutdownRequested.exchange(false, std::memory_order_relaxed))
+				OnShutdownRequested();
+
+			// Idle window sleeps here, network thread wakes it with RequestRedraw when message arrives
+			bool input = false;
+			if (window && specs.RenderOnDemand)
+				input = window->WaitEvents(framesToRender ? 0.0 : IdleTimeout);
+
 			ProcessMessageQueue();
+			Metrics::Update();
+
+			if (!window)
+				continue;
 
-			if (specs.HasWindow)
+			if (!specs.RenderOnDemand)
 			{
 				window->OnUpdate();
 				window->OnRender();
+				continue;
+			}
+
+			if (input || redrawRequested.exchange(false, std::memory_order_acq_rel))
+				framesToRender = ExtraFrames;
+
+			if (framesToRender)
+			{
+				window->OnRender();
+				framesToRender--;
 			}
 		}
 	}
 
+	void Application::OnShutdownRequested()
+	{
+		WindowClosedEvent event;
+		OnEvent(event);
+	}
+
 	void Application::OnWindowClose(WindowClosedEvent& e)
 	{
 		isRunning = false;
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include "Utils/Memory.h"
 #include "Window.h"
 #include "Event/Events.h"
@@ -19,6 +20,7 @@ namespace Core
 		const char* Title;
 		CommandArgs Args;
 		bool HasWindow = true;
+		bool RenderOnDemand = false; // Window is redrawn only after input, events or RequestRedraw instead of every vsync
 		int WindowWidth;
 		int WindowHeight;
 	};
@@ -44,12 +46,21 @@ namespace Core
 		inline Window& GetWindow() { return window.Get(); }
 
 		inline void Restart() { isRunning = false; }
+
+		// Renders few more frames in RenderOnDemand mode, can be called from any thread
+		void RequestRedraw();
 	protected:
 		virtual void ReadConfigFile() = 0;
 		virtual void WriteConfigFile() = 0;
 
+		// Takes ownership of window created by CoreUI (Window::Create) and routes it's events
+		void AttachWindow(const Ref<Window>& window);
+
 		void OnWindowClose(WindowClosedEvent& e);
 
+		// Called on main thread after SIGINT or SIGTERM, closes application
+		virtual void OnShutdownRequested();
+
 		virtual void ProcessMessageQueue() = 0;
 
 		std::string configFileName = "settings.cfg";
@@ -60,7 +71,15 @@ namespace Core
 
 		bool isRunning = true;
 
+		// RenderOnDemand mode
+		static constexpr uint32_t ExtraFrames = 3; // ImGui needs few frames to settle layout and hover state after change
+		static constexpr double IdleTimeout = 1.0; // Seconds between frames of idle window
+		std::atomic<bool> redrawRequested = true;
+		std::atomic<bool> windowAttached = false;
+		uint32_t framesToRender = 0;
+
 		static inline bool isApplicationRunning = true;
+		static inline std::atomic<bool> shutdownRequested = false;
 		static inline Application* instance = nullptr;
 	};
 
@@ -29,4 +29,11 @@ int WinMain(int argc, char** argv)
 }
 #endif
 
+#elif defined(PLATFORM_LINUX)
+
+int main(int argc, char** argv)
+{
+	return Main(argc, argv);
+}
+
 #endif
\ No newline at end of file
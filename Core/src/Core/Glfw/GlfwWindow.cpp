@@ -1,5 +1,5 @@
 #include "pch.h"
-#include "Window.h"
+#include "GlfwWindow.h"
 #include <Debugging/Log.h>
 #include <GLFW/glfw3.h>
 #include <imgui.h>
@@ -9,7 +9,12 @@
 
 namespace Core
 {
-	Window::Window(int Width, int Height, const char* Title)
+	Ref<Window> Window::Create(int Width, int Height, const char* Title)
+	{
+		return new GlfwWindow(Width, Height, Title);
+	}
+
+	GlfwWindow::GlfwWindow(int Width, int Height, const char* Title)
 	{
 		data.width = Width;
 		data.height = Height;
@@ -36,7 +41,7 @@ namespace Core
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 	}
 
-	Window::~Window()
+	GlfwWindow::~GlfwWindow()
 	{
 		ImGui_ImplOpenGL3_Shutdown();
 		ImGui_ImplGlfw_Shutdown();
@@ -46,12 +51,30 @@ namespace Core
 		glfwTerminate();
 	}
 
-	void Window::OnUpdate() const
+	void GlfwWindow::OnUpdate() const
 	{
 		glfwPollEvents();
 	}
 
-	void Window::OnRender() const
+	bool GlfwWindow::WaitEvents(double timeout)
+	{
+		// While text is edited frame is rendered at least every 0.4 s, so text cursor blinks and ImGui timers run
+		bool textInput = ImGui::GetIO().WantTextInput && timeout > 0.4;
+		if (textInput)
+			timeout = 0.4;
+
+		data.inputReceived = false;
+		glfwWaitEventsTimeout(timeout);
+
+		return data.inputReceived || textInput;
+	}
+
+	void GlfwWindow::Wake() const
+	{
+		glfwPostEmptyEvent();
+	}
+
+	void GlfwWindow::OnRender() const
 	{
 		glClear(GL_COLOR_BUFFER_BIT);
 
@@ -68,12 +91,12 @@ namespace Core
 		glfwSwapBuffers(window);
 	}
 
-	void Window::OnResize(WindowResizedEvent& e)
+	void GlfwWindow::OnResize(WindowResizedEvent& e)
 	{
 		ImGui::GetIO().DisplaySize = ImVec2((float)data.width, (float)data.height);
 	}
 
-	void Window::setCallbacks()
+	void GlfwWindow::setCallbacks()
 	{
 		glfwSetErrorCallback([](int error, const char* description) {
 			ERROR("GLFW error {0}, {1}", error, description);
@@ -108,40 +131,69 @@ namespace Core
 			WindowFocusedEvent event(focused);
 			_data.callbackFunction(event);
 		});
+
+		// Input only marks window for redraw, ImGui installs it's own callbacks later and calls these from them
+		glfwSetWindowRefreshCallback(window, [](GLFWwindow* window) {
+			((WindowData*)glfwGetWindowUserPointer(window))->inputReceived = true;
+		});
+
+		glfwSetCursorPosCallback(window, [](GLFWwindow* window, double x, double y) {
+			((WindowData*)glfwGetWindowUserPointer(window))->inputReceived = true;
+		});
+
+		glfwSetCursorEnterCallback(window, [](GLFWwindow* window, int entered) {
+			((WindowData*)glfwGetWindowUserPointer(window))->inputReceived = true;
+		});
+
+		glfwSetMouseButtonCallback(window, [](GLFWwindow* window, int button, int action, int mods) {
+			((WindowData*)glfwGetWindowUserPointer(window))->inputReceived = true;
+		});
+
+		glfwSetScrollCallback(window, [](GLFWwindow* window, double x, double y) {
+			((WindowData*)glfwGetWindowUserPointer(window))->inputReceived = true;
+		});
+
+		glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
+			((WindowData*)glfwGetWindowUserPointer(window))->inputReceived = true;
+		});
+
+		glfwSetCharCallback(window, [](GLFWwindow* window, unsigned int character) {
+			((WindowData*)glfwGetWindowUserPointer(window))->inputReceived = true;
+		});
 	}
 
-	inline void Window::SetVSync(bool Enabled)
+	void GlfwWindow::SetVSync(bool Enabled)
 	{
 		glfwSwapInterval(Enabled);
 		data.isVsync = Enabled;
 	}
 
-	inline bool Window::IsMaximized() const
+	bool GlfwWindow::IsMaximized() const
 	{
 		return glfwGetWindowAttrib(window, GLFW_MAXIMIZED);
 	}
 
-	void Window::MaximizeWindow() const
+	void GlfwWindow::MaximizeWindow() const
 	{
 		glfwMaximizeWindow(window);
 	}
 
-	void Window::RestoreWindow() const
+	void GlfwWindow::RestoreWindow() const
 	{
 		glfwRestoreWindow(window);
 	}
 
-	void Window::MinimizeWindow() const
+	void GlfwWindow::MinimizeWindow() const
 	{
 		glfwMaximizeWindow(window);
 	}
 
-	void Window::ShowWindow() const
+	void GlfwWindow::ShowWindow() const
 	{
 		glfwShowWindow(window);
 	}
 
-	inline void Window::HideWindow() const
+	void GlfwWindow::HideWindow() const
 	{
 		glfwHideWindow(window);
 	}
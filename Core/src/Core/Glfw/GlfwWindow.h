@@ -0,0 +1,58 @@
+#pragma once
+#include "Core/Window.h"
+
+struct GLFWwindow;
+
+namespace Core
+{
+	class GlfwWindow : public Window
+	{
+	public:
+		GlfwWindow(int Width, int Height, const char* Title);
+		~GlfwWindow();
+
+		virtual void OnUpdate() const override;
+		virtual void OnRender() const override;
+
+		virtual bool WaitEvents(double timeout) override;
+		virtual void Wake() const override;
+
+		virtual void SetRenderFunction(const RenderFunction& function) override { data.renderFunction = function; }
+		virtual void SetEventCallbackFunction(const EventCallbackFunction& callback) override { data.callbackFunction = callback; }
+
+		inline virtual int GetWidth() const override { return data.width; }
+		inline virtual int GetHeight() const override { return data.height; };
+		inline virtual std::pair<int, int> GetCurrentResolution() const override { return { data.width, data.height }; }
+		inline virtual std::pair<int, int> GetCurrentPosition() const override { return { data.x, data.y }; }
+		inline virtual void* GetNativeWindow() const override { return (void*)window; }
+
+		inline virtual bool IsVSync() const override { return data.isVsync; }
+		virtual bool IsMaximized() const override;
+
+		virtual void SetVSync(bool Enabled) override;
+
+		virtual void MaximizeWindow() const override;
+		virtual void RestoreWindow() const override;
+		virtual void MinimizeWindow() const override;
+
+		virtual void ShowWindow() const override;
+		virtual void HideWindow() const override;
+		virtual void CloseWindow() override { WindowClosedEvent e; data.callbackFunction(e); }
+
+		virtual void OnResize(WindowResizedEvent& e) override;
+	private:
+		void setCallbacks();
+
+		struct WindowData
+		{
+			int x, y, width, height;
+			bool isVsync = false;
+			bool inputReceived = false; // Set by input callbacks, cleared by WaitEvents
+			EventCallbackFunction callbackFunction;
+			RenderFunction renderFunction;
+		};
+
+		GLFWwindow* window;
+		WindowData data;
+	};
+}
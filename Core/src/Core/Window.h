@@ -3,56 +3,49 @@
 #include "Event/Event.h"
 #include "Event/WindowEvent.h"
 
-struct GLFWwindow;
-
 namespace Core
 {
+	// Window interface, implementation lives in CoreUI library so headless applications don't depend on graphics
 	class Window
 	{
+	protected:
 		using EventCallbackFunction = std::function<void(Event&)>;
 		using RenderFunction = std::function<void()>;
 	public:
-		Window(int Width, int Height, const char* Title);
-		~Window();
+		virtual ~Window() = default;
 
-		void OnUpdate() const;
-		void OnRender() const;
+		virtual void OnUpdate() const = 0;
+		virtual void OnRender() const = 0;
 
-		void SetRenderFunction(const RenderFunction& function) { data.renderFunction = function; }
-		void SetEventCallbackFunction(const EventCallbackFunction& callback) { data.callbackFunction = callback; }
+		// Blocks until input or Wake (at most timeout seconds), returns true if user input arrived or window has to be redrawn
+		virtual bool WaitEvents(double timeout) = 0;
+		// Ends WaitEvents, can be called from any thread
+		virtual void Wake() const = 0;
 
-		inline int GetWidth() const { return data.width; }
-		inline int GetHeight() const { return data.height; };
-		inline std::pair<int, int> GetCurrentResolution() const { return { data.width, data.height }; }
-		inline std::pair<int, int> GetCurrentPosition() const { return { data.x, data.y }; }
-		inline void* GetNativeWindow() const { return (void*)window; }
+		virtual void SetRenderFunction(const RenderFunction& function) = 0;
+		virtual void SetEventCallbackFunction(const EventCallbackFunction& callback) = 0;
 
-		inline bool IsVSync() const { return data.isVsync; }
-		inline bool IsMaximized() const;
+		virtual int GetWidth() const = 0;
+		virtual int GetHeight() const = 0;
+		virtual std::pair<int, int> GetCurrentResolution() const = 0;
+		virtual std::pair<int, int> GetCurrentPosition() const = 0;
+		virtual void* GetNativeWindow() const = 0;
 
-		inline void SetVSync(bool Enabled);
+		virtual bool IsVSync() const = 0;
+		virtual bool IsMaximized() const = 0;
 
-		void MaximizeWindow() const;
-		void RestoreWindow() const;
-		void MinimizeWindow() const;
+		virtual void SetVSync(bool Enabled) = 0;
 
-		void ShowWindow() const;
-		void HideWindow() const;
-		void CloseWindow() { WindowClosedEvent e; data.callbackFunction(e); }
+		virtual void MaximizeWindow() const = 0;
+		virtual void RestoreWindow() const = 0;
+		virtual void MinimizeWindow() const = 0;
 
-		void OnResize(WindowResizedEvent& e);
-	private:
-		void setCallbacks();
+		virtual void ShowWindow() const = 0;
+		virtual void HideWindow() const = 0;
+		virtual void CloseWindow() = 0;
 
-		struct WindowData
-		{
-			int x, y, width, height;
-			bool isVsync = false;
-			EventCallbackFunction callbackFunction;
-			RenderFunction renderFunction;
-		};
+		virtual void OnResize(WindowResizedEvent& e) = 0;
 
-		GLFWwindow* window;
-		WindowData data;
+		static Ref<Window> Create(int Width, int Height, const char* Title);
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,233 @@
+#include "pch.h"
+#include "ChangeLog.h"
+#include "StatementParser.h"
+
+namespace Core
+{
+	static constexpr uint32_t Mask(ChangeEntity entity) { return (uint32_t)entity; }
+
+	// Write to table changes scope given by value of column
+	struct ScopeRule
+	{
+		const char* Table;
+		const char* Column;
+		ChangeScope Scope;
+		uint32_t Entities;
+	};
+
+	static constexpr ScopeRule ScopeRules[] = {
+		{ "messages", "team_id", ChangeScope::Team, Mask(ChangeEntity::Messages) },
+		{ "teams", "id", ChangeScope::Team, Mask(ChangeEntity::Teams) },
+		{ "teams", "owner_id", ChangeScope::User, Mask(ChangeEntity::Teams) },
+		{ "users_teams", "user_id", ChangeScope::User, Mask(ChangeEntity::Teams) },
+		{ "users_teams", "team_id", ChangeScope::Team, Mask(ChangeEntity::Teams) | Mask(ChangeEntity::Users) },
+		{ "invites", "user_id", ChangeScope::User, Mask(ChangeEntity::Invites) },
+		{ "notifications", "user_id", ChangeScope::User, Mask(ChangeEntity::Notifications) },
+		{ "assignments", "team_id", ChangeScope::Team, Mask(ChangeEntity::Assignments) },
+		{ "users_assignments", "user_id", ChangeScope::User, Mask(ChangeEntity::Assignments) },
+	};
+
+	// Entities changed in every scope by write to table without scope column (e.g. UPDATE assignments ... WHERE id = ?)
+	static uint32_t getTableEntities(std::string_view table)
+	{
+		if (table == "messages")
+			return Mask(ChangeEntity::Messages);
+		if (table == "teams")
+			return Mask(ChangeEntity::Teams);
+		if (table == "users")
+			return Mask(ChangeEntity::Users);
+		if (table == "users_teams")
+			return Mask(ChangeEntity::Teams) | Mask(ChangeEntity::Users);
+		if (table == "invites")
+			return Mask(ChangeEntity::Invites);
+		if (table == "notifications")
+			return Mask(ChangeEntity::Notifications);
+		if (table == "assignments" || table == "users_assignments" || table == "attachments")
+			return Mask(ChangeEntity::Assignments);
+
+		return AllChangeEntities;
+	}
+
+	static inline bool isIdentifier(char c) { return std::isalnum((unsigned char)c) || c == '_'; }
+
+	// Table of write statement and columns bound to parameters, with index of parameter
+	struct WriteStatement
+	{
+		std::string Table;
+		std::vector<std::pair<std::string, uint32_t>> Columns;
+	};
+
+	// INSERT INTO table (a, b) VALUES (?, ?), columns are matched to values in order
+	static void parseInsertColumns(const std::string& text, WriteStatement& statement)
+	{
+		size_t columnsStart = text.find('(');
+		size_t columnsEnd = text.find(')', columnsStart);
+		size_t values = text.find("values", columnsEnd);
+		size_t valuesStart = text.find('(', values);
+		if (columnsStart == std::string::npos || columnsEnd == std::string::npos || values == std::string::npos || valuesStart == std::string::npos)
+			return;
+
+		std::vector<std::string> columns;
+		std::istringstream columnList(text.substr(columnsStart + 1, columnsEnd - columnsStart - 1));
+		std::string column;
+		while (std::getline(columnList, column, ','))
+			columns.push_back(StatementParser::NormalizeName(column));
+
+		uint32_t parameter = 0;
+		uint32_t value = 0;
+		for (size_t i = valuesStart + 1; i < text.size() && text[i] != ')' && value < columns.size(); i++)
+		{
+			if (text[i] == '?')
+				statement.Columns.emplace_back(columns[value], parameter++);
+			else if (text[i] == ',')
+				value++;
+		}
+	}
+
+	// "column = ?" after WHERE, parameters before it (SET a = ?) are counted too
+	static void parseWhereColumns(const std::string& text, WriteStatement& statement)
+	{
+		size_t where = text.find(" where ");
+
+		uint32_t parameter = 0;
+		bool quoted = false;
+		for (size_t i = 0; i < text.size(); i++)
+		{
+			if (text[i] == '\'')
+				quoted = !quoted;
+
+			if (quoted || text[i] != '?')
+				continue;
+
+			if (where != std::string::npos && i > where)
+			{
+				size_t position = i;
+				while (position > 0 && text[position - 1] == ' ')
+					position--;
+
+				if (position > 0 && text[position - 1] == '=')
+				{
+					position--;
+					while (position > 0 && text[position - 1] == ' ')
+						position--;
+
+					size_t end = position;
+					while (position > 0 && (isIdentifier(text[position - 1]) || text[position - 1] == '.' || text[position - 1] == '`'))
+						position--;
+
+					statement.Columns.emplace_back(StatementParser::NormalizeName(std::string_view(text).substr(position, end - position)), parameter);
+				}
+			}
+
+			parameter++;
+		}
+	}
+
+	static bool parseWriteStatement(const char* commandString, WriteStatement& statement)
+	{
+		statement.Table = StatementParser::GetWrittenTable(commandString);
+		if (statement.Table.empty())
+			return false;
+
+		std::string text = StatementParser::ToLower(commandString);
+		if (text.starts_with("insert"))
+			parseInsertColumns(text, statement);
+		else
+			parseWhereColumns(text, statement);
+
+		return true;
+	}
+
+	ChangeLog::ChangeLog()
+	{
+		sequence = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		firstSequence = sequence;
+	}
+
+	void ChangeLog::Record(const Command& command)
+	{
+		WriteStatement statement;
+		if (!parseWriteStatement(command.GetCommandString(), statement))
+			return;
+
+		sequence++;
+		recordedChanges.Add();
+
+		bool scoped = false;
+		for (const ScopeRule& rule : ScopeRules)
+		{
+			if (statement.Table != rule.Table)
+				continue;
+
+			for (auto& [column, parameter] : statement.Columns)
+			{
+				if (column != rule.Column || parameter >= command.GetDataCount() || command.GetDataType(parameter) != DatabaseDataType::Int)
+					continue;
+
+				record(scopes[getKey(rule.Scope, command.GetInt(parameter))], rule.Entities);
+				scoped = true;
+			}
+		}
+
+		if (!scoped)
+		{
+			record(global, getTableEntities(statement.Table));
+			globalChanges.Add();
+		}
+	}
+
+	SyncEntry ChangeLog::GetChanges(const SyncEntry& request)
+	{
+		syncs.Add();
+
+		SyncEntry entry;
+		entry.Id = request.Id;
+		entry.Scope = request.Scope;
+		entry.Sequence = sequence;
+
+		// Sequence of previous server run or of other server
+		if (request.Sequence < firstSequence || request.Sequence > sequence)
+		{
+			entry.FullResync = 1;
+			entry.Changes = AllChangeEntities;
+			fullResyncs.Add();
+			return entry;
+		}
+
+		entry.Changes = getChanges(global, request.Sequence);
+
+		auto scope = scopes.find(getKey(request.Scope, request.Id));
+		if (scope != scopes.end())
+			entry.Changes |= getChanges(scope->second, request.Sequence);
+
+		return entry;
+	}
+
+	void ChangeLog::Reset()
+	{
+		firstSequence = ++sequence;
+		scopes.clear();
+		global = ScopeChanges();
+	}
+
+	uint32_t ChangeLog::getChanges(const ScopeChanges& changes, uint64_t since)
+	{
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < ChangeEntityCount; i++)
+		{
+			if (changes.Sequences[i] > since)
+				mask |= 1 << i;
+		}
+
+		return mask;
+	}
+
+	void ChangeLog::record(ScopeChanges& changes, uint32_t entities)
+	{
+		for (uint32_t i = 0; i < ChangeEntityCount; i++)
+		{
+			if (entities & (1 << i))
+				changes.Sequences[i] = sequence;
+		}
+	}
+}
\ No newline at end of file
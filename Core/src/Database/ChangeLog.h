@@ -0,0 +1,48 @@
+#pragma once
+#include "Command.h"
+#include "Networking/Sync.h"
+#include "Debugging/Metrics.h"
+
+namespace Core
+{
+	// Sequence of changes made by INSERT, UPDATE and DELETE statements, recorded per user and team scope
+	// Scope is found from columns of statement (team_id = ?, INSERT INTO messages (content, team_id...)), writes without known scope change every scope
+	// Only the last sequence of every entity is kept, so answer to sync is mask of entities changed since requested sequence
+	// Log has to be used from one thread (server's update loop)
+	class ChangeLog
+	{
+	public:
+		// Sequences start at current time in microseconds, so sequences of previous server run are older than any of this one
+		ChangeLog();
+
+		// Records change made by successfully executed statement
+		void Record(const Command& command);
+		// Response entry for request entry of client
+		SyncEntry GetChanges(const SyncEntry& request);
+
+		// Database could have been changed by someone else, all clients have to read everything again
+		void Reset();
+
+		inline const uint64_t GetSequence() const { return sequence; }
+	private:
+		struct ScopeChanges
+		{
+			uint64_t Sequences[ChangeEntityCount] = {}; // Last change of every entity
+		};
+
+		static inline uint64_t getKey(ChangeScope scope, uint32_t id) { return (uint64_t)scope << 32 | id; }
+		static uint32_t getChanges(const ScopeChanges& changes, uint64_t since);
+		void record(ScopeChanges& changes, uint32_t entities);
+
+		uint64_t sequence = 0;
+		uint64_t firstSequence = 0; // Changes before are not known
+
+		std::unordered_map<uint64_t, ScopeChanges> scopes;
+		ScopeChanges global; // Changes of every scope
+
+		Counter recordedChanges = Metrics::GetCounter("change_log_changes_total");
+		Counter globalChanges = Metrics::GetCounter("change_log_global_changes_total");
+		Counter syncs = Metrics::GetCounter("sync_scopes_total");
+		Counter fullResyncs = Metrics::GetCounter("sync_full_resyncs_total");
+	};
+}
\ No newline at end of file
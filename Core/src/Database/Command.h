@@ -28,67 +28,35 @@ namespace Core
 			commandString[sizeof(commandString) - 1] = '\0';
 		}
 
+		// Statement is sent without unused part of it's array
 		void Serialize(Ref<Buffer>& buffer) const override
 		{
-			std::ostringstream os;
+			uint16_t length = (uint16_t)strlen(commandString);
 
-			os.write(reinterpret_cast<const char*>(&taskId), sizeof(taskId));
-			os.write(reinterpret_cast<const char*>(&type), sizeof(type));
-			os.write(commandString, sizeof(commandString));
+			buffer = CreateRef<Buffer>(sizeof(taskId) + sizeof(type) + sizeof(length) + length + getSerializedDataSize());
 
-			uint32_t count = data.size();
-			os.write(reinterpret_cast<const char*>(&count), sizeof(count));
-
-			for (const auto& item : data)
-			{
-				DatabaseDataType type = item->GetType();
-				os.write(reinterpret_cast<const char*>(&type), sizeof(type));
-				item->Serialize(os);
-			}
-
-			buffer = CreateRef<Buffer>(os.str().size());
-			buffer->Write(os.str().data(), os.str().size());
+			Writer writer = { buffer->GetData() };
+			writer.Write(taskId);
+			writer.Write(type);
+			writer.Write(length);
+			writer.Write(commandString, length);
+			serializeData(writer);
 		}
 
 		void Deserialize(Ref<Buffer>& buffer) override
 		{
-			std::istringstream is(std::string(buffer->GetData(), buffer->GetSize()));
-
-			is.read(reinterpret_cast<char*>(&taskId), sizeof(taskId));
-			is.read(reinterpret_cast<char*>(&type), sizeof(type));
-			is.read(commandString, sizeof(commandString));
+			Reader reader = { buffer->GetData(), buffer->GetData() + buffer->GetSize() };
 
-			uint32_t count = 0;
-			is.read(reinterpret_cast<char*>(&count), sizeof(count));
-
-			data.clear();
-			data.reserve(count);
-
-			for (uint32_t i = 0; i < count; ++i)
+			uint16_t length = 0;
+			if (!reader.Read(taskId) || !reader.Read(type) || !reader.Read(length) || length >= sizeof(commandString) || !reader.Read(commandString, length))
 			{
-				DatabaseDataType type = DatabaseDataType::None;
-				is.read(reinterpret_cast<char*>(&type), sizeof(type));
-
-				Ref<DatabaseData> item;
-				switch (type)
-				{
-				case DatabaseDataType::Int:
-					item = new DatabaseInt();
-					break;
-				case DatabaseDataType::String:
-					item = new DatabaseString();
-					break;
-				case DatabaseDataType::Bool:
-					item = new DatabaseBool();
-					break;
-				case DatabaseDataType::Timestamp:
-					item = new DatabaseTimestamp();
-					break;
-				}
-
-				item->Deserialize(is);
-				data.push_back(item);
+				commandString[0] = '\0';
+				ClearData();
+				return;
 			}
+
+			commandString[length] = '\0';
+			deserializeData(reader);
 		}
 	private:
 		char commandString[400] = {};
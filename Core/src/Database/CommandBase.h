@@ -5,25 +5,237 @@
 
 namespace Core
 {
+	// Parameters of command or values of response rows, stored in three arrays instead of heap object per value
+	// Every value has one byte tag and one 8 byte slot, slot of string is offset of it's null terminated text in string arena
+	// Pointers returned by GetString are valid until another string is added
 	class CommandBase
 	{
 	public:
+		static constexpr uint32_t MaxStringLength = 255; // Longer strings are truncated
+
 		CommandBase() = default;
 		CommandBase(uint32_t id) : taskId(id) {}
+		virtual ~CommandBase() = default;
 
 		inline const uint32_t GetTaskId() const { return taskId; }
-		inline const uint32_t GetDataCount() const { return data.size(); }
-		inline bool HasData() const { return data.size() != 0; }
-		inline std::vector<Ref<DatabaseData>>& GetData() { return data; }
+		inline const uint32_t GetDataCount() const { return (uint32_t)types.size(); }
+		inline bool HasData() const { return !types.empty(); }
+		inline DatabaseDataType GetDataType(uint32_t index) const { return types[index]; }
+
+		inline int GetInt(uint32_t index) const { return (int)values[index]; }
+		inline bool GetBool(uint32_t index) const { return values[index]; }
+		inline time_t GetTimestamp(uint32_t index) const { return (time_t)values[index]; }
+		inline const char* GetString(uint32_t index) const { return types[index] == DatabaseDataType::String ? strings.data() + values[index] : ""; }
+
+		inline void AddInt(int value) { add(DatabaseDataType::Int, value); }
+		inline void AddBool(bool value) { add(DatabaseDataType::Bool, value); }
+		inline void AddTimestamp(time_t value) { add(DatabaseDataType::Timestamp, value); }
+
+		void AddString(std::string_view value)
+		{
+			if (value.size() > MaxStringLength)
+				value = value.substr(0, MaxStringLength);
+
+			add(DatabaseDataType::String, strings.size());
+			strings.insert(strings.end(), value.begin(), value.end());
+			strings.push_back('\0');
+		}
+
+		// Capacity for count more values and stringBytes more characters of strings
+		void Reserve(uint32_t count, uint32_t stringBytes = 0)
+		{
+			types.reserve(types.size() + count);
+			values.reserve(values.size() + count);
+			strings.reserve(strings.size() + stringBytes);
+		}
+
+		void AppendData(const CommandBase& other)
+		{
+			Reserve(other.GetDataCount(), (uint32_t)other.strings.size());
+
+			uint64_t stringOffset = strings.size();
+			for (uint32_t i = 0; i < other.GetDataCount(); i++)
+				add(other.types[i], other.types[i] == DatabaseDataType::String ? other.values[i] + stringOffset : other.values[i]);
 
-		inline void AddData(Ref<DatabaseData> ref) { data.push_back(ref); }
+			strings.insert(strings.end(), other.strings.begin(), other.strings.end());
+		}
+
+		// Appends count values of other starting at first
+		void AppendData(const CommandBase& other, uint32_t first, uint32_t count)
+		{
+			Reserve(count);
+
+			for (uint32_t i = first; i < first + count; i++)
+			{
+				if (other.types[i] == DatabaseDataType::String)
+					AddString(other.GetString(i));
+				else
+					add(other.types[i], other.values[i]);
+			}
+		}
+
+		void ClearData()
+		{
+			types.clear();
+			values.clear();
+			strings.clear();
+		}
+
+		// Memory held by value arrays
+		inline size_t GetDataSize() const { return types.capacity() + values.capacity() * sizeof(int64_t) + strings.capacity(); }
 
 		virtual void Serialize(Ref<Buffer>& buffer) const = 0;
 		virtual void Deserialize(Ref<Buffer>& buffer) = 0;
-
-		inline DatabaseData& operator[] (const int index) { return data[index].Get(); }
 	protected:
-		std::vector<Ref<DatabaseData>> data;
+		// Writes into buffer allocated for exact size of message
+		struct Writer
+		{
+			char* Position;
+
+			inline void Write(const void* data, size_t size) { memcpy(Position, data, size); Position += size; }
+
+			template<typename T>
+			inline void Write(T value) { Write(&value, sizeof(T)); }
+		};
+
+		// Reads received message, fails instead of reading past it's end
+		struct Reader
+		{
+			const char* Position;
+			const char* End;
+
+			inline bool Read(void* data, size_t size)
+			{
+				if ((size_t)(End - Position) < size)
+					return false;
+
+				memcpy(data, Position, size);
+				Position += size;
+				return true;
+			}
+
+			template<typename T>
+			inline bool Read(T& value) { return Read(&value, sizeof(T)); }
+		};
+
+		// Wire format of values: count, tag of every value, then values (int 4, bool 1, timestamp 8 bytes, string 4 bytes length and text)
+		size_t getSerializedDataSize() const
+		{
+			size_t size = sizeof(uint32_t) + types.size();
+			for (DatabaseDataType type : types)
+				size += GetDatabaseDataSize(type);
+
+			// Text of every string without null terminator
+			return size + strings.size() - std::count(types.begin(), types.end(), DatabaseDataType::String);
+		}
+
+		void serializeData(Writer& writer) const
+		{
+			writer.Write((uint32_t)types.size());
+			writer.Write(types.data(), types.size());
+
+			for (uint32_t i = 0; i < types.size(); i++)
+			{
+				switch (types[i])
+				{
+					case DatabaseDataType::Int:
+						writer.Write((int32_t)values[i]);
+						break;
+					case DatabaseDataType::Bool:
+						writer.Write((bool)values[i]);
+						break;
+					case DatabaseDataType::Timestamp:
+						writer.Write((int64_t)values[i]);
+						break;
+					case DatabaseDataType::String:
+					{
+						uint32_t length = (uint32_t)strlen(strings.data() + values[i]);
+						writer.Write(length);
+						writer.Write(strings.data() + values[i], length);
+						break;
+					}
+					default:
+						break;
+				}
+			}
+		}
+
+		// Data is cleared if message is malformed
+		bool deserializeData(Reader& reader)
+		{
+			ClearData();
+
+			uint32_t count = 0;
+			if (!reader.Read(count) || count > (size_t)(reader.End - reader.Position))
+				return false;
+
+			types.resize(count);
+			values.resize(count);
+			if (!reader.Read(types.data(), count))
+			{
+				ClearData();
+				return false;
+			}
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				bool success = false;
+				switch (types[i])
+				{
+					case DatabaseDataType::Int:
+					{
+						int32_t value = 0;
+						success = reader.Read(value);
+						values[i] = value;
+						break;
+					}
+					case DatabaseDataType::Bool:
+					{
+						bool value = false;
+						success = reader.Read(value);
+						values[i] = value;
+						break;
+					}
+					case DatabaseDataType::Timestamp:
+						success = reader.Read(values[i]);
+						break;
+					case DatabaseDataType::String:
+					{
+						uint32_t length = 0;
+						if (!reader.Read(length) || length > MaxStringLength || length > (size_t)(reader.End - reader.Position))
+							break;
+
+						values[i] = strings.size();
+						strings.insert(strings.end(), reader.Position, reader.Position + length);
+						strings.push_back('\0');
+						reader.Position += length;
+						success = true;
+						break;
+					}
+					default:
+						break;
+				}
+
+				if (!success)
+				{
+					ClearData();
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		std::vector<DatabaseDataType> types;
+		std::vector<int64_t> values;
+		std::vector<char> strings;
+
 		uint32_t taskId = 0;
+	private:
+		inline void add(DatabaseDataType type, int64_t value)
+		{
+			types.push_back(type);
+			values.push_back(value);
+		}
 	};
 }
\ No newline at end of file
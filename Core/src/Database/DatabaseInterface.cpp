@@ -0,0 +1,152 @@
+#include "pch.h"
+#include "DatabaseInterface.h"
+#include "Statements.h"
+#include "Debugging/Log.h"
+#include "SQLConnector/SQLInterface.h"
+#include "Memory/MemoryInterface.h"
+
+#ifdef DATABASE_SQLITE
+	#include "SQLite/SQLiteInterface.h"
+#endif
+
+namespace Core
+{
+	Ref<DatabaseInterface> DatabaseInterface::Create(const DatabaseSpecifications& specs)
+	{
+		Ref<DatabaseInterface> databaseInterface = CreateBackend(specs);
+
+		if (specs.SeedUsers && databaseInterface->IsConnected())
+			databaseInterface->Seed(specs.SeedUsers);
+
+		return databaseInterface;
+	}
+
+	Ref<DatabaseInterface> DatabaseInterface::CreateBackend(const DatabaseSpecifications& specs)
+	{
+		switch (specs.Backend)
+		{
+			case DatabaseBackend::SQLite:
+			{
+			#ifdef DATABASE_SQLITE
+				return new SQLiteInterface(specs.FilePath.c_str());
+			#else
+				ERROR("SQLite database backend is not built (premake --sqlite), using memory backend!");
+				return new MemoryInterface();
+			#endif
+			}
+			case DatabaseBackend::Memory:
+				return new MemoryInterface();
+			default:
+				return new SQLInterface(specs.Address.c_str(), specs.Name.c_str(), specs.Username.c_str(), specs.Password.c_str());
+		}
+	}
+
+	Ref<DatabaseInterface> DatabaseInterface::Create(const char* address, const char* databaseName, const char* username, const char* password)
+	{
+		return new SQLInterface(address, databaseName, username, password);
+	}
+
+	// Seeding uses the same statements as applications, so it works with every backend
+	void DatabaseInterface::Seed(uint32_t userCount, uint32_t teamSize)
+	{
+		auto insert = [this](Command& command) -> int {
+			if (!Execute(command))
+				return 0;
+
+			Command lastId;
+			lastId.SetCommandString(Statements::LastInsertId);
+			Query(lastId);
+
+			Response response;
+			FetchData(response);
+			return response.HasData() ? response.GetInt(0) : 0;
+		};
+
+		// Database is already seeded
+		Command check;
+		check.SetCommandString(Statements::SelectUserIdByEmail);
+		check.AddString("loadgen0@dmp.test");
+		Query(check);
+
+		Response existing;
+		FetchData(existing);
+		if (existing.HasData())
+			return;
+
+		time_t deadline = time(nullptr) + 30 * 24 * 60 * 60;
+		int teamId = 0;
+		std::vector<int> assignmentIds;
+
+		for (uint32_t i = 0; i < userCount; i++)
+		{
+			Command user;
+			user.SetCommandString(Statements::InsertUser);
+			user.AddString("Load");
+			user.AddString("Gen" + std::to_string(i));
+			user.AddString("loadgen" + std::to_string(i) + "@dmp.test");
+			user.AddString("");
+			int userId = insert(user);
+
+			// First user of every group owns the team and it's assignments
+			if (i % teamSize == 0)
+			{
+				Command team;
+				team.SetCommandString(Statements::InsertTeam);
+				team.AddString("LoadGen " + std::to_string(i / teamSize));
+				team.AddInt(userId);
+				teamId = insert(team);
+
+				assignmentIds.clear();
+				for (uint32_t j = 1; j <= 3; j++)
+				{
+					Command assignment;
+					assignment.SetCommandString(Statements::InsertAssignment);
+					assignment.AddInt(teamId);
+					assignment.AddString("LoadGen assignment " + std::to_string(j));
+					assignment.AddString("Generated by database seed");
+					assignment.AddTimestamp(deadline);
+					assignmentIds.push_back(insert(assignment));
+				}
+			}
+
+			Command userTeam;
+			userTeam.SetCommandString(Statements::InsertTeamMember);
+			userTeam.AddInt(userId);
+			userTeam.AddInt(teamId);
+			Execute(userTeam);
+
+			for (int assignmentId : assignmentIds)
+			{
+				Command userAssignment;
+				userAssignment.SetCommandString(Statements::InsertAssignmentUser);
+				userAssignment.AddInt(userId);
+				userAssignment.AddInt(assignmentId);
+				Execute(userAssignment);
+			}
+		}
+
+		INFO("Database seeded with {0} users", userCount);
+	}
+
+	DatabaseBackend DatabaseInterface::GetBackend(const std::string& name)
+	{
+		if (name == "sqlite")
+			return DatabaseBackend::SQLite;
+		else if (name == "memory")
+			return DatabaseBackend::Memory;
+		else if (name != "mysql")
+			ERROR("Unknown database backend {0}, using mysql!", name);
+
+		return DatabaseBackend::MySQL;
+	}
+
+	const char* DatabaseInterface::GetBackendName(DatabaseBackend backend)
+	{
+		switch (backend)
+		{
+			case DatabaseBackend::SQLite: return "sqlite";
+			case DatabaseBackend::Memory: return "memory";
+			default: return "mysql";
+		}
+	}
+}
\ No newline at end of file
@@ -5,6 +5,30 @@
 
 namespace Core
 {
+	enum class DatabaseBackend
+	{
+		MySQL = 0,
+		SQLite, // Embedded database file, built with premake --sqlite
+		Memory, // Tables of dmp schema in memory, lost on exit
+	};
+
+	struct DatabaseSpecifications
+	{
+		DatabaseBackend Backend = DatabaseBackend::MySQL;
+
+		// MySQL
+		std::string Address = "tcp://127.0.0.1:3306";
+		std::string Name = "dmp";
+		std::string Username = "dmp";
+		std::string Password = "Tester_123";
+
+		// SQLite (":memory:" for in-memory SQLite database)
+		std::string FilePath = "dmp.sqlite";
+
+		// Count of generated test users (see DatabaseInterface::Seed), 0 disables seeding
+		uint32_t SeedUsers = 0;
+	};
+
 	class DatabaseInterface
 	{
 	public:
@@ -19,6 +43,16 @@ namespace Core
 		virtual bool Update(Command& command) = 0;
 		virtual void FetchData(Response& response) = 0;
 
+		// Fills empty database with test users (loadgen<n>@dmp.test), their teams and assignments like LoadGen/seed.sql
+		void Seed(uint32_t userCount, uint32_t teamSize = 50);
+
+		static Ref<DatabaseInterface> Create(const DatabaseSpecifications& specs);
 		static Ref<DatabaseInterface> Create(const char* address, const char* databaseName, const char* username, const char* password);
+
+		// Backend names used in config files (mysql, sqlite, memory)
+		static DatabaseBackend GetBackend(const std::string& name);
+		static const char* GetBackendName(DatabaseBackend backend);
+	private:
+		static Ref<DatabaseInterface> CreateBackend(const DatabaseSpecifications& specs);
 	};
 }
\ No newline at end of file
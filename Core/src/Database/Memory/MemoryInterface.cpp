@@ -0,0 +1,597 @@
+#include "pch.h"
+#include "MemoryInterface.h"
+#include "Database/Statements.h"
+#include "Debugging/Log.h"
+
+namespace Core
+{
+	// Statements are matched without trailing semicolon, runs of whitespace are matched as one space
+	static std::string NormalizeStatement(const char* statement)
+	{
+		std::string normalized;
+		for (const char* c = statement; *c; c++)
+		{
+			if (!isspace((unsigned char)*c))
+				normalized += *c;
+			else if (!normalized.empty() && normalized.back() != ' ')
+				normalized += ' ';
+		}
+
+		while (!normalized.empty() && (normalized.back() == ';' || normalized.back() == ' '))
+			normalized.pop_back();
+
+		return normalized;
+	}
+
+	MemoryInterface::MemoryInterface()
+	{
+		RegisterQueries();
+		RegisterCommands();
+		RegisterUpdates();
+
+		// Statement without handler would fail only when it's sent
+		for (const char* statement : Statements::All)
+		{
+			if (!statements.contains(NormalizeStatement(statement)))
+				ERROR("Statement has no handler in memory database: {0}", statement);
+		}
+
+		INFO("Memory database created!");
+	}
+
+	bool MemoryInterface::Execute(Command& command)
+	{
+		return Run(command);
+	}
+
+	bool MemoryInterface::Query(Command& command)
+	{
+		result.ClearData();
+		return Run(command);
+	}
+
+	bool MemoryInterface::Update(Command& command)
+	{
+		return Run(command);
+	}
+
+	void MemoryInterface::FetchData(Response& response)
+	{
+		response.AppendData(result);
+		result.ClearData();
+	}
+
+	bool MemoryInterface::Run(Command& command)
+	{
+		auto statement = statements.find(NormalizeStatement(command.GetCommandString()));
+		if (statement == statements.end())
+		{
+			ERROR("Statement not supported by memory database: {0}", command.GetCommandString());
+			return false;
+		}
+
+		if (command.GetDataCount() != statement->second.ParameterCount)
+		{
+			ERROR("Statement expects {0} parameters, got {1}: {2}", statement->second.ParameterCount, command.GetDataCount(), command.GetCommandString());
+			return false;
+		}
+
+		return statement->second.Handler(command);
+	}
+
+	void MemoryInterface::RegisterStatement(const char* statement, const StatementHandler& handler)
+	{
+		std::string normalized = NormalizeStatement(statement);
+		uint32_t parameterCount = std::count(normalized.begin(), normalized.end(), '?');
+
+		statements[normalized] = { handler, parameterCount };
+	}
+
+	void MemoryInterface::RegisterQueries()
+	{
+		RegisterStatement(Statements::LastInsertId, [this](Command&) {
+			result.AddInt(lastInsertId);
+			return true;
+		});
+
+		// Users
+		RegisterStatement(Statements::SelectLogin, [this](Command& command) {
+			auto id = usersByEmail.find(command.GetString(0));
+			if (id == usersByEmail.end())
+				return true;
+
+			UserRow* user = users.Find(id->second);
+			result.AddInt(user->Id);
+			result.AddString(user->Password);
+			result.AddString(user->FirstName);
+			result.AddString(user->LastName);
+			result.AddString(user->Email);
+			result.AddString(user->Role);
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectUserIdByEmail, [this](Command& command) {
+			auto id = usersByEmail.find(command.GetString(0));
+			if (id == usersByEmail.end())
+				return true;
+
+			result.AddInt(id->second);
+			result.AddString(id->first);
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectUser, [this](Command& command) {
+			if (UserRow* user = users.Find(command.GetInt(0)))
+			{
+				result.AddString(user->FirstName);
+				result.AddString(user->LastName);
+				result.AddString(user->Email);
+				result.AddString(user->Role);
+			}
+			return true;
+		});
+
+		// Teams
+		RegisterStatement(Statements::SelectUserTeams, [this](Command& command) {
+			int userId = command.GetInt(0);
+			for (auto& [id, userTeam] : usersTeams.GetRows())
+			{
+				if (userTeam.UserId != userId)
+					continue;
+
+				if (TeamRow* team = teams.Find(userTeam.TeamId))
+				{
+					result.AddInt(team->Id);
+					result.AddInt(team->OwnerId);
+					result.AddString(team->Name);
+				}
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectTeamMembers, [this](Command& command) {
+			int teamId = command.GetInt(0);
+			for (auto& [id, userTeam] : usersTeams.GetRows())
+			{
+				if (userTeam.TeamId != teamId)
+					continue;
+
+				if (UserRow* user = users.Find(userTeam.UserId))
+				{
+					result.AddInt(user->Id);
+					result.AddString(user->FirstName);
+					result.AddString(user->LastName);
+				}
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectTeamMember, [this](Command& command) {
+			int teamId = command.GetInt(0);
+			int userId = command.GetInt(1);
+			for (auto& [id, userTeam] : usersTeams.GetRows())
+			{
+				if (userTeam.TeamId == teamId && userTeam.UserId == userId)
+					result.AddInt(userTeam.UserId);
+			}
+			return true;
+		});
+
+		// Last 40 messages of team in ascending order
+		RegisterStatement(Statements::SelectTeamMessages, [this](Command& command) {
+			auto teamMessages = messagesByTeam.find(command.GetInt(0));
+			if (teamMessages == messagesByTeam.end())
+				return true;
+
+			std::vector<int>& ids = teamMessages->second;
+			for (size_t i = ids.size() > 40 ? ids.size() - 40 : 0; i < ids.size(); i++)
+			{
+				MessageRow* message = messages.Find(ids[i]);
+				UserRow* author = message ? users.Find(message->AuthorId) : nullptr;
+				if (!author)
+					continue;
+
+				result.AddInt(message->Id);
+				result.AddString(message->Content);
+				result.AddString(author->FirstName);
+				result.AddString(author->LastName);
+				result.AddInt(message->AuthorId);
+			}
+			return true;
+		});
+
+		// Last 40 messages of team newer than given id in ascending order (client reads only new messages)
+		RegisterStatement(Statements::SelectTeamMessagesAfter, [this](Command& command) {
+			auto teamMessages = messagesByTeam.find(command.GetInt(0));
+			if (teamMessages == messagesByTeam.end())
+				return true;
+
+			// Ids of team are ascending
+			std::vector<int>& ids = teamMessages->second;
+			size_t first = std::upper_bound(ids.begin(), ids.end(), command.GetInt(1)) - ids.begin();
+			for (size_t i = std::max(first, ids.size() > 40 ? ids.size() - 40 : 0); i < ids.size(); i++)
+			{
+				MessageRow* message = messages.Find(ids[i]);
+				UserRow* author = message ? users.Find(message->AuthorId) : nullptr;
+				if (!author)
+					continue;
+
+				result.AddInt(message->Id);
+				result.AddString(message->Content);
+				result.AddString(author->FirstName);
+				result.AddString(author->LastName);
+				result.AddInt(message->AuthorId);
+			}
+			return true;
+		});
+
+		// Invites and notifications
+		RegisterStatement(Statements::SelectUserInvites, [this](Command& command) {
+			int userId = command.GetInt(0);
+			for (auto& [id, invite] : invites.GetRows())
+			{
+				if (invite.UserId != userId)
+					continue;
+
+				if (TeamRow* team = teams.Find(invite.TeamId))
+				{
+					result.AddInt(invite.Id);
+					result.AddInt(team->Id);
+					result.AddString(team->Name);
+				}
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectInvite, [this](Command& command) {
+			int teamId = command.GetInt(0);
+			int userId = command.GetInt(1);
+			for (auto& [id, invite] : invites.GetRows())
+			{
+				if (invite.TeamId == teamId && invite.UserId == userId)
+					result.AddInt(invite.UserId);
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectNotifications, [this](Command& command) {
+			int userId = command.GetInt(0);
+			for (auto notification = notifications.GetRows().rbegin(); notification != notifications.GetRows().rend(); notification++)
+			{
+				if (notification->second.UserId != userId)
+					continue;
+
+				result.AddInt(notification->second.Id);
+				result.AddString(notification->second.Message);
+			}
+			return true;
+		});
+
+		// Assignments, ordered by deadline and limited to 200 like in MySQL
+		auto addAssignments = [this](std::vector<AssignmentRow*>& rows) {
+			std::stable_sort(rows.begin(), rows.end(), [](AssignmentRow* a, AssignmentRow* b) { return a->Deadline < b->Deadline; });
+			if (rows.size() > 200)
+				rows.resize(200);
+
+			for (AssignmentRow* assignment : rows)
+			{
+				result.AddInt(assignment->Id);
+				result.AddString(assignment->Name);
+				result.AddString(assignment->Description);
+				result.AddString(assignment->Status);
+				result.AddInt(assignment->Rating);
+				result.AddString(assignment->RatingDescription);
+				result.AddTimestamp(assignment->Deadline);
+				result.AddTimestamp(assignment->SubmittedAt);
+			}
+		};
+
+		RegisterStatement(Statements::SelectUserAssignments, [this, addAssignments](Command& command) {
+			int userId = command.GetInt(0);
+			int teamId = command.GetInt(1);
+
+			std::vector<AssignmentRow*> rows;
+			for (auto& [id, userAssignment] : usersAssignments.GetRows())
+			{
+				if (userAssignment.UserId != userId)
+					continue;
+
+				AssignmentRow* assignment = assignments.Find(userAssignment.AssignmentId);
+				if (assignment && assignment->TeamId == teamId)
+					rows.push_back(assignment);
+			}
+
+			addAssignments(rows);
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectTeamAssignments, [this, addAssignments](Command& command) {
+			int teamId = command.GetInt(0);
+
+			std::vector<AssignmentRow*> rows;
+			for (auto& [id, assignment] : assignments.GetRows())
+			{
+				if (assignment.TeamId == teamId)
+					rows.push_back(&assignment);
+			}
+
+			addAssignments(rows);
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectAssignmentUsers, [this](Command& command) {
+			int assignmentId = command.GetInt(0);
+			for (auto& [id, userAssignment] : usersAssignments.GetRows())
+			{
+				if (userAssignment.AssignmentId != assignmentId)
+					continue;
+
+				if (UserRow* user = users.Find(userAssignment.UserId))
+				{
+					result.AddInt(userAssignment.AssignmentId);
+					result.AddInt(user->Id);
+					result.AddString(user->FirstName);
+					result.AddString(user->LastName);
+				}
+			}
+			return true;
+		});
+
+		// Attachments
+		RegisterStatement(Statements::SelectAssignmentAttachments, [this](Command& command) {
+			int assignmentId = command.GetInt(0);
+			for (auto& [id, attachment] : attachments.GetRows())
+			{
+				if (attachment.AssignmentId != assignmentId)
+					continue;
+
+				result.AddInt(attachment.Id);
+				result.AddString(attachment.FileName);
+				result.AddBool(attachment.ByUser);
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectAttachmentFile, [this](Command& command) {
+			if (AttachmentRow* attachment = attachments.Find(command.GetInt(0)))
+			{
+				result.AddString(attachment->FilePath);
+				result.AddString(attachment->FileName);
+			}
+			return true;
+		});
+
+		// Attachment store counts references on start and reads contents of attachments before they are deleted
+		RegisterStatement(Statements::SelectAttachmentContents, [this](Command&) {
+			for (auto& [id, attachment] : attachments.GetRows())
+			{
+				result.AddInt(attachment.Id);
+				result.AddString(attachment.FilePath);
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectAttachmentContent, [this](Command& command) {
+			if (AttachmentRow* attachment = attachments.Find(command.GetInt(0)))
+				result.AddString(attachment->FilePath);
+			return true;
+		});
+
+		RegisterStatement(Statements::SelectAssignmentAttachmentContents, [this](Command& command) {
+			int assignmentId = command.GetInt(0);
+			for (auto& [id, attachment] : attachments.GetRows())
+			{
+				if (attachment.AssignmentId == assignmentId)
+					result.AddString(attachment.FilePath);
+			}
+			return true;
+		});
+	}
+
+	void MemoryInterface::RegisterCommands()
+	{
+		// Inserts
+		RegisterStatement(Statements::InsertUser, [this](Command& command) {
+			// Email is unique
+			if (usersByEmail.contains(command.GetString(2)))
+				return false;
+
+			UserRow row;
+			row.FirstName = command.GetString(0);
+			row.LastName = command.GetString(1);
+			row.Email = command.GetString(2);
+			row.Password = command.GetString(3);
+
+			lastInsertId = users.Insert(row).Id;
+			usersByEmail[row.Email] = lastInsertId;
+			return true;
+		});
+
+		RegisterStatement(Statements::InsertTeam, [this](Command& command) {
+			lastInsertId = teams.Insert({ 0, command.GetString(0), command.GetInt(1) }).Id;
+			return true;
+		});
+
+		RegisterStatement(Statements::InsertTeamMember, [this](Command& command) {
+			lastInsertId = usersTeams.Insert({ 0, command.GetInt(0), command.GetInt(1) }).Id;
+			return true;
+		});
+
+		RegisterStatement(Statements::InsertInvite, [this](Command& command) {
+			lastInsertId = invites.Insert({ 0, command.GetInt(0), command.GetInt(1) }).Id;
+			return true;
+		});
+
+		RegisterStatement(Statements::InsertNotification, [this](Command& command) {
+			lastInsertId = notifications.Insert({ 0, command.GetInt(0), command.GetString(1) }).Id;
+			return true;
+		});
+
+		RegisterStatement(Statements::InsertMessage, [this](Command& command) {
+			MessageRow& row = messages.Insert({ 0, command.GetString(0), command.GetInt(1), command.GetInt(2) });
+
+			lastInsertId = row.Id;
+			messagesByTeam[row.TeamId].push_back(row.Id);
+			return true;
+		});
+
+		RegisterStatement(Statements::InsertAssignment, [this](Command& command) {
+			AssignmentRow row;
+			row.TeamId = command.GetInt(0);
+			row.Name = command.GetString(1);
+			row.Description = command.GetString(2);
+			row.Deadline = command.GetTimestamp(3);
+
+			lastInsertId = assignments.Insert(row).Id;
+			return true;
+		});
+
+		RegisterStatement(Statements::InsertAssignmentUser, [this](Command& command) {
+			lastInsertId = usersAssignments.Insert({ 0, command.GetInt(0), command.GetInt(1) }).Id;
+			return true;
+		});
+
+		RegisterStatement(Statements::InsertAttachment, [this](Command& command) {
+			lastInsertId = attachments.Insert({ 0, command.GetInt(0), command.GetString(1), command.GetString(2), command.GetBool(3) }).Id;
+			return true;
+		});
+
+		// Deletes
+		RegisterStatement(Statements::DeleteTeamMembers, [this](Command& command) {
+			int teamId = command.GetInt(0);
+			usersTeams.Erase([teamId](const UserTeamRow& row) { return row.TeamId == teamId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteTeamMember, [this](Command& command) {
+			int userId = command.GetInt(0);
+			int teamId = command.GetInt(1);
+			usersTeams.Erase([userId, teamId](const UserTeamRow& row) { return row.UserId == userId && row.TeamId == teamId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteTeam, [this](Command& command) {
+			int teamId = command.GetInt(0);
+			teams.Erase([teamId](const TeamRow& row) { return row.Id == teamId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteTeamMessages, [this](Command& command) {
+			int teamId = command.GetInt(0);
+			messages.Erase([teamId](const MessageRow& row) { return row.TeamId == teamId; });
+			messagesByTeam.erase(teamId);
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteInvite, [this](Command& command) {
+			int inviteId = command.GetInt(0);
+			invites.Erase([inviteId](const InviteRow& row) { return row.Id == inviteId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteUserInvites, [this](Command& command) {
+			int userId = command.GetInt(0);
+			invites.Erase([userId](const InviteRow& row) { return row.UserId == userId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteTeamInvites, [this](Command& command) {
+			int teamId = command.GetInt(0);
+			invites.Erase([teamId](const InviteRow& row) { return row.TeamId == teamId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteNotifications, [this](Command& command) {
+			int userId = command.GetInt(0);
+			notifications.Erase([userId](const NotificationRow& row) { return row.UserId == userId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteAssignment, [this](Command& command) {
+			int assignmentId = command.GetInt(0);
+			assignments.Erase([assignmentId](const AssignmentRow& row) { return row.Id == assignmentId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteAssignmentUsers, [this](Command& command) {
+			int assignmentId = command.GetInt(0);
+			usersAssignments.Erase([assignmentId](const UserAssignmentRow& row) { return row.AssignmentId == assignmentId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteAssignmentAttachments, [this](Command& command) {
+			int assignmentId = command.GetInt(0);
+			attachments.Erase([assignmentId](const AttachmentRow& row) { return row.AssignmentId == assignmentId; });
+			return true;
+		});
+
+		RegisterStatement(Statements::DeleteAttachment, [this](Command& command) {
+			int attachmentId = command.GetInt(0);
+			attachments.Erase([attachmentId](const AttachmentRow& row) { return row.Id == attachmentId; });
+			return true;
+		});
+	}
+
+	void MemoryInterface::RegisterUpdates()
+	{
+		RegisterStatement(Statements::UpdateUserName, [this](Command& command) {
+			if (UserRow* user = users.Find(command.GetInt(2)))
+			{
+				user->FirstName = command.GetString(0);
+				user->LastName = command.GetString(1);
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::UpdateUserPassword, [this](Command& command) {
+			if (UserRow* user = users.Find(command.GetInt(1)))
+				user->Password = command.GetString(0);
+			return true;
+		});
+
+		RegisterStatement(Statements::UpdateTeamName, [this](Command& command) {
+			if (TeamRow* team = teams.Find(command.GetInt(1)))
+				team->Name = command.GetString(0);
+			return true;
+		});
+
+		RegisterStatement(Statements::UpdateAssignment, [this](Command& command) {
+			if (AssignmentRow* assignment = assignments.Find(command.GetInt(3)))
+			{
+				assignment->Name = command.GetString(0);
+				assignment->Description = command.GetString(1);
+				assignment->Deadline = command.GetTimestamp(2);
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::SubmitAssignment, [this](Command& command) {
+			if (AssignmentRow* assignment = assignments.Find(command.GetInt(1)))
+			{
+				assignment->Status = "submitted";
+				assignment->SubmittedAt = command.GetTimestamp(0);
+			}
+			return true;
+		});
+
+		RegisterStatement(Statements::RateAssignment, [this](Command& command) {
+			if (AssignmentRow* assignment = assignments.Find(command.GetInt(2)))
+			{
+				assignment->Status = "rated";
+				assignment->Rating = command.GetInt(0);
+				assignment->RatingDescription = command.GetString(1);
+			}
+			return true;
+		});
+
+		// Used by attachment store moving old attachments, memory database has none of them
+		RegisterStatement(Statements::UpdateAttachment, [this](Command& command) {
+			if (AttachmentRow* attachment = attachments.Find(command.GetInt(2)))
+			{
+				attachment->FilePath = command.GetString(0);
+				attachment->FileName = command.GetString(1);
+			}
+			return true;
+		});
+	}
+}
\ No newline at end of file
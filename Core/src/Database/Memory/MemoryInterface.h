@@ -0,0 +1,57 @@
+#pragma once
+#include "Database/DatabaseInterface.h"
+#include "MemoryTables.h"
+
+namespace Core
+{
+	// Database backend without SQL engine, every statement used by applications has it's own handler working on dmp tables in memory
+	// Statements are matched by text of Statements (ignoring trailing semicolon and whitespace), unknown statements fail like SQL errors
+	// Every statement of Statements::All is checked to have handler when database is created
+	class MemoryInterface : public DatabaseInterface
+	{
+		using StatementHandler = std::function<bool(Command& command)>;
+
+		struct Statement
+		{
+			StatementHandler Handler;
+			uint32_t ParameterCount = 0;
+		};
+	public:
+		MemoryInterface();
+
+		virtual inline const bool IsConnected() const override { return true; };
+
+		virtual void Reconnect() override {}
+
+		virtual bool Execute(Command& command) override;
+		virtual bool Query(Command& command) override;
+		virtual bool Update(Command& command) override;
+		virtual void FetchData(Response& response) override;
+	private:
+		bool Run(Command& command);
+
+		void RegisterStatement(const char* statement, const StatementHandler& handler);
+		void RegisterQueries();
+		void RegisterCommands();
+		void RegisterUpdates();
+
+		std::unordered_map<std::string, Statement> statements;
+		Response result; // Rows of last query, moved to response by FetchData
+		int lastInsertId = 0;
+
+		// dmp schema
+		MemoryTable<UserRow> users;
+		MemoryTable<TeamRow> teams;
+		MemoryTable<UserTeamRow> usersTeams;
+		MemoryTable<InviteRow> invites;
+		MemoryTable<NotificationRow> notifications;
+		MemoryTable<MessageRow> messages;
+		MemoryTable<AssignmentRow> assignments;
+		MemoryTable<UserAssignmentRow> usersAssignments;
+		MemoryTable<AttachmentRow> attachments;
+
+		// Indexes of hot lookups, so query time doesn't grow with table size
+		std::unordered_map<std::string, int> usersByEmail;
+		std::unordered_map<int, std::vector<int>> messagesByTeam; // Message ids in ascending order
+	};
+}
\ No newline at end of file
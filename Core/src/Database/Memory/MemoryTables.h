@@ -0,0 +1,106 @@
+#pragma once
+
+namespace Core
+{
+	// Rows of dmp schema, columns have the same defaults as in MySQL
+	struct UserRow
+	{
+		int Id = 0;
+		std::string FirstName;
+		std::string LastName;
+		std::string Email;
+		std::string Password;
+		std::string Role = "user";
+	};
+
+	struct TeamRow
+	{
+		int Id = 0;
+		std::string Name;
+		int OwnerId = 0;
+	};
+
+	struct UserTeamRow
+	{
+		int Id = 0;
+		int UserId = 0;
+		int TeamId = 0;
+	};
+
+	struct InviteRow
+	{
+		int Id = 0;
+		int UserId = 0;
+		int TeamId = 0;
+	};
+
+	struct NotificationRow
+	{
+		int Id = 0;
+		int UserId = 0;
+		std::string Message;
+	};
+
+	struct MessageRow
+	{
+		int Id = 0;
+		std::string Content;
+		int TeamId = 0;
+		int AuthorId = 0;
+	};
+
+	struct AssignmentRow
+	{
+		int Id = 0;
+		int TeamId = 0;
+		std::string Name;
+		std::string Description;
+		std::string Status = "in_progress";
+		int Rating = 0;
+		std::string RatingDescription;
+		time_t Deadline = 0;
+		time_t SubmittedAt = 0;
+	};
+
+	struct UserAssignmentRow
+	{
+		int Id = 0;
+		int UserId = 0;
+		int AssignmentId = 0;
+	};
+
+	struct AttachmentRow
+	{
+		int Id = 0;
+		int AssignmentId = 0;
+		std::string FilePath; // Hash of content in attachment store
+		std::string FileName;
+		bool ByUser = false;
+	};
+
+	// Table with auto increment primary key, rows are ordered by id
+	template<typename Row>
+	class MemoryTable
+	{
+	public:
+		inline Row& Insert(Row row)
+		{
+			row.Id = nextId++;
+			return rows.emplace(row.Id, std::move(row)).first->second;
+		}
+
+		inline Row* Find(int id)
+		{
+			auto row = rows.find(id);
+			return row != rows.end() ? &row->second : nullptr;
+		}
+
+		template<typename Predicate>
+		inline size_t Erase(Predicate predicate) { return std::erase_if(rows, [&](auto& row) { return predicate(row.second); }); }
+
+		inline std::map<int, Row>& GetRows() { return rows; }
+	private:
+		std::map<int, Row> rows;
+		int nextId = 1;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "QueryCache.h"
+#include "StatementParser.h"
+
+namespace Core
+{
+	// Approximate memory of entry besides it's key and values
+	static constexpr size_t EntryOverhead = 128;
+
+	bool QueryCache::Get(const Command& command, Response& response)
+	{
+		if (!maxBytes)
+			return false;
+
+		auto iterator = index.find(createKey(command));
+		if (iterator == index.end())
+		{
+			misses.Add();
+			return false;
+		}
+
+		if (!isValid(*iterator->second))
+		{
+			erase(iterator->second);
+			invalidations.Add();
+			misses.Add();
+			return false;
+		}
+
+		entries.splice(entries.begin(), entries, iterator->second);
+
+		response.AppendData(iterator->second->Rows);
+
+		hits.Add();
+		return true;
+	}
+
+	void QueryCache::Add(const Command& command, Response& response)
+	{
+		if (!maxBytes)
+			return;
+
+		std::vector<std::string> tables = getTables(command.GetCommandString());
+		if (tables.empty())
+			return;
+
+		Entry entry;
+		entry.Key = createKey(command);
+		entry.Size = EntryOverhead + entry.Key.size();
+
+		for (auto& table : tables)
+		{
+			entry.Size += table.size();
+			entry.Tables.emplace_back(std::move(table), 0);
+			entry.Tables.back().second = tableGenerations[entry.Tables.back().first];
+		}
+
+		entry.Rows.AppendData(response);
+		entry.Size += entry.Rows.GetDataSize();
+
+		if (entry.Size > maxBytes / 4) // Huge results would flush everything else
+			return;
+
+		auto existing = index.find(entry.Key);
+		if (existing != index.end())
+			erase(existing->second);
+
+		while (size + entry.Size > maxBytes && !entries.empty())
+		{
+			erase(std::prev(entries.end()));
+			evictions.Add();
+		}
+
+		size += entry.Size;
+		cachedBytes.Add(entry.Size);
+		cachedEntries.Add();
+
+		entries.push_front(std::move(entry));
+		index.emplace(entries.front().Key, entries.begin());
+	}
+
+	void QueryCache::Invalidate(std::string_view table)
+	{
+		tableGenerations[StatementParser::NormalizeName(table)]++;
+	}
+
+	void QueryCache::Clear()
+	{
+		cachedBytes.Sub(size);
+		cachedEntries.Sub(entries.size());
+
+		index.clear();
+		entries.clear();
+		size = 0;
+	}
+
+	// Statement and values of parameters, separated by type bytes
+	std::string QueryCache::createKey(const Command& command)
+	{
+		std::string key = command.GetCommandString();
+
+		for (uint32_t i = 0; i < command.GetDataCount(); i++)
+		{
+			key += '\0';
+			key += (char)command.GetDataType(i);
+
+			switch (command.GetDataType(i))
+			{
+				case DatabaseDataType::String:
+					key += command.GetString(i);
+					break;
+				case DatabaseDataType::Int:
+					key += std::to_string(command.GetInt(i));
+					break;
+				case DatabaseDataType::Bool:
+					key += command.GetBool(i) ? '1' : '0';
+					break;
+				case DatabaseDataType::Timestamp:
+					key += std::to_string(command.GetTimestamp(i));
+					break;
+				default:
+					break;
+			}
+		}
+
+		return key;
+	}
+
+	// Tables read by SELECT, empty if statement is not cacheable
+	std::vector<std::string> QueryCache::getTables(const char* statement)
+	{
+		// Results depend on something else than table contents
+		std::string text = StatementParser::ToLower(statement);
+		for (const char* function : { "last_insert_id", "now(", "rand(", "current_", "uuid(" })
+		{
+			if (text.find(function) != std::string::npos)
+				return {};
+		}
+
+		return StatementParser::GetReadTables(text);
+	}
+
+	bool QueryCache::isValid(const Entry& entry) const
+	{
+		for (const auto& [table, generation] : entry.Tables)
+		{
+			auto iterator = tableGenerations.find(table);
+			if (iterator != tableGenerations.end() && iterator->second != generation)
+				return false;
+		}
+
+		return true;
+	}
+
+	void QueryCache::erase(std::list<Entry>::iterator entry)
+	{
+		size -= entry->Size;
+		cachedBytes.Sub(entry->Size);
+		cachedEntries.Sub();
+
+		index.erase(entry->Key);
+		entries.erase(entry);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <list>
+#include "Command.h"
+#include "Response.h"
+#include "Debugging/Metrics.h"
+
+namespace Core
+{
+	// Results of SELECT statements keyed by statement and bound parameters, least recently used are evicted over byte budget
+	// Entry remembers generation of every table it reads (FROM, JOIN), writing table increments generation, so it's stale on next lookup
+	// Cache has to be used from one thread (server's update loop)
+	class QueryCache
+	{
+	public:
+		QueryCache(size_t MaxBytes) : maxBytes(MaxBytes) {}
+
+		// Fills response with cached rows, returns false on miss
+		bool Get(const Command& command, Response& response);
+		void Add(const Command& command, Response& response);
+
+		// Table name as detected from INSERT, UPDATE or DELETE statement
+		void Invalidate(std::string_view table);
+		void Clear();
+
+		inline const bool IsEnabled() const { return maxBytes; }
+		inline const size_t GetSize() const { return size; }
+		inline const size_t GetCount() const { return entries.size(); }
+	private:
+		struct Entry
+		{
+			std::string Key;
+			std::vector<std::pair<std::string, uint64_t>> Tables; // Name and generation at time of query
+			Response Rows;
+			size_t Size = 0;
+		};
+
+		static std::string createKey(const Command& command);
+		static std::vector<std::string> getTables(const char* statement);
+
+		bool isValid(const Entry& entry) const;
+		void erase(std::list<Entry>::iterator entry);
+
+		size_t maxBytes;
+		size_t size = 0;
+
+		std::list<Entry> entries; // Most recently used first
+		std::unordered_map<std::string_view, std::list<Entry>::iterator> index; // Keys point to Entry::Key
+		std::unordered_map<std::string, uint64_t> tableGenerations;
+
+		Counter hits = Metrics::GetCounter("query_cache_hits_total");
+		Counter misses = Metrics::GetCounter("query_cache_misses_total");
+		Counter invalidations = Metrics::GetCounter("query_cache_invalidations_total"); // Stale entries dropped on lookup
+		Counter evictions = Metrics::GetCounter("query_cache_evictions_total");
+		Gauge cachedBytes = Metrics::GetGauge("query_cache_bytes");
+		Gauge cachedEntries = Metrics::GetGauge("query_cache_entries");
+	};
+}
\ No newline at end of file
@@ -2,15 +2,20 @@
 #include "SQLInterface.h"
 #include "Debugging/Log.h"
 #include "Core/Application.h"
+#include "Debugging/Metrics.h"
+#include "Debugging/Tracing.h"
+#include "Database/Timestamp.h"
 
 #include <jdbc/cppconn/exception.h>
+#include <jdbc/cppconn/datatype.h>
 
 namespace Core
 {
-	Ref<DatabaseInterface> DatabaseInterface::Create(const char* address, const char* databaseName, const char* username, const char* password)
-	{
-		return new SQLInterface(address, databaseName, username, password);
-	}
+	static Histogram executeDuration = Metrics::GetHistogram("db_duration_us{operation=\"execute\"}");
+	static Histogram queryDuration = Metrics::GetHistogram("db_duration_us{operation=\"query\"}");
+	static Histogram updateDuration = Metrics::GetHistogram("db_duration_us{operation=\"update\"}");
+	static Histogram fetchDuration = Metrics::GetHistogram("db_duration_us{operation=\"fetch\"}");
+	static Counter errors = Metrics::GetCounter("db_errors_total");
 
 	SQLInterface::SQLInterface(const char* address, const char* databaseName, const char* username, const char* password) : database(databaseName)
 	{
@@ -18,7 +23,7 @@ namespace Core
 		{
 			driver = get_driver_instance();
 			connection = driver->connect(address, username, password);
-			connection->setSchema(database);
+			connection->setSchema(database.c_str());
 			connection->setClientOption("CHARSET", "utf8mb4");
 
 			INFO("Database connected!");
@@ -38,7 +43,7 @@ namespace Core
 
 		if (connection->reconnect())
 		{
-			connection->setSchema(database);
+			connection->setSchema(database.c_str());
 			connection->setClientOption("CHARSET", "utf8mb4");
 
 			INFO("Database connected!");
@@ -47,116 +52,168 @@ namespace Core
 
 	bool SQLInterface::Execute(Command& command)
 	{
+		ScopedTimer timer(executeDuration);
+
 		try
 		{
-			statement = connection->prepareStatement(command.GetCommandString());
-			loadValues(command);
+			prepare(command);
+
+			Span span("sql.execute");
 			statement->execute();
 			return true;
 		}
 		catch (const sql::SQLException& e)
 		{
 			ERROR("SQL statement error: {0}, {1}", e.getSQLStateCStr(), e.getErrorCode());
+			errors.Add();
 			return false;
 		}
 	}
 
 	bool SQLInterface::Query(Command& command)
 	{
+		ScopedTimer timer(queryDuration);
+
 		try
 		{
-			statement = connection->prepareStatement(command.GetCommandString());
-			loadValues(command);
+			prepare(command);
+
+			Span span("sql.query");
 			result = statement->executeQuery();
 			return true;
 		}
 		catch (const sql::SQLException& e)
 		{
 			ERROR("SQL query error: {0}, {1}", e.getSQLStateCStr(), e.getErrorCode());
+			errors.Add();
 			return false;
 		}
 	}
 
 	bool SQLInterface::Update(Command& command)
 	{
+		ScopedTimer timer(updateDuration);
+
 		try
 		{
-			statement = connection->prepareStatement(command.GetCommandString());
-			loadValues(command);
+			prepare(command);
+
+			Span span("sql.update");
 			statement->executeUpdate();
 			return true;
 		}
 		catch (const sql::SQLException& e)
 		{
 			ERROR("SQL update error: {0}, {1}", e.getSQLStateCStr(), e.getErrorCode());
+			errors.Add();
 			return false;
 		}
 	}
 
 	void SQLInterface::FetchData(Response& response)
 	{
+		ScopedTimer timer(fetchDuration);
+		Span span("sql.fetch");
+
+		// Decoder of every column is resolved once per result set and not for every cell
 		auto metadata = result->getMetaData();
+		uint32_t columnCount = metadata->getColumnCount();
+
+		std::vector<DatabaseDataType> columns(columnCount);
+		for (uint32_t i = 0; i < columnCount; i++)
+		{
+			int type = metadata->getColumnType(i + 1);
+			columns[i] = getColumnType(type);
+
+			if (columns[i] == DatabaseDataType::None)
+				ERROR("Unknown SQL data type {0}!", type);
+		}
+
+		// Results of prepared statements are buffered, so row count is known
+		response.Reserve(result->rowsCount() * columnCount);
 
-		uint32_t i = 1;
 		while (result->next())
 		{
-			for (uint32_t i = 0; i < metadata->getColumnCount(); i++)
+			for (uint32_t i = 0; i < columnCount; i++)
 			{
-				// auto typeName = metadata->getColumnTypeName(i + 1); // to figure out name of the type
-				int type = metadata->getColumnType(i + 1);
-
-				switch (type)
+				switch (columns[i])
 				{
-				case 2: // bool
-					response.AddData(new DatabaseBool(result->getBoolean(i + 1)));
+				case DatabaseDataType::Bool:
+					response.AddBool(result->getBoolean(i + 1));
 					break;
-				case 5:
-				case 6: // int
-					response.AddData(new DatabaseInt(result->getInt(i + 1)));
+				case DatabaseDataType::Int:
+					response.AddInt(result->getInt(i + 1));
 					break;
-				case 13: // string
-				case 15: // text
-				case 22: // enum
-					response.AddData(new DatabaseString(result->getString(i + 1).c_str()));
+				case DatabaseDataType::String:
+				{
+					sql::SQLString text = result->getString(i + 1);
+					response.AddString(std::string_view(text.c_str(), text.length()));
 					break;
-				case 17: // timestamp
+				}
+				case DatabaseDataType::Timestamp:
 				{
-					std::istringstream res(result->getString(i + 1).c_str());
-					std::tm time = {};
-					res >> std::get_time(&time, "%Y-%m-%d %H:%M:%S");
-
-					response.AddData(new DatabaseTimestamp(mktime(&time)));
+					sql::SQLString text = result->getString(i + 1);
+					response.AddTimestamp(ParseTimestamp(text.c_str(), text.length()));
 					break;
 				}
 				default:
-					ERROR("Unknown SQL data type {0}!", type);
 					break;
 				}
 			}
+		}
+	}
 
-			i++;
+	DatabaseDataType SQLInterface::getColumnType(int type)
+	{
+		switch (type)
+		{
+		case sql::DataType::TINYINT: // bool is stored as tinyint(1)
+			return DatabaseDataType::Bool;
+		case sql::DataType::SMALLINT:
+		case sql::DataType::MEDIUMINT:
+		case sql::DataType::INTEGER:
+		case sql::DataType::BIGINT:
+			return DatabaseDataType::Int;
+		case sql::DataType::CHAR:
+		case sql::DataType::VARCHAR:
+		case sql::DataType::LONGVARCHAR: // text
+		case sql::DataType::ENUM:
+			return DatabaseDataType::String;
+		case sql::DataType::TIMESTAMP:
+			return DatabaseDataType::Timestamp;
+		default:
+			return DatabaseDataType::None;
 		}
 	}
 
+	void SQLInterface::prepare(Command& command)
+	{
+		Span span("sql.prepare");
+
+		statement = connection->prepareStatement(command.GetCommandString());
+		loadValues(command);
+	}
+
 	void SQLInterface::loadValues(Command& command)
 	{
 		for (uint32_t i = 0; i < command.GetDataCount(); i++)
 		{
-			switch (command[i].GetType())
+			switch (command.GetDataType(i))
 			{
 			case DatabaseDataType::Int:
-				statement->setInt(i + 1, *(int*)command[i].GetValue());
+				statement->setInt(i + 1, command.GetInt(i));
 				break;
 			case DatabaseDataType::String:
-				statement->setString(i + 1, (const char*)command[i].GetValue());
+				statement->setString(i + 1, command.GetString(i));
 				break;
 			case DatabaseDataType::Bool:
-				statement->setBoolean(i + 1, *(bool*)command[i].GetValue());
+				statement->setBoolean(i + 1, command.GetBool(i));
 				break;
 			case DatabaseDataType::Timestamp:
 				// Convert time to string
 				char buffer[20] = {};
-				std::tm* timeInfo = std::localtime((time_t*)command[i].GetValue());
+				time_t time = command.GetTimestamp(i);
+				std::tm* timeInfo = std::localtime(&time);
 				strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeInfo);
 
 				statement->setDateTime(i + 1, buffer);
@@ -21,13 +21,16 @@ namespace Core
 		virtual bool Update(Command& command) override;
 		virtual void FetchData(Response& response) override;
 	private:
+		void prepare(Command& command);
 		void loadValues(Command& command);
 
+		static DatabaseDataType getColumnType(int type);
+
 		sql::Driver* driver;
 		Ref<sql::Connection> connection;
 		Ref<sql::PreparedStatement> statement;
 		Ref<sql::ResultSet> result;
 
-		const char* database;
+		std::string database;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "pch.h"
+#ifdef DATABASE_SQLITE
+#include "SQLiteInterface.h"
+#include "Debugging/Log.h"
+#include "Debugging/Metrics.h"
+#include "Debugging/Tracing.h"
+#include "Database/Timestamp.h"
+
+namespace Core
+{
+	// Same metrics as MySQL backend
+	static Histogram executeDuration = Metrics::GetHistogram("db_duration_us{operation=\"execute\"}");
+	static Histogram queryDuration = Metrics::GetHistogram("db_duration_us{operation=\"query\"}");
+	static Histogram updateDuration = Metrics::GetHistogram("db_duration_us{operation=\"update\"}");
+	static Histogram fetchDuration = Metrics::GetHistogram("db_duration_us{operation=\"fetch\"}");
+	static Counter errors = Metrics::GetCounter("db_errors_total");
+
+	// dmp schema, types are chosen so declared column types can be mapped to database data types
+	static const char* schema = R"(
+		CREATE TABLE IF NOT EXISTS users (id INTEGER PRIMARY KEY AUTOINCREMENT, first_name TEXT NOT NULL, last_name TEXT NOT NULL, email TEXT NOT NULL UNIQUE, password TEXT NOT NULL, role TEXT NOT NULL DEFAULT 'user');
+		CREATE TABLE IF NOT EXISTS teams (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT NOT NULL, owner_id INTEGER NOT NULL);
+		CREATE TABLE IF NOT EXISTS users_teams (id INTEGER PRIMARY KEY AUTOINCREMENT, user_id INTEGER NOT NULL, team_id INTEGER NOT NULL);
+		CREATE TABLE IF NOT EXISTS invites (id INTEGER PRIMARY KEY AUTOINCREMENT, user_id INTEGER NOT NULL, team_id INTEGER NOT NULL);
+		CREATE TABLE IF NOT EXISTS notifications (id INTEGER PRIMARY KEY AUTOINCREMENT, user_id INTEGER NOT NULL, message TEXT NOT NULL);
+		CREATE TABLE IF NOT EXISTS messages (id INTEGER PRIMARY KEY AUTOINCREMENT, content TEXT NOT NULL, team_id INTEGER NOT NULL, author_id INTEGER NOT NULL);
+		CREATE TABLE IF NOT EXISTS assignments (id INTEGER PRIMARY KEY AUTOINCREMENT, team_id INTEGER NOT NULL, name TEXT NOT NULL, description TEXT NOT NULL, status TEXT NOT NULL DEFAULT 'in_progress', rating INTEGER NOT NULL DEFAULT 0, rating_description TEXT NOT NULL DEFAULT '', deadline TIMESTAMP, submitted_at TIMESTAMP);
+		CREATE TABLE IF NOT EXISTS users_assignments (id INTEGER PRIMARY KEY AUTOINCREMENT, user_id INTEGER NOT NULL, assignment_id INTEGER NOT NULL);
+		CREATE TABLE IF NOT EXISTS attachments (id INTEGER PRIMARY KEY AUTOINCREMENT, assignment_id INTEGER NOT NULL, file_path TEXT NOT NULL, file_name TEXT NOT NULL DEFAULT '', by_user BOOLEAN NOT NULL DEFAULT 0);
+
+		CREATE INDEX IF NOT EXISTS users_teams_user ON users_teams (user_id);
+		CREATE INDEX IF NOT EXISTS users_teams_team ON users_teams (team_id);
+		CREATE INDEX IF NOT EXISTS messages_team ON messages (team_id, id);
+		CREATE INDEX IF NOT EXISTS users_assignments_user ON users_assignments (user_id);
+		CREATE INDEX IF NOT EXISTS users_assignments_assignment ON users_assignments (assignment_id);
+		CREATE INDEX IF NOT EXISTS attachments_assignment ON attachments (assignment_id);
+	)";
+
+	// Translates MySQL specific parts of statements
+	static std::string TranslateStatement(const char* statement)
+	{
+		std::string translated = statement;
+
+		size_t position = translated.find("LAST_INSERT_ID()");
+		if (position != std::string::npos)
+			translated.replace(position, strlen("LAST_INSERT_ID()"), "last_insert_rowid()");
+
+		return translated;
+	}
+
+	SQLiteInterface::SQLiteInterface(const char* filePath) : path(filePath)
+	{
+		Open();
+	}
+
+	SQLiteInterface::~SQLiteInterface()
+	{
+		Close();
+	}
+
+	void SQLiteInterface::Open()
+	{
+		if (sqlite3_open_v2(path.c_str(), &database, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK)
+		{
+			ERROR("SQLite database {0} could not be opened: {1}", path, sqlite3_errmsg(database));
+			Close();
+			return;
+		}
+
+		// Server is the only writer, WAL without fsync on every commit is enough
+		char* error = nullptr;
+		if (sqlite3_exec(database, "PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;", nullptr, nullptr, &error) != SQLITE_OK ||
+			sqlite3_exec(database, schema, nullptr, nullptr, &error) != SQLITE_OK ||
+			!Migrate(&error))
+		{
+			ERROR("SQLite database {0} could not be initialized: {1}", path, (const char*)error);
+			sqlite3_free(error);
+			Close();
+			return;
+		}
+
+		INFO("SQLite database {0} opened!", path);
+	}
+
+	// Adds columns missing in database files created with older schema
+	bool SQLiteInterface::Migrate(char** error)
+	{
+		// Attachments were stored by display name before attachment store
+		sqlite3_stmt* statement = nullptr;
+		bool hasFileName = sqlite3_prepare_v2(database, "SELECT file_name FROM attachments LIMIT 0;", -1, &statement, nullptr) == SQLITE_OK;
+		sqlite3_finalize(statement);
+
+		if (!hasFileName && sqlite3_exec(database, "ALTER TABLE attachments ADD COLUMN file_name TEXT NOT NULL DEFAULT '';", nullptr, nullptr, error) != SQLITE_OK)
+			return false;
+
+		return true;
+	}
+
+	void SQLiteInterface::Close()
+	{
+		for (auto& [text, statement] : statements)
+			sqlite3_finalize(statement);
+
+		statements.clear();
+		result = nullptr;
+
+		sqlite3_close(database);
+		database = nullptr;
+	}
+
+	void SQLiteInterface::Reconnect()
+	{
+		ERROR("SQLite database closed, reopening!");
+
+		Close();
+		Open();
+	}
+
+	bool SQLiteInterface::Execute(Command& command)
+	{
+		ScopedTimer timer(executeDuration);
+		Span span("sql.execute");
+		return Run(command);
+	}
+
+	bool SQLiteInterface::Query(Command& command)
+	{
+		ScopedTimer timer(queryDuration);
+		Span span("sql.query");
+
+		if (result)
+			sqlite3_reset(result);
+
+		// Rows are stepped by FetchData
+		result = Prepare(command);
+		return result;
+	}
+
+	bool SQLiteInterface::Update(Command& command)
+	{
+		ScopedTimer timer(updateDuration);
+		Span span("sql.update");
+		return Run(command);
+	}
+
+	void SQLiteInterface::FetchData(Response& response)
+	{
+		if (!result)
+			return;
+
+		ScopedTimer timer(fetchDuration);
+		Span span("sql.fetch");
+
+		// Declared types are resolved once per result set, expressions (last_insert_rowid()) don't have any and are decided by value
+		int columnCount = sqlite3_column_count(result);
+		std::vector<DatabaseDataType> columns(columnCount, DatabaseDataType::None);
+		for (int i = 0; i < columnCount; i++)
+		{
+			const char* declaredType = sqlite3_column_decltype(result, i);
+			if (!declaredType)
+				continue;
+
+			if (!strcmp(declaredType, "TEXT"))
+				columns[i] = DatabaseDataType::String;
+			else if (!strcmp(declaredType, "BOOLEAN"))
+				columns[i] = DatabaseDataType::Bool;
+			else if (!strcmp(declaredType, "TIMESTAMP"))
+				columns[i] = DatabaseDataType::Timestamp;
+			else
+				columns[i] = DatabaseDataType::Int;
+		}
+
+		int step;
+		while ((step = sqlite3_step(result)) == SQLITE_ROW)
+		{
+			for (int i = 0; i < columnCount; i++)
+			{
+				DatabaseDataType type = columns[i];
+				if (type == DatabaseDataType::None)
+					type = sqlite3_column_type(result, i) == SQLITE_TEXT ? DatabaseDataType::String : DatabaseDataType::Int;
+
+				switch (type)
+				{
+				case DatabaseDataType::Int:
+					response.AddInt(sqlite3_column_int(result, i));
+					break;
+				case DatabaseDataType::Bool:
+					response.AddBool(sqlite3_column_int(result, i));
+					break;
+				case DatabaseDataType::String:
+				{
+					const unsigned char* text = sqlite3_column_text(result, i);
+					response.AddString(text ? std::string_view((const char*)text, sqlite3_column_bytes(result, i)) : "");
+					break;
+				}
+				case DatabaseDataType::Timestamp:
+				{
+					// Stored in the same format as MySQL returns it
+					const unsigned char* text = sqlite3_column_text(result, i);
+					response.AddTimestamp(text ? ParseTimestamp((const char*)text, sqlite3_column_bytes(result, i)) : 0);
+					break;
+				}
+				default:
+					break;
+				}
+			}
+		}
+
+		if (step != SQLITE_DONE)
+		{
+			ERROR("SQLite query error: {0}", sqlite3_errmsg(database));
+			errors.Add();
+		}
+
+		sqlite3_reset(result);
+		result = nullptr;
+	}
+
+	sqlite3_stmt* SQLiteInterface::Prepare(Command& command)
+	{
+		if (!database)
+			return nullptr;
+
+		Span span("sql.prepare");
+
+		// Statements are compiled once, applications send only fixed set of them
+		std::string text = TranslateStatement(command.GetCommandString());
+		sqlite3_stmt*& statement = statements[text];
+
+		if (!statement && sqlite3_prepare_v3(database, text.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &statement, nullptr) != SQLITE_OK)
+		{
+			ERROR("SQLite statement error: {0}, {1}", sqlite3_errmsg(database), command.GetCommandString());
+			errors.Add();
+			statements.erase(text);
+			return nullptr;
+		}
+
+		sqlite3_reset(statement);
+		sqlite3_clear_bindings(statement);
+		LoadValues(statement, command);
+
+		return statement;
+	}
+
+	bool SQLiteInterface::Run(Command& command)
+	{
+		sqlite3_stmt* statement = Prepare(command);
+		if (!statement)
+			return false;
+
+		int step = sqlite3_step(statement);
+		sqlite3_reset(statement);
+
+		if (step != SQLITE_DONE && step != SQLITE_ROW)
+		{
+			ERROR("SQLite statement error: {0}, {1}", sqlite3_errmsg(database), step);
+			errors.Add();
+			return false;
+		}
+
+		return true;
+	}
+
+	void SQLiteInterface::LoadValues(sqlite3_stmt* statement, Command& command)
+	{
+		for (uint32_t i = 0; i < command.GetDataCount(); i++)
+		{
+			switch (command.GetDataType(i))
+			{
+			case DatabaseDataType::Int:
+				sqlite3_bind_int(statement, i + 1, command.GetInt(i));
+				break;
+			case DatabaseDataType::String:
+				sqlite3_bind_text(statement, i + 1, command.GetString(i), -1, SQLITE_TRANSIENT);
+				break;
+			case DatabaseDataType::Bool:
+				sqlite3_bind_int(statement, i + 1, command.GetBool(i));
+				break;
+			case DatabaseDataType::Timestamp:
+			{
+				// Convert time to string
+				char buffer[20] = {};
+				time_t time = command.GetTimestamp(i);
+				std::tm* timeInfo = std::localtime(&time);
+				strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeInfo);
+
+				sqlite3_bind_text(statement, i + 1, buffer, -1, SQLITE_TRANSIENT);
+				break;
+			}
+			default:
+				ERROR("Unsupported SQLite parameter type {0}, NULL is bound instead!", (uint32_t)command.GetDataType(i));
+				sqlite3_bind_null(statement, i + 1);
+				break;
+			}
+		}
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+#ifdef DATABASE_SQLITE
+#include "Database/DatabaseInterface.h"
+#include <sqlite3.h>
+
+namespace Core
+{
+	// Embedded database backend, dmp schema is created in database file if it doesn't exist yet
+	class SQLiteInterface : public DatabaseInterface
+	{
+	public:
+		SQLiteInterface(const char* filePath);
+		~SQLiteInterface();
+
+		virtual inline const bool IsConnected() const override { return database; };
+
+		virtual void Reconnect() override;
+
+		virtual bool Execute(Command& command) override;
+		virtual bool Query(Command& command) override;
+		virtual bool Update(Command& command) override;
+		virtual void FetchData(Response& response) override;
+	private:
+		void Open();
+		void Close();
+		bool Migrate(char** error);
+
+		// Returns cached prepared statement with bound values
+		sqlite3_stmt* Prepare(Command& command);
+		bool Run(Command& command);
+		void LoadValues(sqlite3_stmt* statement, Command& command);
+
+		sqlite3* database = nullptr;
+		std::unordered_map<std::string, sqlite3_stmt*> statements;
+		sqlite3_stmt* result = nullptr;
+
+		std::string path;
+	};
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "pch.h"
+#include "StatementParser.h"
+
+namespace Core
+{
+	static inline bool isIdentifier(char c) { return std::isalnum((unsigned char)c) || c == '_'; }
+
+	std::string StatementParser::ToLower(std::string_view text)
+	{
+		std::string result(text);
+		std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return result;
+	}
+
+	std::string StatementParser::NormalizeName(std::string_view name)
+	{
+		size_t dot = name.rfind('.');
+		if (dot != std::string_view::npos)
+			name.remove_prefix(dot + 1);
+
+		std::string result = ToLower(name);
+		result.erase(std::remove_if(result.begin(), result.end(), [](char c) { return !isIdentifier(c); }), result.end());
+
+		return result;
+	}
+
+	std::string StatementParser::GetWrittenTable(std::string_view statement)
+	{
+		std::istringstream words(ToLower(statement));
+		std::string type, word, table;
+		words >> type;
+
+		if (type == "insert" || type == "delete")
+			words >> word >> table; // INTO or FROM
+		else if (type == "update")
+			words >> table;
+		else
+			return {};
+
+		// Column list can follow table name without space
+		return NormalizeName(table.substr(0, table.find('(')));
+	}
+
+	std::vector<std::string> StatementParser::GetReadTables(std::string_view statement)
+	{
+		std::string text = ToLower(statement);
+		if (!text.starts_with("select"))
+			return {};
+
+		std::vector<std::string> tables;
+
+		std::istringstream words(text);
+		std::string word;
+		bool tableExpected = false;
+		while (words >> word)
+		{
+			if (word == "from" || word == "join")
+			{
+				tableExpected = true;
+				continue;
+			}
+
+			if (!tableExpected)
+				continue;
+
+			// Subquery, it's tables follow it's own FROM
+			if (word.starts_with("("))
+			{
+				tableExpected = false;
+				continue;
+			}
+
+			bool listContinues = word.ends_with(",");
+
+			std::string table = NormalizeName(word);
+			if (!table.empty() && std::find(tables.begin(), tables.end(), table) == tables.end())
+				tables.push_back(table);
+
+			tableExpected = listContinues;
+		}
+
+		return tables;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace Core
+{
+	// Reads tables from SQL statement text, shared by query cache, change log and server's update broadcasts
+	// Statements are not validated, only words following FROM, JOIN, INTO and UPDATE are looked at
+	class StatementParser
+	{
+		StatementParser() = delete;
+	public:
+		static std::string ToLower(std::string_view text);
+
+		// Lower case name without quotes, punctuation and table or database prefix
+		static std::string NormalizeName(std::string_view name);
+
+		// Table written by INSERT, UPDATE or DELETE, empty for other statements
+		static std::string GetWrittenTable(std::string_view statement);
+		// Tables following FROM and JOIN (also comma separated) of SELECT, empty for other statements
+		static std::vector<std::string> GetReadTables(std::string_view statement);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+namespace Core
+{
+	// Every statement applications send to database, shared by Client, LoadGen, Server and memory backend
+	// Memory backend finds handler of statement by it's text, so statements are written only here and used by name
+	namespace Statements
+	{
+		inline constexpr const char* LastInsertId = "SELECT LAST_INSERT_ID();";
+
+		// Users
+		inline constexpr const char* SelectLogin = "SELECT id, password, first_name, last_name, email, role FROM users WHERE email = ?;";
+		inline constexpr const char* SelectUserIdByEmail = "SELECT id, email FROM users WHERE email = ?;";
+		inline constexpr const char* SelectUser = "SELECT first_name, last_name, email, role FROM users WHERE id = ?;";
+		inline constexpr const char* InsertUser = "INSERT INTO users (first_name, last_name, email, password) VALUES (?, ?, ?, ?);";
+		inline constexpr const char* UpdateUserName = "UPDATE users set first_name = ?, last_name = ? WHERE id = ?;";
+		inline constexpr const char* UpdateUserPassword = "UPDATE users set password = ? WHERE id = ?;";
+
+		// Teams
+		inline constexpr const char* SelectUserTeams = "SELECT teams.id, teams.owner_id, teams.name FROM users_teams JOIN teams ON users_teams.team_id = teams.id WHERE users_teams.user_id = ?;";
+		inline constexpr const char* SelectTeamMembers = "SELECT users.id, users.first_name, users.last_name FROM users_teams JOIN users ON users_teams.user_id = users.id WHERE users_teams.team_id = ?;";
+		inline constexpr const char* SelectTeamMember = "SELECT user_id FROM users_teams WHERE team_id = ? AND user_id = ?;";
+		inline constexpr const char* InsertTeam = "INSERT INTO teams (name, owner_id) VALUES (?, ?);";
+		inline constexpr const char* InsertTeamMember = "INSERT INTO users_teams (user_id, team_id) VALUES (?, ?);";
+		inline constexpr const char* UpdateTeamName = "UPDATE teams set name = ? WHERE id = ?;";
+		inline constexpr const char* DeleteTeam = "DELETE FROM teams WHERE id = ?;";
+		inline constexpr const char* DeleteTeamMember = "DELETE FROM users_teams WHERE user_id = ? AND team_id = ?;";
+		inline constexpr const char* DeleteTeamMembers = "DELETE FROM users_teams WHERE team_id = ?;";
+
+		// Messages
+		inline constexpr const char* SelectTeamMessages = "SELECT * FROM (SELECT messages.id, messages.content, users.first_name, users.last_name, messages.author_id FROM messages JOIN users ON messages.author_id = users.id WHERE messages.team_id = ? ORDER BY messages.id DESC LIMIT 40) AS subquery ORDER BY subquery.id ASC;";
+		inline constexpr const char* SelectTeamMessagesAfter = "SELECT * FROM (SELECT messages.id, messages.content, users.first_name, users.last_name, messages.author_id FROM messages JOIN users ON messages.author_id = users.id WHERE messages.team_id = ? AND messages.id > ? ORDER BY messages.id DESC LIMIT 40) AS subquery ORDER BY subquery.id ASC;";
+		inline constexpr const char* InsertMessage = "INSERT INTO messages (content, team_id, author_id) VALUES (?, ?, ?)";
+		inline constexpr const char* DeleteTeamMessages = "DELETE FROM messages WHERE team_id = ?;";
+
+		// Invites and notifications
+		inline constexpr const char* SelectUserInvites = "SELECT invites.id, teams.id, teams.name FROM invites JOIN teams ON invites.team_id = teams.id WHERE invites.user_id = ?;";
+		inline constexpr const char* SelectInvite = "SELECT user_id FROM invites WHERE team_id = ? AND user_id = ?;";
+		inline constexpr const char* InsertInvite = "INSERT INTO invites (user_id, team_id) VALUES (?, ?);";
+		inline constexpr const char* DeleteInvite = "DELETE FROM invites WHERE id = ?;";
+		inline constexpr const char* DeleteUserInvites = "DELETE FROM invites WHERE user_id = ?;";
+		inline constexpr const char* DeleteTeamInvites = "DELETE FROM invites WHERE team_id = ?;";
+		inline constexpr const char* SelectNotifications = "SELECT id, message FROM notifications WHERE user_id = ? ORDER BY id DESC;";
+		inline constexpr const char* InsertNotification = "INSERT INTO notifications (user_id, message) VALUES (?, ?);";
+		inline constexpr const char* DeleteNotifications = "DELETE FROM notifications WHERE user_id = ?;";
+
+		// Assignments
+		inline constexpr const char* SelectUserAssignments = "SELECT assignments.id, assignments.name, assignments.description, assignments.status, assignments.rating, assignments.rating_description, assignments.deadline, assignments.submitted_at FROM users_assignments JOIN assignments ON users_assignments.assignment_id = assignments.id WHERE users_assignments.user_id = ? AND assignments.team_id = ? ORDER BY deadline LIMIT 200;";
+		inline constexpr const char* SelectTeamAssignments = "SELECT id, name, description, status, rating, rating_description, deadline, submitted_at FROM assignments WHERE team_id = ? ORDER BY deadline LIMIT 200";
+		inline constexpr const char* SelectAssignmentUsers = "SELECT assignment_id, users.id, users.first_name, users.last_name FROM users_assignments JOIN users ON users_assignments.user_id = users.id WHERE users_assignments.assignment_id = ?;";
+		inline constexpr const char* InsertAssignment = "INSERT INTO assignments (team_id, name, description, deadline) VALUES (?, ?, ?, ?);";
+		inline constexpr const char* InsertAssignmentUser = "INSERT INTO users_assignments (user_id, assignment_id) VALUES (?, ?);";
+		inline constexpr const char* UpdateAssignment = "UPDATE assignments set name = ?, description = ?, deadline = ? WHERE id = ?;";
+		inline constexpr const char* SubmitAssignment = "UPDATE assignments set status = 'submitted', submitted_at = ? WHERE id = ?;";
+		inline constexpr const char* RateAssignment = "UPDATE assignments set status = 'rated', rating = ?, rating_description = ? WHERE id = ?;";
+		inline constexpr const char* DeleteAssignment = "DELETE FROM assignments WHERE id = ?;";
+		inline constexpr const char* DeleteAssignmentUsers = "DELETE FROM users_assignments WHERE assignment_id = ?;";
+
+		// Attachments, file_path is hash of content in attachment store
+		inline constexpr const char* SelectAssignmentAttachments = "SELECT id, file_name, by_user FROM attachments WHERE assignment_id = ?;";
+		inline constexpr const char* SelectAttachmentFile = "SELECT file_path, file_name FROM attachments WHERE id = ?;";
+		inline constexpr const char* SelectAttachmentContents = "SELECT id, file_path FROM attachments;";
+		inline constexpr const char* SelectAttachmentContent = "SELECT file_path FROM attachments WHERE id = ?;";
+		inline constexpr const char* SelectAssignmentAttachmentContents = "SELECT file_path FROM attachments WHERE assignment_id = ?;";
+		inline constexpr const char* InsertAttachment = "INSERT INTO attachments (assignment_id, file_path, file_name, by_user) VALUES (?, ?, ?, ?);";
+		inline constexpr const char* UpdateAttachment = "UPDATE attachments SET file_path = ?, file_name = ? WHERE id = ?;";
+		inline constexpr const char* DeleteAttachment = "DELETE FROM attachments WHERE id = ?;";
+		inline constexpr const char* DeleteAssignmentAttachments = "DELETE FROM attachments WHERE assignment_id = ?;";
+
+		// Memory backend checks it has handler for each of them
+		inline constexpr const char* All[] = {
+			LastInsertId,
+			SelectLogin, SelectUserIdByEmail, SelectUser, InsertUser, UpdateUserName, UpdateUserPassword,
+			SelectUserTeams, SelectTeamMembers, SelectTeamMember, InsertTeam, InsertTeamMember, UpdateTeamName, DeleteTeam, DeleteTeamMember, DeleteTeamMembers,
+			SelectTeamMessages, SelectTeamMessagesAfter, InsertMessage, DeleteTeamMessages,
+			SelectUserInvites, SelectInvite, InsertInvite, DeleteInvite, DeleteUserInvites, DeleteTeamInvites, SelectNotifications, InsertNotification, DeleteNotifications,
+			SelectUserAssignments, SelectTeamAssignments, SelectAssignmentUsers, InsertAssignment, InsertAssignmentUser, UpdateAssignment, SubmitAssignment, RateAssignment, DeleteAssignment, DeleteAssignmentUsers,
+			SelectAssignmentAttachments, SelectAttachmentFile, SelectAttachmentContents, SelectAttachmentContent, SelectAssignmentAttachmentContents, InsertAttachment, UpdateAttachment, DeleteAttachment, DeleteAssignmentAttachments,
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+namespace Core
+{
+	namespace Detail
+	{
+		// Days since 1970-01-01 of proleptic Gregorian date
+		constexpr int64_t DaysFromCivil(int64_t year, uint32_t month, uint32_t day)
+		{
+			year -= month <= 2;
+			int64_t era = (year >= 0 ? year : year - 399) / 400;
+			uint32_t yearOfEra = (uint32_t)(year - era * 400);
+			uint32_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+			uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+			return era * 146097 + (int64_t)dayOfEra - 719468;
+		}
+
+		inline bool ParseDigits(const char* text, uint32_t count, uint32_t& value)
+		{
+			value = 0;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (text[i] < '0' || text[i] > '9')
+					return false;
+
+				value = value * 10 + (text[i] - '0');
+			}
+
+			return true;
+		}
+	}
+
+	// Parses "YYYY-MM-DD HH:MM:SS" as local time, the same result as mktime of get_time with zeroed tm, 0 if text doesn't match
+	// Offset of local time is looked up with mktime only once per hour of timestamps, so rows with many dates don't lock time zone data for every cell
+	inline time_t ParseTimestamp(const char* text, size_t length)
+	{
+		uint32_t year, month, day, hour, minute, second;
+		if (length < 19 || text[4] != '-' || text[7] != '-' || text[13] != ':' || text[16] != ':' ||
+			!Detail::ParseDigits(text, 4, year) || !Detail::ParseDigits(text + 5, 2, month) || !Detail::ParseDigits(text + 8, 2, day) ||
+			!Detail::ParseDigits(text + 11, 2, hour) || !Detail::ParseDigits(text + 14, 2, minute) || !Detail::ParseDigits(text + 17, 2, second))
+			return 0;
+
+		if (!month || month > 12 || !day || day > 31 || hour > 23 || minute > 59 || second > 60)
+			return 0;
+
+		int64_t hourKey = Detail::DaysFromCivil(year, month, day) * 24 + hour;
+
+		static thread_local std::unordered_map<int64_t, int64_t> offsets;
+		auto iterator = offsets.find(hourKey);
+		if (iterator == offsets.end())
+		{
+			if (offsets.size() > 4096)
+				offsets.clear();
+
+			std::tm time = {};
+			time.tm_year = year - 1900;
+			time.tm_mon = month - 1;
+			time.tm_mday = day;
+			time.tm_hour = hour;
+
+			iterator = offsets.emplace(hourKey, (int64_t)mktime(&time) - hourKey * 3600).first;
+		}
+
+		return (time_t)(hourKey * 3600 + iterator->second + minute * 60 + second);
+	}
+}
\ No newline at end of file
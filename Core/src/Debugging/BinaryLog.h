@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+// Binary log file layout, written by Logger and read by logdecode
+// File starts with FileHeader followed by records, each starting with RecordType byte
+// Format strings and titles are written once as dictionary records, messages refer to them by id
+// Record type is written last, so zero filled end of file or partially written record stops reading
+namespace BinaryLog
+{
+	static constexpr char Magic[8] = { 'D', 'M', 'P', 'B', 'L', 'O', 'G', 0 };
+	static constexpr uint32_t Version = 1;
+
+	enum class RecordType : uint8_t
+	{
+		End = 0, Format, Title, Message
+	};
+
+	struct FileHeader
+	{
+		char Magic[8];
+		uint32_t Version;
+		uint32_t Reserved;
+		int64_t StartTime; // Microseconds since epoch
+	};
+
+	// Followed by Length characters of format string or title
+	struct StringRecord
+	{
+		RecordType Type;
+		uint8_t Reserved;
+		uint16_t Length;
+		uint32_t Reserved2;
+		uint64_t Id;
+	};
+
+	// Followed by Size bytes of arguments encoded the same way as in LogRecord
+	struct MessageRecord
+	{
+		RecordType Type;
+		uint8_t MessageLevel;
+		uint8_t Core;
+		uint8_t ArgCount;
+		uint16_t Size;
+		uint16_t Reserved;
+		int64_t Time;
+		uint64_t FormatId;
+		uint64_t TitleId;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+// Types logger can store in record, everything else is rejected at compile time
+template<typename T>
+concept Loggable = std::is_arithmetic_v<std::decay_t<T>> || std::is_enum_v<std::decay_t<T>> ||
+	std::is_convertible_v<const std::decay_t<T>&, std::string_view>;
+
+// Piece of format string, either literal text or argument placeholder
+struct FormatSegment
+{
+	static constexpr uint8_t Literal = 0xFF;
+
+	uint16_t Offset = 0;
+	uint8_t Length = 0;
+	uint8_t Argument = Literal;
+};
+
+// Format string split into segments, produced at compile time, so logging only copies it
+struct CompiledFormat
+{
+	static constexpr uint8_t MaxSegments = 16;
+
+	const char* Text = nullptr;
+	uint64_t Id = 0; // Hash of text, identifies format in binary log
+	uint8_t SegmentCount = 0;
+	FormatSegment Segments[MaxSegments] = {};
+};
+
+enum class FormatError
+{
+	None = 0, PlaceholderIndexOutOfRange, TooManySegments, FormatTooLong
+};
+
+// FNV-1a, same format strings in different translation units get the same id
+constexpr uint64_t HashFormat(const char* text)
+{
+	uint64_t hash = 14695981039346656037ull;
+	while (*text)
+	{
+		hash ^= (uint8_t)*text++;
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+namespace Detail
+{
+	constexpr bool AddSegment(CompiledFormat& format, FormatSegment segment)
+	{
+		if (format.SegmentCount == CompiledFormat::MaxSegments)
+			return false;
+
+		format.Segments[format.SegmentCount++] = segment;
+		return true;
+	}
+
+	// Length is stored in one byte, longer text is split
+	constexpr bool AddLiteral(CompiledFormat& format, uint16_t start, uint16_t end)
+	{
+		while (start < end)
+		{
+			uint16_t length = end - start < 255 ? end - start : 255;
+			if (!AddSegment(format, { start, (uint8_t)length, FormatSegment::Literal }))
+				return false;
+
+			start += length;
+		}
+
+		return true;
+	}
+}
+
+// Splits text into segments, "{0}" to "{9}" are placeholders for arguments
+// Used at compile time by FormatString and at runtime by log decoder
+constexpr FormatError ParseFormat(CompiledFormat& format, const char* text, uint32_t argCount)
+{
+	format.Text = text;
+	format.Id = HashFormat(text);
+	format.SegmentCount = 0;
+
+	uint16_t position = 0;
+	uint16_t literalStart = 0;
+	while (text[position])
+	{
+		if (text[position] == '{' && text[position + 1] >= '0' && text[position + 1] <= '9' && text[position + 2] == '}')
+		{
+			uint8_t index = text[position + 1] - '0';
+			if (index >= argCount)
+				return FormatError::PlaceholderIndexOutOfRange;
+
+			if (!Detail::AddLiteral(format, literalStart, position) || !Detail::AddSegment(format, { position, 0, index }))
+				return FormatError::TooManySegments;
+
+			position += 3;
+			literalStart = position;
+		}
+		else
+		{
+			if (position == UINT16_MAX - 3)
+				return FormatError::FormatTooLong;
+
+			position++;
+		}
+	}
+
+	if (!Detail::AddLiteral(format, literalStart, position))
+		return FormatError::TooManySegments;
+
+	return FormatError::None;
+}
+
+namespace FormatErrors
+{
+	// Not constexpr, calling them from consteval constructor makes compilation fail with their name in error message
+	inline void PlaceholderIndexOutOfRange() {}
+	inline void TooManySegments() {}
+	inline void FormatTooLong() {}
+}
+
+// Format string checked against argument types, "{0}" to "{9}" are replaced by arguments
+template<typename... Args>
+struct FormatString : CompiledFormat
+{
+	static_assert((Loggable<Args> && ...), "Argument type not supported by Logger");
+
+	template<typename T> requires std::is_convertible_v<const T&, const char*>
+	consteval FormatString(const T& text)
+	{
+		switch (ParseFormat(*this, text, sizeof...(Args)))
+		{
+		case FormatError::PlaceholderIndexOutOfRange:
+			FormatErrors::PlaceholderIndexOutOfRange();
+			break;
+		case FormatError::TooManySegments:
+			FormatErrors::TooManySegments();
+			break;
+		case FormatError::FormatTooLong:
+			FormatErrors::FormatTooLong();
+			break;
+		default:
+			break;
+		}
+	}
+};
+
+// Arguments are not deduced from format string, only from arguments themselves
+template<typename... Args>
+using FormatStringFor = FormatString<std::decay_t<Args>...>;
\ No newline at end of file
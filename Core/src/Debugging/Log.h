@@ -1,12 +1,15 @@
 #pragma once
 #include "Logger.h"
 
-#ifndef PLATFORM_WINDOWS
+#if !defined(PLATFORM_WINDOWS) && !defined(PLATFORM_LINUX)
 	#error No other systems supported yet
 #endif
 
 #if !defined(DISTRIBUTION_CONFIG) || defined(SYSTEM_CONSOLE)
 	#define SetLoggerTitle(title) { Logger::Title = title; }
+	#define FlushLogger() Logger::Flush()
+	#define SetLoggerLevel(name) { Logger::SetLevel(name); }
+	#define OpenLoggerBinaryFile(path) Logger::OpenBinaryLog(path)
 
 	#ifdef CORE
 		#define TRACE(...)	Logger::TraceCore(__VA_ARGS__)
@@ -23,6 +26,9 @@
 	#endif
 #else
 	#define SetLoggerTitle(title)
+	#define FlushLogger()
+	#define SetLoggerLevel(name)
+	#define OpenLoggerBinaryFile(path) false
 
 	#define TRACE(...)
 	#define DEBUG(...)
@@ -34,10 +40,13 @@
 #ifndef DISTRIBUTION_CONFIG
 	#ifdef PLATFORM_WINDOWS
 		#define DEBUGBREAK() __debugbreak();
+	#elif defined(PLATFORM_LINUX)
+		#include <csignal>
+		#define DEBUGBREAK() raise(SIGTRAP);
 	#endif
 
-	#define ASSERT(con, msg, ...) { if (con) { ERROR(msg, __VA_ARGS__); DEBUGBREAK(); } }
-	#define ASSERT(con, msg) { if (con) { ERROR(msg); DEBUGBREAK(); } }
+	#define ASSERT(con, msg, ...) { if (con) { ERROR(msg, __VA_ARGS__); FlushLogger(); DEBUGBREAK(); } }
+	#define ASSERT(con, msg) { if (con) { ERROR(msg); FlushLogger(); DEBUGBREAK(); } }
 #else
 	#define ASSERT(con, msg, ...) con
 	#define ASSERT(con, msg) con
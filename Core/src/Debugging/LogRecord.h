@@ -0,0 +1,229 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <cstdio>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "FormatString.h"
+
+enum class Level
+{
+	Trace = 0, Debug, Info, Warn, Error
+};
+
+static constexpr const char* LevelNames[] = { "trace", "debug", "info", "warning", "error" };
+
+// Level by name used in config files, debug if unknown
+inline Level GetLevel(std::string_view name)
+{
+	for (int i = 0; i < 5; i++)
+		if (name == LevelNames[i])
+			return (Level)i;
+
+	return Level::Debug;
+}
+
+enum class LogArgType : uint8_t
+{
+	Int = 0, UInt, Float, Bool, String
+};
+
+// Compact log message, format is not applied until logger thread writes it
+// Arguments are stored after each other as type tag and raw value, strings as length and characters
+struct LogRecord
+{
+	static constexpr size_t DataSize = 216;
+	static constexpr uint32_t MaxArgs = 10; // Placeholders are single digit
+
+	Level MessageLevel = Level::Trace;
+	bool Core = false;
+	uint8_t ArgCount = 0;
+	uint16_t Size = 0;
+
+	int64_t Time = 0; // Microseconds since epoch
+	const char* Title = nullptr;
+	CompiledFormat Format; // Segments point to literal format string
+
+	char Data[DataSize];
+
+	template<typename T>
+	inline bool Write(LogArgType type, const T& value)
+	{
+		if (Size + 1 + sizeof(T) > DataSize)
+			return false;
+
+		Data[Size] = (char)type;
+		memcpy(Data + Size + 1, &value, sizeof(T));
+		Size += 1 + sizeof(T);
+		ArgCount++;
+
+		return true;
+	}
+
+	// Strings not fitting into record are truncated
+	inline bool WriteString(std::string_view string)
+	{
+		if (Size + 1 + sizeof(uint16_t) > DataSize)
+			return false;
+
+		uint16_t length = (uint16_t)std::min(string.size(), DataSize - Size - 1 - sizeof(uint16_t));
+
+		Data[Size] = (char)LogArgType::String;
+		memcpy(Data + Size + 1, &length, sizeof(uint16_t));
+		memcpy(Data + Size + 1 + sizeof(uint16_t), string.data(), length);
+		Size += 1 + sizeof(uint16_t) + length;
+		ArgCount++;
+
+		return true;
+	}
+
+	template<Loggable T>
+	inline void AddArg(const T& arg)
+	{
+		using Type = std::decay_t<T>;
+
+		if constexpr (std::is_same_v<Type, bool>)
+			Write(LogArgType::Bool, arg);
+		else if constexpr (std::is_enum_v<Type>)
+			Write(LogArgType::Int, (int64_t)arg);
+		else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+			Write(LogArgType::Int, (int64_t)arg);
+		else if constexpr (std::is_integral_v<Type>)
+			Write(LogArgType::UInt, (uint64_t)arg);
+		else if constexpr (std::is_floating_point_v<Type>)
+			Write(LogArgType::Float, (double)arg);
+		else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, const char*>) // Arrays like string literals can't be null
+			WriteString(arg ? std::string_view(arg) : std::string_view("(null)"));
+		else
+			WriteString(std::string_view(arg));
+	}
+
+	// Appends whole console line, "[HH:MM:SS] Title LEVEL: message"
+	inline void AppendLine(std::string& output, bool colors = true) const
+	{
+		static const char* colorCodes[] = { "\033[94m", "\033[35m", "\033[32m", "\033[33m", "\033[31m" };
+		static const char* names[] = { "TRACE", "DEBUG", "INFO", "WARNING", "ERROR" };
+
+		if (colors)
+			output += colorCodes[(int)MessageLevel];
+
+		output += '[';
+		AppendTime(output, (time_t)(Time / 1000000));
+		output += "] ";
+
+		if (Core)
+			output += "CORE ";
+		else
+		{
+			output += Title ? Title : "App";
+			output += ' ';
+		}
+
+		output += names[(int)MessageLevel];
+		output += ": ";
+
+		AppendMessage(output);
+		output += '\n';
+	}
+
+	// Time is formatted only once per second
+	static inline void AppendTime(std::string& output, time_t time)
+	{
+		static thread_local time_t lastTime = -1;
+		static thread_local char timebuffer[80];
+
+		if (time != lastTime)
+		{
+			lastTime = time;
+			std::tm* timestamp = std::localtime(&time);
+			strftime(timebuffer, sizeof(timebuffer), "%T", timestamp);
+		}
+
+		output += timebuffer;
+	}
+
+	// Appends message with arguments in place of placeholders to output
+	inline void AppendMessage(std::string& output) const
+	{
+		// Arguments are located once, segments then refer to them by index
+		const char* args[MaxArgs] = {};
+		uint16_t position = 0;
+		for (uint32_t i = 0; i < ArgCount && i < MaxArgs; i++)
+		{
+			args[i] = Data + position;
+
+			uint16_t size = 0;
+			switch ((LogArgType)Data[position])
+			{
+			case LogArgType::Int:
+			case LogArgType::UInt:
+			case LogArgType::Float:
+				size = 8;
+				break;
+			case LogArgType::Bool:
+				size = sizeof(bool);
+				break;
+			case LogArgType::String:
+				memcpy(&size, Data + position + 1, sizeof(uint16_t));
+				size += sizeof(uint16_t);
+				break;
+			}
+
+			position += 1 + size;
+		}
+
+		for (uint8_t i = 0; i < Format.SegmentCount; i++)
+		{
+			const FormatSegment& segment = Format.Segments[i];
+			if (segment.Argument == FormatSegment::Literal)
+				output.append(Format.Text + segment.Offset, segment.Length);
+			else if (args[segment.Argument]) // Argument is missing only if it didn't fit into record
+				AppendValue(output, (LogArgType)*args[segment.Argument], args[segment.Argument] + 1);
+		}
+	}
+private:
+	static inline void AppendValue(std::string& output, LogArgType type, const char* value)
+	{
+		switch (type)
+		{
+		case LogArgType::Int:
+		{
+			int64_t number;
+			memcpy(&number, value, sizeof(number));
+			output += std::to_string(number);
+			break;
+		}
+		case LogArgType::UInt:
+		{
+			uint64_t number;
+			memcpy(&number, value, sizeof(number));
+			output += std::to_string(number);
+			break;
+		}
+		case LogArgType::Float:
+		{
+			double number;
+			memcpy(&number, value, sizeof(number));
+
+			// Same output as std::cout << double
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "%g", number);
+			output += buffer;
+			break;
+		}
+		case LogArgType::Bool:
+			output += *value ? '1' : '0';
+			break;
+		case LogArgType::String:
+		{
+			uint16_t length;
+			memcpy(&length, value, sizeof(uint16_t));
+			output.append(value + sizeof(uint16_t), length);
+			break;
+		}
+		}
+	}
+};
\ No newline at end of file
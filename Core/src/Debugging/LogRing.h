@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Bounded lock-free ring of log records, any thread can push, only logger thread pops
+// Every cell carries sequence number telling whether it's free for position being pushed or holds value for position being popped
+template<typename T, size_t Capacity>
+class LogRing
+{
+	static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "Capacity has to be power of two");
+public:
+	LogRing()
+	{
+		for (size_t i = 0; i < Capacity; i++)
+			cells[i].Sequence.store(i, std::memory_order_relaxed);
+	}
+
+	LogRing(const LogRing&) = delete;
+
+	// Value is filled in place by fill function, returns false when ring is full
+	template<typename Fill>
+	bool TryPush(Fill&& fill)
+	{
+		Cell* cell;
+		size_t position = pushPosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			cell = &cells[position & (Capacity - 1)];
+			size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+			if (difference == 0)
+			{
+				if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0)
+				return false; // Cell still holds value from previous lap
+			else
+				position = pushPosition.load(std::memory_order_relaxed);
+		}
+
+		fill(cell->Value);
+		cell->Sequence.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Consumer side, returns nullptr if next value is not pushed yet
+	T* Front()
+	{
+		Cell& cell = cells[popPosition & (Capacity - 1)];
+		if (cell.Sequence.load(std::memory_order_acquire) != popPosition + 1)
+			return nullptr;
+
+		return &cell.Value;
+	}
+
+	void Pop()
+	{
+		Cell& cell = cells[popPosition & (Capacity - 1)];
+		cell.Sequence.store(popPosition + Capacity, std::memory_order_release);
+		popPosition++;
+	}
+
+	// Count of values pushed so far, values are popped in the same order
+	inline size_t GetPushPosition() const { return pushPosition.load(std::memory_order_acquire); }
+	inline size_t GetPopPosition() const { return popPosition; }
+private:
+	struct alignas(64) Cell
+	{
+		std::atomic<size_t> Sequence;
+		T Value;
+	};
+
+	Cell cells[Capacity];
+
+	alignas(64) std::atomic<size_t> pushPosition = 0;
+	alignas(64) size_t popPosition = 0;
+};
\ No newline at end of file
@@ -2,338 +2,324 @@
 #if !defined(DISTRIBUTION_CONFIG) || defined(SYSTEM_CONSOLE)
 
 #include <iostream>
-#include <any>
 #include <vector>
 #include <string>
 #include <ctime>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <unordered_set>
 #include "Networking/Message.h"
-
-enum class Level
-{
-	Trace = 0, Debug, Info, Warn, Error
-};
-
+#include "FormatString.h"
+#include "LogRecord.h"
+#include "LogRing.h"
+#include "BinaryLog.h"
+#include "Utils/MappedFile.h"
+
+// Asynchronous logger, calling thread only copies arguments and compiled format into record in lock-free ring
+// Records are formatted and written in batches by logger thread, so logging never waits for console
+// Format strings are parsed and checked against arguments at compile time (FormatString)
+// In binary mode records are not formatted at all, they are copied to memory mapped file and rendered offline by logdecode
 class Logger
 {
 	Logger() = delete;
 public:
+	static constexpr size_t Capacity = 8192; // Records in ring (~3MB)
+	static constexpr uint32_t BatchSize = 256; // Records written with one flush
+
 	static inline Level level = Level::Debug;
 	static inline const char* Title = "App";
 
 	template<typename... Args>
-	static void Trace(const char* message, Args&&... _args)
+	static void Trace(FormatStringFor<Args...> format, Args&&... args) { if (level == Level::Trace) Log(Level::Trace, false, format, args...); }
+	template<typename... Args>
+	static void Debug(FormatStringFor<Args...> format, Args&&... args) { if (level <= Level::Debug) Log(Level::Debug, false, format, args...); }
+	template<typename... Args>
+	static void Info(FormatStringFor<Args...> format, Args&&... args) { if (level <= Level::Info) Log(Level::Info, false, format, args...); }
+	template<typename... Args>
+	static void Warn(FormatStringFor<Args...> format, Args&&... args) { if (level <= Level::Warn) Log(Level::Warn, false, format, args...); }
+	template<typename... Args>
+	static void Error(FormatStringFor<Args...> format, Args&&... args) { if (level <= Level::Error) Log(Level::Error, false, format, args...); }
+
+	template<typename... Args>
+	static void TraceCore(FormatStringFor<Args...> format, Args&&... args) { if (level == Level::Trace) Log(Level::Trace, true, format, args...); }
+	template<typename... Args>
+	static void DebugCore(FormatStringFor<Args...> format, Args&&... args) { if (level <= Level::Debug) Log(Level::Debug, true, format, args...); }
+	template<typename... Args>
+	static void InfoCore(FormatStringFor<Args...> format, Args&&... args) { if (level <= Level::Info) Log(Level::Info, true, format, args...); }
+	template<typename... Args>
+	static void WarnCore(FormatStringFor<Args...> format, Args&&... args) { if (level <= Level::Warn) Log(Level::Warn, true, format, args...); }
+	template<typename... Args>
+	static void ErrorCore(FormatStringFor<Args...> format, Args&&... args) { if (level <= Level::Error) Log(Level::Error, true, format, args...); }
+
+	static inline void SetLevel(std::string_view name) { level = GetLevel(name); }
+
+	// Switches output to binary log file, warnings and errors are still written to console
+	static bool OpenBinaryLog(const char* path)
 	{
-		if (level == Level::Trace)
+		if (writer.BinaryFile.load(std::memory_order_acquire))
+			return false;
+
+		MappedFile* file = new MappedFile(path);
+		if (!*file)
 		{
-			std::vector<std::any> args = { _args... };
+			delete file;
+			return false;
+		}
 
-			GetLoggerTime();
-			std::cout << "\033[94m[" << timebuffer << "] " << Title << " TRACE: ";
-			while (*message)
-			{
-				if (*message == '{' && *(message + 2) == '}')
-				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
-				}
-				else
-				{
-					std::cout << *message;
-					message++;
-				}
-			}
+		BinaryLog::FileHeader header = {};
+		memcpy(header.Magic, BinaryLog::Magic, sizeof(header.Magic));
+		header.Version = BinaryLog::Version;
+		header.StartTime = GetTime();
+		file->Write(&header, sizeof(header));
 
-			std::cout << std::endl;
-		}
+		writer.BinaryFile.store(file, std::memory_order_release);
+		return true;
 	}
 
-	template<typename... Args>
-	static void Debug(const char* message, Args&&... _args)
+	// Blocks until everything logged before is written (before crash or break)
+	static void Flush()
 	{
-		if (level <= Level::Debug)
-		{
-			std::vector<std::any> args = { _args... };
-
-			GetLoggerTime();
-			std::cout << "\033[35m[" << timebuffer << "] " << Title << " DEBUG: ";
-			while (*message)
-			{
-				if (*message == '{' && *(message + 2) == '}')
-				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
-				}
-				else
-				{
-					std::cout << *message;
-					message++;
-				}
-			}
+		if (!writer.Running.load(std::memory_order_acquire))
+			return;
 
-			std::cout << std::endl;
-		}
+		size_t target = ring.GetPushPosition();
+		while (writer.Written.load(std::memory_order_acquire) < target && writer.Running.load(std::memory_order_acquire))
+			std::this_thread::yield();
 	}
 
+	static inline const uint64_t GetDroppedCount() { return droppedTotal.load(std::memory_order_relaxed); }
+private:
 	template<typename... Args>
-	static void Info(const char* message, Args&&... _args)
+	static void Log(Level messageLevel, bool core, const CompiledFormat& format, Args&... args)
 	{
-		if (level <= Level::Info)
+		auto fill = [&](LogRecord& record) {
+			record.MessageLevel = messageLevel;
+			record.Core = core;
+			record.ArgCount = 0;
+			record.Size = 0;
+			record.Time = GetTime();
+			record.Title = Title;
+			record.Format = format;
+
+			(record.AddArg(args), ...);
+		};
+
+		// Before logger thread starts and after it ends (static initialization and destruction) messages are written directly
+		if (!writer.Running.load(std::memory_order_acquire))
+		{
+			LogRecord record;
+			fill(record);
+
+			std::string output;
+			record.AppendLine(output);
+			std::fwrite(output.data(), 1, output.size(), stdout);
+			std::fflush(stdout);
+			return;
+		}
+
+		if (ring.TryPush(fill))
 		{
-			std::vector<std::any> args = { _args... };
+			writer.Wake();
+			return;
+		}
 
-			GetLoggerTime();
-			std::cout << "\033[32m[" << timebuffer << "] " << Title << " INFO: ";
-			while (*message)
+		// Ring is full, warnings and errors wait a moment for logger thread, everything else is dropped
+		if (messageLevel >= Level::Warn)
+		{
+			for (uint32_t i = 0; i < 1000; i++)
 			{
-				if (*message == '{' && *(message + 2) == '}')
-				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
-				}
-				else
+				std::this_thread::yield();
+
+				if (ring.TryPush(fill))
 				{
-					std::cout << *message;
-					message++;
+					writer.Wake();
+					return;
 				}
 			}
-
-			std::cout << std::endl;
 		}
+
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		droppedTotal.fetch_add(1, std::memory_order_relaxed);
 	}
 
-	template<typename... Args>
-	static void Warn(const char* message, Args&&... _args)
+	static inline int64_t GetTime()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	// Thread writing records from ring, started with first use of logger and stopped at exit after writing everything
+	struct Writer
 	{
-		if (level <= Level::Warn)
+		Writer() : thread([this]() { Run(); })
 		{
-			std::vector<std::any> args = { _args... };
+			Running.store(true, std::memory_order_release);
+		}
 
-			GetLoggerTime();
-			std::cout << "\033[33m[" << timebuffer << "] " << Title << " WARNING: ";
-			while (*message)
-			{
-				if (*message == '{' && *(message + 2) == '}')
-				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
-				}
-				else
-				{
-					std::cout << *message;
-					message++;
-				}
-			}
+		~Writer()
+		{
+			stopping.store(true, std::memory_order_release);
+			Wake();
+			thread.join();
+			Running.store(false, std::memory_order_release);
 
-			std::cout << std::endl;
+			delete BinaryFile.load(std::memory_order_acquire);
 		}
-	}
 
-	template<typename... Args>
-	static void Error(const char* message, Args&&... _args)
-	{
-		if (level <= Level::Error)
+		void Run()
 		{
-			std::vector<std::any> args = { _args... };
+			std::string batch;
 
-			GetLoggerTime();
-			std::cout << "\033[31m[" << timebuffer << "] " << Title << " ERROR: ";
-			while (*message)
+			while (true)
 			{
-				if (*message == '{' && *(message + 2) == '}')
+				bool stop = stopping.load(std::memory_order_acquire);
+
+				uint32_t count = 0;
+				while (count < BatchSize)
 				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
+					LogRecord* record = ring.Front();
+					if (!record)
+						break;
+
+					MappedFile* file = BinaryFile.load(std::memory_order_acquire);
+					if (file)
+						WriteBinary(*file, *record);
+
+					if (!file || record->MessageLevel >= Level::Warn)
+						record->AppendLine(batch);
+
+					ring.Pop();
+					count++;
 				}
-				else
+
+				uint64_t droppedCount = dropped.exchange(0, std::memory_order_relaxed);
+				if (droppedCount)
 				{
-					std::cout << *message;
-					message++;
+					batch += "\033[33m[";
+					LogRecord::AppendTime(batch, std::time(nullptr));
+					batch += "] LOGGER WARNING: " + std::to_string(droppedCount) + " messages dropped, log ring is full\n";
 				}
-			}
-
-			std::cout << std::endl;
-		}
-	}
-
-	template<typename... Args>
-	static void TraceCore(const char* message, Args&&... _args)
-	{
-		if (level == Level::Trace)
-		{
-			std::vector<std::any> args = { _args... };
 
-			GetLoggerTime();
-			std::cout << "\033[94m[" << timebuffer << "] CORE TRACE: ";
-			while (*message)
-			{
-				if (*message == '{' && *(message + 2) == '}')
+				if (!batch.empty())
 				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
+					std::fwrite(batch.data(), 1, batch.size(), stdout);
+					std::fflush(stdout);
+					batch.clear();
 				}
-				else
+
+				Written.store(ring.GetPopPosition(), std::memory_order_release);
+
+				if (!count)
 				{
-					std::cout << *message;
-					message++;
+					if (stop)
+						break;
+
+					Sleep();
 				}
 			}
-
-			std::cout << std::endl;
 		}
-	}
 
-	template<typename... Args>
-	static void DebugCore(const char* message, Args&&... _args)
-	{
-		if (level <= Level::Debug)
+		// Idle writer blocks until record is pushed, producers notify it only while it sleeps
+		// Both sides use fence between their store and load, so either producer sees the flag or writer sees the record
+		void Sleep()
 		{
-			std::vector<std::any> args = { _args... };
+			sleeping.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
 
-			GetLoggerTime();
-			std::cout << "\033[35m[" << timebuffer << "] CORE DEBUG: ";
-			while (*message)
-			{
-				if (*message == '{' && *(message + 2) == '}')
-				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
-				}
-				else
-				{
-					std::cout << *message;
-					message++;
-				}
-			}
+			if (!ring.Front() && !stopping.load(std::memory_order_relaxed))
+				sleeping.wait(true, std::memory_order_relaxed);
 
-			std::cout << std::endl;
+			sleeping.store(false, std::memory_order_relaxed);
 		}
-	}
 
-	template<typename... Args>
-	static void InfoCore(const char* message, Args&&... _args)
-	{
-		if (level <= Level::Info)
+		// Called by producer after push
+		void Wake()
 		{
-			std::vector<std::any> args = { _args... };
+			std::atomic_thread_fence(std::memory_order_seq_cst);
 
-			GetLoggerTime();
-			std::cout << "\033[32m[" << timebuffer << "] CORE INFO: ";
-			while (*message)
+			if (sleeping.load(std::memory_order_relaxed))
 			{
-				if (*message == '{' && *(message + 2) == '}')
-				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
-				}
-				else
-				{
-					std::cout << *message;
-					message++;
-				}
+				sleeping.store(false, std::memory_order_relaxed);
+				sleeping.notify_one();
 			}
-
-			std::cout << std::endl;
 		}
-	}
 
-	template<typename... Args>
-	static void WarnCore(const char* message, Args&&... _args)
-	{
-		if (level <= Level::Warn)
+		void WriteBinary(MappedFile& file, const LogRecord& record)
 		{
-			std::vector<std::any> args = { _args... };
-
-			GetLoggerTime();
-			std::cout << "\033[33m[" << timebuffer << "] CORE WARNING: ";
-			while (*message)
+			uint64_t titleId = 0;
+			if (!record.Core && record.Title)
 			{
-				if (*message == '{' && *(message + 2) == '}')
+				// Title changes rarely, it's hashed only when pointer changes
+				if (record.Title != lastTitle)
 				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
-				}
-				else
-				{
-					std::cout << *message;
-					message++;
+					lastTitle = record.Title;
+					lastTitleId = HashFormat(record.Title);
 				}
+
+				titleId = lastTitleId;
+				WriteString(file, BinaryLog::RecordType::Title, titleId, record.Title);
 			}
 
-			std::cout << std::endl;
+			WriteString(file, BinaryLog::RecordType::Format, record.Format.Id, record.Format.Text);
+
+			BinaryLog::MessageRecord header = {};
+			header.MessageLevel = (uint8_t)record.MessageLevel;
+			header.Core = record.Core;
+			header.ArgCount = record.ArgCount;
+			header.Size = record.Size;
+			header.Time = record.Time;
+			header.FormatId = record.Format.Id;
+			header.TitleId = titleId;
+
+			char* destination = file.Reserve(sizeof(header) + record.Size);
+			if (!destination)
+				return;
+
+			memcpy(destination, &header, sizeof(header));
+			memcpy(destination + sizeof(header), record.Data, record.Size);
+			destination[0] = (char)BinaryLog::RecordType::Message;
+			file.Commit(sizeof(header) + record.Size);
 		}
-	}
 
-	template<typename... Args>
-	static void ErrorCore(const char* message, Args&&... _args)
-	{
-		if (level <= Level::Error)
+		// Dictionary record, each string is written only once
+		void WriteString(MappedFile& file, BinaryLog::RecordType type, uint64_t id, const char* text)
 		{
-			std::vector<std::any> args = { _args... };
+			if (!writtenStrings.insert(id).second)
+				return;
 
-			GetLoggerTime();
-			std::cout << "\033[31m[" << timebuffer << "] CORE ERROR: ";
-			while (*message)
-			{
-				if (*message == '{' && *(message + 2) == '}')
-				{
-					int i = *(message + 1) - 48;
-					printArg(args, i);
-					message += 3;
-				}
-				else
-				{
-					std::cout << *message;
-					message++;
-				}
-			}
+			BinaryLog::StringRecord header = {};
+			header.Length = (uint16_t)strlen(text);
+			header.Id = id;
+
+			char* destination = file.Reserve(sizeof(header) + header.Length);
+			if (!destination)
+				return;
 
-			std::cout << std::endl;
+			memcpy(destination, &header, sizeof(header));
+			memcpy(destination + sizeof(header), text, header.Length);
+			destination[0] = (char)type;
+			file.Commit(sizeof(header) + header.Length);
 		}
-	}
-private:
-	static inline void printArg(std::vector<std::any>& args, int& index)
-	{
-		if (args[index].type() == typeid(const char*))
-			std::cout << any_cast<const char*>(args[index]);
-		else if (args[index].type() == typeid(char*))
-			std::cout << any_cast<char*>(args[index]);
-		else if (args[index].type() == typeid(int))
-			std::cout << any_cast<int>(args[index]);
-		else if (args[index].type() == typeid(uint32_t))
-			std::cout << any_cast<uint32_t>(args[index]);
-		else if (args[index].type() == typeid(size_t))
-			std::cout << any_cast<size_t>(args[index]);
-		else if (args[index].type() == typeid(float))
-			std::cout << any_cast<float>(args[index]);
-		else if (args[index].type() == typeid(double))
-			std::cout << any_cast<double>(args[index]);
-		else if (args[index].type() == typeid(bool))
-			std::cout << any_cast<bool>(args[index]);
-		else if (args[index].type() == typeid(std::string))
-			std::cout << any_cast<std::string>(args[index]);
-		else if (args[index].type() == typeid(uint_least16_t))
-			std::cout << any_cast<uint_least16_t>(args[index]);
-		else
-			std::cout << "Argument at position: " << index << " not supported!" << std::endl;
-	}
 
-	static inline void GetLoggerTime()
-	{
-		std::time_t current_time = std::time(0);
-		std::tm* timestamp = std::localtime(&current_time);
-		strftime(timebuffer, 80, "%T", timestamp);
-	}
+		std::atomic<bool> Running = false;
+		std::atomic<size_t> Written = 0;
+		std::atomic<MappedFile*> BinaryFile = nullptr;
+
+		std::unordered_set<uint64_t> writtenStrings;
+		const char* lastTitle = nullptr;
+		uint64_t lastTitleId = 0;
+
+		std::atomic<bool> stopping = false;
+		std::atomic<bool> sleeping = false;
+		std::thread thread;
+	};
+
+	static inline std::atomic<uint64_t> dropped = 0; // Since last drop warning
+	static inline std::atomic<uint64_t> droppedTotal = 0;
 
-	static inline char timebuffer[80];
+	// Ring has to be defined before writer, so it's constructed before and destroyed after it
+	static inline LogRing<LogRecord, Capacity> ring;
+	static inline Writer writer;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include "pch.h"
+#include "Metrics.h"
+#include "Debugging/Log.h"
+#include <csignal>
+#include <cmath>
+
+namespace Core
+{
+	namespace
+	{
+		struct Registry
+		{
+			std::mutex mutex;
+
+			std::vector<std::string> counterNames;
+			std::vector<std::string> gaugeNames;
+			std::vector<std::string> histogramNames;
+
+			std::vector<MetricsShard*> shards;
+			MetricsShard retired; // Values of threads which already ended
+
+			std::string dumpPath;
+			std::chrono::seconds dumpInterval = std::chrono::seconds(0);
+			std::chrono::steady_clock::time_point lastDump;
+		};
+
+		// Never destroyed, threads can end after static destruction started
+		Registry& GetRegistry()
+		{
+			static Registry* registry = new Registry();
+			return *registry;
+		}
+
+		std::atomic<bool> dumpEnabled = false;
+		std::atomic<bool> dumpRequested = false;
+
+		uint32_t Register(std::vector<std::string>& names, std::string_view name, uint32_t capacity)
+		{
+			std::scoped_lock lock(GetRegistry().mutex);
+
+			auto existing = std::find(names.begin(), names.end(), name);
+			if (existing != names.end())
+				return (uint32_t)(existing - names.begin());
+
+			// Last metric is shared by everything over capacity
+			if (names.size() == capacity)
+			{
+				ERROR("Metric {0} over capacity {1}, values are merged into {2}", name, capacity, names.back());
+				return capacity - 1;
+			}
+
+			names.emplace_back(name);
+			return (uint32_t)names.size() - 1;
+		}
+
+		void Merge(MetricsShard& target, const MetricsShard& source)
+		{
+			for (uint32_t i = 0; i < MetricsShard::MaxCounters; i++)
+				AddRelaxed(target.Counters[i], source.Counters[i].load(std::memory_order_relaxed));
+
+			for (uint32_t i = 0; i < MetricsShard::MaxGauges; i++)
+				AddRelaxed(target.Gauges[i], source.Gauges[i].load(std::memory_order_relaxed));
+
+			for (uint32_t i = 0; i < MetricsShard::MaxHistograms; i++)
+			{
+				const HistogramShard* histogram = source.Histograms[i].load(std::memory_order_acquire);
+				if (!histogram)
+					continue;
+
+				HistogramShard* targetHistogram = target.Histograms[i].load(std::memory_order_relaxed);
+				if (!targetHistogram)
+				{
+					targetHistogram = new HistogramShard();
+					target.Histograms[i].store(targetHistogram, std::memory_order_release);
+				}
+
+				for (uint32_t j = 0; j < HistogramBuckets::Count; j++)
+					AddRelaxed(targetHistogram->Buckets[j], histogram->Buckets[j].load(std::memory_order_relaxed));
+
+				AddRelaxed(targetHistogram->Count, histogram->Count.load(std::memory_order_relaxed));
+				AddRelaxed(targetHistogram->Sum, histogram->Sum.load(std::memory_order_relaxed));
+				targetHistogram->Min.store(std::min(targetHistogram->Min.load(std::memory_order_relaxed), histogram->Min.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+				targetHistogram->Max.store(std::max(targetHistogram->Max.load(std::memory_order_relaxed), histogram->Max.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+			}
+		}
+
+		// Labels of name and additional label joined, name{a="1"} + b="2" -> name_suffix{a="1",b="2"}
+		std::string GetSeriesName(const std::string& name, const char* suffix, const std::string& label = "")
+		{
+			size_t labelsStart = name.find('{');
+			std::string series = "dmp_" + name.substr(0, labelsStart) + suffix;
+
+			std::string labels = labelsStart != std::string::npos ? name.substr(labelsStart + 1, name.size() - labelsStart - 2) : "";
+			if (!label.empty())
+				labels += labels.empty() ? label : "," + label;
+
+			if (!labels.empty())
+				series += "{" + labels + "}";
+
+			return series;
+		}
+
+		void WriteType(std::string& output, std::string& lastName, const std::string& name, const char* type)
+		{
+			std::string baseName = name.substr(0, name.find('{'));
+			if (baseName == lastName)
+				return;
+
+			lastName = baseName;
+			output += "# TYPE dmp_" + baseName + " " + type + "\n";
+		}
+	}
+
+	MetricsShard::~MetricsShard()
+	{
+		for (uint32_t i = 0; i < MaxHistograms; i++)
+			delete Histograms[i].load(std::memory_order_relaxed);
+	}
+
+	uint64_t HistogramSnapshot::GetPercentile(double percentile) const
+	{
+		if (!Count)
+			return 0;
+
+		uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(percentile / 100.0 * Count));
+
+		uint64_t seen = 0;
+		for (uint32_t i = 0; i < HistogramBuckets::Count; i++)
+		{
+			seen += Buckets[i];
+			if (seen >= rank)
+				return std::min(HistogramBuckets::GetUpperBound(i), Max);
+		}
+
+		return Max;
+	}
+
+	Metrics::ShardOwner::ShardOwner() : Shard(new MetricsShard())
+	{
+		Registry& registry = GetRegistry();
+
+		std::scoped_lock lock(registry.mutex);
+		registry.shards.push_back(Shard);
+	}
+
+	Metrics::ShardOwner::~ShardOwner()
+	{
+		Registry& registry = GetRegistry();
+
+		std::scoped_lock lock(registry.mutex);
+		Merge(registry.retired, *Shard);
+		registry.shards.erase(std::remove(registry.shards.begin(), registry.shards.end(), Shard), registry.shards.end());
+
+		delete Shard;
+	}
+
+	Counter Metrics::GetCounter(std::string_view name)
+	{
+		return Counter(Register(GetRegistry().counterNames, name, MetricsShard::MaxCounters));
+	}
+
+	Gauge Metrics::GetGauge(std::string_view name)
+	{
+		return Gauge(Register(GetRegistry().gaugeNames, name, MetricsShard::MaxGauges));
+	}
+
+	Histogram Metrics::GetHistogram(std::string_view name)
+	{
+		return Histogram(Register(GetRegistry().histogramNames, name, MetricsShard::MaxHistograms));
+	}
+
+	MetricsSnapshot Metrics::GetSnapshot()
+	{
+		Registry& registry = GetRegistry();
+		std::scoped_lock lock(registry.mutex);
+
+		// Shards are merged into temporary one, owners keep writing into theirs meanwhile
+		MetricsShard merged;
+		Merge(merged, registry.retired);
+		for (MetricsShard* shard : registry.shards)
+			Merge(merged, *shard);
+
+		MetricsSnapshot snapshot;
+		for (uint32_t i = 0; i < registry.counterNames.size(); i++)
+			snapshot.Counters.emplace_back(registry.counterNames[i], merged.Counters[i].load(std::memory_order_relaxed));
+
+		for (uint32_t i = 0; i < registry.gaugeNames.size(); i++)
+			snapshot.Gauges.emplace_back(registry.gaugeNames[i], merged.Gauges[i].load(std::memory_order_relaxed));
+
+		for (uint32_t i = 0; i < registry.histogramNames.size(); i++)
+		{
+			HistogramSnapshot histogram;
+
+			const HistogramShard* source = merged.Histograms[i].load(std::memory_order_relaxed);
+			if (source)
+			{
+				histogram.Count = source->Count.load(std::memory_order_relaxed);
+				histogram.Sum = source->Sum.load(std::memory_order_relaxed);
+				histogram.Min = histogram.Count ? source->Min.load(std::memory_order_relaxed) : 0;
+				histogram.Max = source->Max.load(std::memory_order_relaxed);
+
+				for (uint32_t j = 0; j < HistogramBuckets::Count; j++)
+					histogram.Buckets[j] = source->Buckets[j].load(std::memory_order_relaxed);
+			}
+
+			snapshot.Histograms.emplace_back(registry.histogramNames[i], std::move(histogram));
+		}
+
+		return snapshot;
+	}
+
+	void Metrics::WriteText(std::string& output)
+	{
+		WriteText(output, GetSnapshot());
+	}
+
+	void Metrics::WriteText(std::string& output, const MetricsSnapshot& snapshot)
+	{
+		// Series of one metric have to be together
+		auto sorted = [](auto values) {
+			std::sort(values.begin(), values.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+			return values;
+		};
+
+		std::string lastName;
+		for (auto& [name, value] : sorted(snapshot.Counters))
+		{
+			WriteType(output, lastName, name, "counter");
+			output += GetSeriesName(name, "") + " " + std::to_string(value) + "\n";
+		}
+
+		for (auto& [name, value] : sorted(snapshot.Gauges))
+		{
+			WriteType(output, lastName, name, "gauge");
+			output += GetSeriesName(name, "") + " " + std::to_string(value) + "\n";
+		}
+
+		for (auto& [name, histogram] : sorted(snapshot.Histograms))
+		{
+			WriteType(output, lastName, name, "summary");
+
+			static const std::pair<const char*, double> quantiles[] = { { "0.5", 50.0 }, { "0.9", 90.0 }, { "0.99", 99.0 }, { "0.999", 99.9 }, { "1", 100.0 } };
+			for (auto& [label, percentile] : quantiles)
+				output += GetSeriesName(name, "", std::string("quantile=\"") + label + "\"") + " " + std::to_string(histogram.GetPercentile(percentile)) + "\n";
+
+			output += GetSeriesName(name, "_sum") + " " + std::to_string(histogram.Sum) + "\n";
+			output += GetSeriesName(name, "_count") + " " + std::to_string(histogram.Count) + "\n";
+		}
+	}
+
+	void Metrics::StartDump(const std::string& path, uint32_t intervalSeconds)
+	{
+		Registry& registry = GetRegistry();
+		{
+			std::scoped_lock lock(registry.mutex);
+			registry.dumpPath = path;
+			registry.dumpInterval = std::chrono::seconds(intervalSeconds);
+			registry.lastDump = std::chrono::steady_clock::now();
+		}
+
+		dumpEnabled = true;
+
+	#ifdef PLATFORM_LINUX
+		// Only flag is set in handler, file is written from application loop
+		signal(SIGUSR1, [](int) { RequestDump(); });
+	#endif
+	}
+
+	void Metrics::RequestDump()
+	{
+		dumpRequested.store(true, std::memory_order_relaxed);
+	}
+
+	void Metrics::Update()
+	{
+		if (!dumpEnabled.load(std::memory_order_relaxed))
+			return;
+
+		Registry& registry = GetRegistry();
+		auto now = std::chrono::steady_clock::now();
+
+		bool intervalElapsed = registry.dumpInterval.count() && now - registry.lastDump >= registry.dumpInterval;
+		if (!intervalElapsed && !dumpRequested.exchange(false, std::memory_order_relaxed))
+			return;
+
+		registry.lastDump = now;
+
+		std::string output;
+		WriteText(output);
+
+		// Written to temporary file first, so readers never see half written dump
+		std::string temporaryPath = registry.dumpPath + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ios::trunc);
+			file << output;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, registry.dumpPath, error);
+		if (error)
+			ERROR("Metrics could not be written to {0}: {1}", registry.dumpPath, error.message());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+	// Log-linear buckets (HDR style), values below 16 are exact, above that every power of two is split into 16 buckets (6.25% precision)
+	struct HistogramBuckets
+	{
+		static constexpr uint32_t SubBucketBits = 4;
+		static constexpr uint32_t SubBuckets = 1 << SubBucketBits;
+		static constexpr uint32_t Count = SubBuckets + (64 - SubBucketBits) * SubBuckets;
+
+		static inline uint32_t GetIndex(uint64_t value)
+		{
+			if (value < SubBuckets)
+				return (uint32_t)value;
+
+			uint32_t exponent = 63 - (uint32_t)std::countl_zero(value);
+			uint32_t subBucket = (uint32_t)(value >> (exponent - SubBucketBits)) - SubBuckets;
+
+			return SubBuckets + (exponent - SubBucketBits) * SubBuckets + subBucket;
+		}
+
+		// Highest value falling into bucket
+		static inline uint64_t GetUpperBound(uint32_t index)
+		{
+			if (index < SubBuckets)
+				return index;
+
+			uint32_t shift = (index - SubBuckets) / SubBuckets;
+			uint64_t subBucket = (index - SubBuckets) % SubBuckets;
+
+			return ((SubBuckets + subBucket + 1) << shift) - 1;
+		}
+	};
+
+	// Values of one thread, only owning thread writes them, so updates are plain relaxed loads and stores
+	// Other threads read them when merging snapshot
+	struct HistogramShard
+	{
+		std::atomic<uint64_t> Buckets[HistogramBuckets::Count] = {};
+		std::atomic<uint64_t> Count = 0;
+		std::atomic<uint64_t> Sum = 0;
+		std::atomic<uint64_t> Min = UINT64_MAX;
+		std::atomic<uint64_t> Max = 0;
+	};
+
+	struct MetricsShard
+	{
+		static constexpr uint32_t MaxCounters = 256;
+		static constexpr uint32_t MaxGauges = 64;
+		static constexpr uint32_t MaxHistograms = 64;
+
+		~MetricsShard();
+
+		std::atomic<uint64_t> Counters[MaxCounters] = {};
+		std::atomic<int64_t> Gauges[MaxGauges] = {}; // Gauge is sum of changes made by all threads
+		std::atomic<HistogramShard*> Histograms[MaxHistograms] = {}; // Allocated with first recorded value
+	};
+
+	template<typename T>
+	inline void AddRelaxed(std::atomic<T>& value, T amount) { value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed); }
+
+	// Metric handles, created once by name (Metrics::GetCounter...) and kept by instrumented code
+	class Counter
+	{
+	public:
+		Counter() = default;
+
+		inline void Add(uint64_t value = 1) const;
+	private:
+		Counter(uint32_t Index) : index(Index) {}
+
+		uint32_t index = 0;
+
+		friend class Metrics;
+	};
+
+	class Gauge
+	{
+	public:
+		Gauge() = default;
+
+		inline void Add(int64_t value = 1) const;
+		inline void Sub(int64_t value = 1) const { Add(-value); }
+	private:
+		Gauge(uint32_t Index) : index(Index) {}
+
+		uint32_t index = 0;
+
+		friend class Metrics;
+	};
+
+	class Histogram
+	{
+	public:
+		Histogram() = default;
+
+		inline void Record(uint64_t value) const;
+	private:
+		Histogram(uint32_t Index) : index(Index) {}
+
+		uint32_t index = 0;
+
+		friend class Metrics;
+	};
+
+	// Records time from construction to destruction in microseconds
+	class ScopedTimer
+	{
+	public:
+		ScopedTimer(const Histogram& Histogram) : histogram(Histogram), start(std::chrono::steady_clock::now()) {}
+		~ScopedTimer() { histogram.Record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()); }
+	private:
+		const Histogram& histogram;
+		std::chrono::steady_clock::time_point start;
+	};
+
+	struct HistogramSnapshot
+	{
+		uint64_t Count = 0;
+		uint64_t Sum = 0;
+		uint64_t Min = 0;
+		uint64_t Max = 0;
+		std::vector<uint64_t> Buckets = std::vector<uint64_t>(HistogramBuckets::Count);
+
+		// Upper bound of bucket containing percentile (0-100), nearest rank
+		uint64_t GetPercentile(double percentile) const;
+	};
+
+	struct MetricsSnapshot
+	{
+		std::vector<std::pair<std::string, uint64_t>> Counters;
+		std::vector<std::pair<std::string, int64_t>> Gauges;
+		std::vector<std::pair<std::string, HistogramSnapshot>> Histograms;
+	};
+
+	// Lock-free metrics, every thread updates it's own shard, shards are merged only when snapshot is taken
+	// Names may carry Prometheus labels, e.g. server_messages_total{type="Command"}
+	class Metrics
+	{
+		Metrics() = delete;
+	public:
+		// Returns existing metric if name is already registered
+		static Counter GetCounter(std::string_view name);
+		static Gauge GetGauge(std::string_view name);
+		static Histogram GetHistogram(std::string_view name);
+
+		static MetricsSnapshot GetSnapshot();
+
+		// Prometheus text format, metric names are prefixed with dmp_
+		static void WriteText(std::string& output);
+		static void WriteText(std::string& output, const MetricsSnapshot& snapshot);
+
+		// Writes metrics to file every interval (0 only on request) and on SIGUSR1 (Linux)
+		static void StartDump(const std::string& path, uint32_t intervalSeconds);
+		static void RequestDump();
+		// Called from application loop, dump is written here and not from signal handler
+		static void Update();
+
+		static inline MetricsShard& GetShard()
+		{
+			static thread_local ShardOwner owner;
+			return *owner.Shard;
+		}
+	private:
+		// Shard of thread is registered with first metric update and merged into retired values when thread ends
+		struct ShardOwner
+		{
+			ShardOwner();
+			~ShardOwner();
+
+			MetricsShard* Shard;
+		};
+	};
+
+	inline void Counter::Add(uint64_t value) const
+	{
+		AddRelaxed(Metrics::GetShard().Counters[index], value);
+	}
+
+	inline void Gauge::Add(int64_t value) const
+	{
+		AddRelaxed(Metrics::GetShard().Gauges[index], value);
+	}
+
+	inline void Histogram::Record(uint64_t value) const
+	{
+		MetricsShard& shard = Metrics::GetShard();
+
+		HistogramShard* histogram = shard.Histograms[index].load(std::memory_order_relaxed);
+		if (!histogram)
+		{
+			histogram = new HistogramShard();
+			shard.Histograms[index].store(histogram, std::memory_order_release);
+		}
+
+		AddRelaxed(histogram->Buckets[HistogramBuckets::GetIndex(value)], (uint64_t)1);
+		AddRelaxed(histogram->Count, (uint64_t)1);
+		AddRelaxed(histogram->Sum, value);
+
+		if (value < histogram->Min.load(std::memory_order_relaxed))
+			histogram->Min.store(value, std::memory_order_relaxed);
+		if (value > histogram->Max.load(std::memory_order_relaxed))
+			histogram->Max.store(value, std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "pch.h"
+#include "Tracing.h"
+#include "Debugging/Log.h"
+
+namespace Core
+{
+	namespace
+	{
+		// Only owning thread writes spans, count is published after span is written, so export can read while thread records
+		struct ThreadBuffer
+		{
+			std::unique_ptr<SpanRecord[]> Spans = std::make_unique<SpanRecord[]>(Tracing::BufferCapacity);
+			std::atomic<uint32_t> Count = 0;
+			uint32_t ThreadIndex = 0;
+		};
+
+		struct Registry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadBuffer>> buffers; // Kept after thread ends, so it's spans can be exported
+		};
+
+		// Never destroyed, threads can record after static destruction started
+		Registry& GetRegistry()
+		{
+			static Registry* registry = new Registry();
+			return *registry;
+		}
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			static thread_local ThreadBuffer* buffer = nullptr;
+			if (!buffer)
+			{
+				Registry& registry = GetRegistry();
+				std::scoped_lock lock(registry.mutex);
+
+				registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+				buffer = registry.buffers.back().get();
+				buffer->ThreadIndex = (uint32_t)registry.buffers.size();
+			}
+
+			return *buffer;
+		}
+
+		void AppendEscaped(std::string& output, const char* text)
+		{
+			for (; *text; text++)
+			{
+				if (*text == '"' || *text == '\\')
+					output += '\\';
+
+				output += *text;
+			}
+		}
+	}
+
+	void Tracing::Start(uint32_t sampleInterval)
+	{
+		interval.store(sampleInterval, std::memory_order_relaxed);
+
+		if (sampleInterval)
+			INFO("Tracing every {0}. request", sampleInterval);
+	}
+
+	void Tracing::Record(const char* name, uint64_t traceId, int64_t start, int64_t end)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		uint32_t count = buffer.Count.load(std::memory_order_relaxed);
+		if (count == BufferCapacity)
+			return;
+
+		buffer.Spans[count] = { name, traceId, start, end };
+		buffer.Count.store(count + 1, std::memory_order_release);
+	}
+
+	bool Tracing::Export(const std::string& path)
+	{
+		struct ExportedSpan
+		{
+			SpanRecord Record;
+			uint32_t ThreadIndex;
+		};
+
+		std::vector<ExportedSpan> spans;
+		{
+			Registry& registry = GetRegistry();
+			std::scoped_lock lock(registry.mutex);
+
+			for (auto& buffer : registry.buffers)
+			{
+				uint32_t count = buffer->Count.load(std::memory_order_acquire);
+				for (uint32_t i = 0; i < count; i++)
+					spans.push_back({ buffer->Spans[i], buffer->ThreadIndex });
+			}
+		}
+
+		if (spans.empty())
+			return false;
+
+		// Spans of one request follow each other, flow arrows connect them in order
+		std::sort(spans.begin(), spans.end(), [](const ExportedSpan& a, const ExportedSpan& b) {
+			return a.Record.TraceId != b.Record.TraceId ? a.Record.TraceId < b.Record.TraceId : a.Record.Start < b.Record.Start;
+		});
+
+		int64_t base = spans.front().Record.Start;
+		for (const ExportedSpan& span : spans)
+			base = std::min(base, span.Record.Start);
+
+		std::string output = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		for (size_t i = 0; i < spans.size(); i++)
+		{
+			const SpanRecord& record = spans[i].Record;
+			std::string thread = std::to_string(spans[i].ThreadIndex);
+			std::string timestamp = std::to_string(record.Start - base);
+			std::string id = std::to_string(record.TraceId);
+
+			output += "{\"name\":\"";
+			AppendEscaped(output, record.Name);
+			output += "\",\"cat\":\"dmp\",\"ph\":\"X\",\"pid\":1,\"tid\":" + thread + ",\"ts\":" + timestamp +
+				",\"dur\":" + std::to_string(record.End - record.Start) + ",\"args\":{\"trace\":" + id + "}},\n";
+
+			bool first = !i || spans[i - 1].Record.TraceId != record.TraceId;
+			bool last = i + 1 == spans.size() || spans[i + 1].Record.TraceId != record.TraceId;
+			if (first && last)
+				continue;
+
+			const char* phase = first ? "s" : last ? "f" : "t";
+			output += std::string("{\"name\":\"request\",\"cat\":\"dmp\",\"ph\":\"") + phase + "\",\"bp\":\"e\",\"id\":" + id +
+				",\"pid\":1,\"tid\":" + thread + ",\"ts\":" + timestamp + "},\n";
+		}
+
+		// Trailing comma is not allowed
+		output.erase(output.size() - 2);
+		output += "\n]}\n";
+
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			ERROR("Trace could not be written to {0}", path);
+			return false;
+		}
+
+		file << output;
+		INFO("Trace with {0} spans written to {1}", spans.size(), path);
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace Core
+{
+	struct SpanRecord
+	{
+		const char* Name; // Span names are literals
+		uint64_t TraceId;
+		int64_t Start; // Microseconds (Tracing::GetTime)
+		int64_t End;
+	};
+
+	// Spans of sampled requests, from socket read to socket write
+	// Every thread records into it's own buffer, buffers are exported together as Chrome trace-event JSON (Perfetto, chrome://tracing)
+	class Tracing
+	{
+		Tracing() = delete;
+	public:
+		static constexpr uint32_t BufferCapacity = 64 * 1024; // Spans per thread, later spans are dropped
+
+		// Every sampleInterval-th request is traced, 0 disables tracing
+		static void Start(uint32_t sampleInterval);
+		static inline const bool IsEnabled() { return interval.load(std::memory_order_relaxed); }
+
+		// Returns id of new trace, 0 if request is not sampled
+		static inline uint64_t Sample()
+		{
+			uint32_t sampleInterval = interval.load(std::memory_order_relaxed);
+			if (!sampleInterval)
+				return 0;
+
+			static thread_local uint32_t requests = 0;
+			if (++requests % sampleInterval)
+				return 0;
+
+			return nextTraceId.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		static inline int64_t GetTime()
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		// Trace of request processed by this thread, spans without explicit trace belong to it
+		static inline uint64_t GetCurrentTrace() { return currentTrace; }
+		static inline void SetCurrentTrace(uint64_t traceId) { currentTrace = traceId; }
+
+		static void Record(const char* name, uint64_t traceId, int64_t start, int64_t end);
+
+		// Writes all spans recorded so far, spans of one request are connected by flow arrows
+		static bool Export(const std::string& path);
+	private:
+		static inline std::atomic<uint32_t> interval = 0;
+		static inline std::atomic<uint64_t> nextTraceId = 1;
+		static inline thread_local uint64_t currentTrace = 0;
+	};
+
+	// Makes trace current on this thread until end of scope
+	class TraceScope
+	{
+	public:
+		TraceScope(uint64_t traceId) : previous(Tracing::GetCurrentTrace()) { Tracing::SetCurrentTrace(traceId); }
+		~TraceScope() { Tracing::SetCurrentTrace(previous); }
+	private:
+		uint64_t previous;
+	};
+
+	// Records scope as span, costs only one branch if request is not sampled
+	class Span
+	{
+	public:
+		Span(const char* Name, uint64_t TraceId = Tracing::GetCurrentTrace()) : name(Name), traceId(TraceId), start(TraceId ? Tracing::GetTime() : 0) {}
+		~Span() { if (traceId) Tracing::Record(name, traceId, start, Tracing::GetTime()); }
+	private:
+		const char* name;
+		uint64_t traceId;
+		int64_t start;
+	};
+}
\ No newline at end of file
@@ -41,10 +41,11 @@ namespace Core
 	class ConnectedEvent : public NetworkEvent
 	{
 	public:
-		ConnectedEvent(const char* _domain, uint16_t _port) : domain(_domain), port(_port) {}
+		ConnectedEvent(const char* _domain, uint16_t _port, bool _resumed = false) : domain(_domain), port(_port), resumed(_resumed) {}
 
 		inline const char* GetDomain() const { return domain; }
 		inline const uint16_t GetPort() const { return port; }
+		inline const bool IsResumed() const { return resumed; } // Session of lost connection continues
 
 		static EventType GetStaticEventType() { return EventType::ConnectedEvent; }
 		EventType GetEventType() const override { return GetStaticEventType(); }
@@ -52,6 +53,7 @@ namespace Core
 	private:
 		const char* domain;
 		uint16_t port;
+		bool resumed;
 	};
 
 	class DisconnectedEvent : public NetworkEvent
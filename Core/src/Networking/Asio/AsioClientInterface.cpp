@@ -17,7 +17,7 @@ namespace Core
 		return new AsioClientInterface(domain.c_str(), port, inputMessageQueue);
 	}
 	
-	AsioClientInterface::AsioClientInterface(const char* domain, uint16_t port, MessageQueue& inputMessageQueue) : inputMessageQueue(inputMessageQueue), domain(domain), port(port)
+	AsioClientInterface::AsioClientInterface(const char* domain, uint16_t port, MessageQueue& inputMessageQueue) : reconnectTimer(context), inputMessageQueue(inputMessageQueue), domain(domain), port(port)
 	{
 		asio::ip::tcp::resolver resolver(context);
 		socket = new asio::ip::tcp::socket(context);
@@ -38,10 +38,32 @@ namespace Core
 			contextThread.join();
 	}
 
+	// Delay grows exponentially with failed attempts and half of it is random, so clients which lost connection at once don't come back at once
 	void AsioClientInterface::Reconnect()
 	{
-		asio::ip::tcp::resolver resolver(context);
-		Connect(resolver.resolve(domain, std::to_string(port)), port);
+		uint32_t delay = ReconnectBaseDelay << std::min(reconnectAttempts, 16u);
+		delay = std::min(delay, ReconnectMaxDelay);
+		delay = delay / 2 + std::uniform_int_distribution<uint32_t>(0, delay / 2)(random);
+
+		reconnectAttempts++;
+
+		reconnectTimer.expires_after(std::chrono::milliseconds(delay));
+		reconnectTimer.async_wait([this](std::error_code errorCode)
+		{
+			if (errorCode)
+				return;
+
+			asio::ip::tcp::resolver resolver(context);
+			auto endpoints = resolver.resolve(domain, std::to_string(port), errorCode);
+			if (errorCode)
+			{
+				ERROR("Failed to resolve {0}: {1}", domain, errorCode.message());
+				Reconnect();
+				return;
+			}
+
+			Connect(endpoints, port);
+		});
 	}
 
 	void AsioClientInterface::Disconnect()
@@ -56,16 +78,17 @@ namespace Core
 
 	void AsioClientInterface::Connect(const asio::ip::tcp::resolver::results_type& endpoints, uint16_t port)
 	{
-		asio::async_connect(socket.Get(), endpoints, [&](std::error_code errorCode, asio::ip::tcp::endpoint endpoint)
+		asio::async_connect(socket.Get(), endpoints, [this](std::error_code errorCode, asio::ip::tcp::endpoint endpoint)
 		{
 			if (!errorCode)
 			{
-				isConnected = true;
-
-				const std::string& _domain = socket->remote_endpoint().address().to_string();
-				ConnectedEvent event(_domain.c_str(), port);
-				Application::Get().OnEvent(event);
+				// Drop partially read message and send partially written one again from start
+				tempMessage = CreateRef<Message>();
+				chunkAssembler.Reset();
+				outputMessageQueue.Rewind();
 
+				// Queued messages wait until server answers, it tells which of sent ones it missed
+				SendResumeMessage();
 				ReadMessagePackets();
 			}
 			else
@@ -76,82 +99,249 @@ namespace Core
 		});
 	}
 
+	// Called by every failed operation, only the first one of connection reconnects
+	void AsioClientInterface::ConnectionLost(uint32_t lostConnection)
+	{
+		if (lostConnection != connection)
+			return;
+
+		connection++;
+
+		Disconnect();
+		Reconnect();
+	}
+
+	void AsioClientInterface::SendResumeMessage()
+	{
+		resumeHeader = MessageHeader();
+		resumeHeader.Type = MessageType::Resume;
+		resumeHeader.Size = sizeof(ResumeInfo);
+		resumeInfo.Received = receivedCount;
+		resumeInfo.Features = FrameCompression::GetFeatures();
+
+		std::array<asio::const_buffer, 2> buffers = {
+			asio::buffer(&resumeHeader, sizeof(MessageHeader)),
+			asio::buffer(&resumeInfo, sizeof(ResumeInfo))
+		};
+
+		asio::async_write(socket.Get(), buffers, [this, current = connection](std::error_code errorCode, std::size_t length)
+		{
+			if (errorCode)
+				ConnectionLost(current);
+		});
+	}
+
+	void AsioClientInterface::Resume(const ResumeInfo& info)
+	{
+		std::vector<Ref<Message>> unreceived;
+		bool resumed = info.Resumed;
+
+		if (!resumed)
+		{
+			// New session, messages server could have missed are lost
+			sentLog.Clear();
+			receivedCount = 0;
+		}
+		else if (!sentLog.GetUnreceived(info.Received, unreceived))
+		{
+			WARN("Messages lost with connection are not kept anymore");
+			resumed = false;
+		}
+
+		resumeInfo.Token = info.Token;
+		features = info.Features;
+		reconnectAttempts = 0;
+		isConnected = true;
+
+		// Missed messages go before queued ones
+		outputMessageQueue.Resend(unreceived);
+
+		ConnectedEvent event(domain, port, resumed);
+		Application::Get().OnEvent(event);
+
+		if (outputMessageQueue.GetCount())
+			SendMessageQueue();
+	}
+
 	void AsioClientInterface::SendMessagePackets(Ref<Message>& message)
 	{
 		asio::post(context, [this, message]()
 		{
-			if (!outputMessageQueue.GetCount())
-			{
-				outputMessageQueue.Add(message);
+			bool idle = !outputMessageQueue.GetCount();
+			outputMessageQueue.Add(message);
+
+			// Messages queued without connection are sent after resume
+			if (idle && isConnected)
 				SendMessageQueue();
-			}
-			else
-				outputMessageQueue.Add(message);
 		});
 	}
 
 	void AsioClientInterface::SendMessageQueue()
 	{
-		asio::async_write(socket.Get(), asio::buffer(&outputMessageQueue.Get().Header, sizeof(MessageHeader)), [&](std::error_code errorCode, std::size_t length)
+		const OutputFrame& frame = outputMessageQueue.Front();
+
+		// Write header and body of the frame at once
+		std::array<asio::const_buffer, 2> buffers = {
+			asio::buffer(&frame.Header, sizeof(MessageHeader)),
+			asio::buffer(frame.Data, frame.Header.Size)
+		};
+
+		if ((features & (uint32_t)ConnectionFeatures::Compression) && FrameCompression::Compress(frame, compressedHeader, compressedOutput))
+			buffers = { asio::buffer(&compressedHeader, sizeof(MessageHeader)), asio::buffer(compressedOutput.data(), compressedHeader.Size) };
+
+		asio::async_write(socket.Get(), buffers, [this, current = connection](std::error_code errorCode, std::size_t length)
 		{
 			if (errorCode)
 			{
-				Disconnect();
-				Reconnect();
+				ConnectionLost(current);
 				return;
 			}
 
-			asio::async_write(socket.Get(), asio::buffer(outputMessageQueue.Get().Body.Content->GetDataAs<uint8_t>(), outputMessageQueue.Get().Header.Size), [&](std::error_code errorCode, std::size_t length)
+			const OutputFrame& frame = outputMessageQueue.GetCurrentFrame();
+			if (frame.IsLast)
 			{
-				if (errorCode)
-				{
-					Disconnect();
-					Reconnect();
-					return;
-				}
+				sentLog.Add(frame.Source);
 
-				MessageSentEvent event(outputMessageQueue.Get());
+				MessageSentEvent event(frame.Source.Get());
 				Application::Get().OnEvent(event);
+			}
 
-				outputMessageQueue.Pop();
+			outputMessageQueue.Pop();
 
-				if (outputMessageQueue.GetCount())
-					SendMessageQueue();
-			});
+			if (outputMessageQueue.GetCount())
+				SendMessageQueue();
 		});
 	}
 
 	void AsioClientInterface::ReadMessagePackets()
 	{
-		asio::async_read(socket.Get(), asio::buffer(&tempMessage->Header, sizeof(tempMessage->Header)), [&](std::error_code errorCode, std::size_t length)
+		asio::async_read(socket.Get(), asio::buffer(&tempMessage->Header, sizeof(tempMessage->Header)), [this, current = connection](std::error_code errorCode, std::size_t length)
 		{
 			if (errorCode)
 			{
-				Disconnect();
-				Reconnect();
+				ConnectionLost(current);
+				return;
+			}
+
+			if (tempMessage->HasFlag(MessageFlags::Compressed))
+			{
+				ReadCompressedFrame();
+				return;
+			}
+
+			if (tempMessage->HasFlag(MessageFlags::Chunk))
+			{
+				ReadMessageChunk();
 				return;
 			}
 
 			tempMessage->Body.Content = CreateRef<Buffer>(tempMessage->Header.Size);
 
-			asio::async_read(socket.Get(), asio::buffer(tempMessage->Body.Content->GetDataAs<uint8_t>(), tempMessage->Header.Size), [&](std::error_code errorCode, std::size_t length)
+			asio::async_read(socket.Get(), asio::buffer(tempMessage->Body.Content->GetDataAs<uint8_t>(), tempMessage->Header.Size), [this, current](std::error_code errorCode, std::size_t length)
 			{
 				if (errorCode)
 				{
-					Disconnect();
-					Reconnect();
+					ConnectionLost(current);
 					return;
 				}
 
-				inputMessageQueue.Add(tempMessage);
-
-				MessageAcceptedEvent event(tempMessage.Get());
-				Application::Get().OnEvent(event);
-
+				AcceptMessage(tempMessage);
 				tempMessage = CreateRef<Message>();
 
 				ReadMessagePackets();
 			});
 		});
 	}
+
+	void AsioClientInterface::ReadMessageChunk()
+	{
+		// Chunk body is read straight into reassembled message
+		uint8_t* target = chunkAssembler.Prepare(tempMessage->Header);
+		if (!target)
+		{
+			ConnectionLost(connection);
+			return;
+		}
+
+		asio::async_read(socket.Get(), asio::buffer(target, tempMessage->Header.Size), [this, current = connection](std::error_code errorCode, std::size_t length)
+		{
+			if (errorCode)
+			{
+				ConnectionLost(current);
+				return;
+			}
+
+			Ref<Message> message = chunkAssembler.Complete(tempMessage->Header);
+			if (message)
+				AcceptMessage(message);
+
+			ReadMessagePackets();
+		});
+	}
+
+	// Frame is read whole and decompressed into body of message or it's chunk
+	void AsioClientInterface::ReadCompressedFrame()
+	{
+		compressedInput.resize(tempMessage->Header.Size);
+
+		asio::async_read(socket.Get(), asio::buffer(compressedInput), [this, current = connection](std::error_code errorCode, std::size_t length)
+		{
+			if (errorCode)
+			{
+				ConnectionLost(current);
+				return;
+			}
+
+			MessageHeader& header = tempMessage->Header;
+			header.Size = FrameCompression::GetRawSize(compressedInput);
+			header.Flags &= ~(uint32_t)MessageFlags::Compressed;
+
+			bool chunk = tempMessage->HasFlag(MessageFlags::Chunk);
+			uint8_t* target = nullptr;
+			if (header.Size && chunk)
+				target = chunkAssembler.Prepare(header);
+			else if (header.Size)
+			{
+				tempMessage->Body.Content = CreateRef<Buffer>(header.Size);
+				target = tempMessage->Body.Content->GetDataAs<uint8_t>();
+			}
+
+			if (!target || !FrameCompression::Decompress(compressedInput, target, header.Size))
+			{
+				ConnectionLost(current);
+				return;
+			}
+
+			if (chunk)
+			{
+				Ref<Message> message = chunkAssembler.Complete(header);
+				if (message)
+					AcceptMessage(message);
+			}
+			else
+			{
+				AcceptMessage(tempMessage);
+				tempMessage = CreateRef<Message>();
+			}
+
+			ReadMessagePackets();
+		});
+	}
+
+	void AsioClientInterface::AcceptMessage(Ref<Message>& message)
+	{
+		if (message->GetType() == MessageType::Resume)
+		{
+			if (message->Header.Size == sizeof(ResumeInfo))
+				Resume(*message->Body.Content->GetDataAs<ResumeInfo>());
+
+			return;
+		}
+
+		receivedCount++;
+		inputMessageQueue.Add(message);
+
+		MessageAcceptedEvent event(message.Get());
+		Application::Get().OnEvent(event);
+	}
 }
\ No newline at end of file
@@ -1,12 +1,20 @@
 #pragma once
 #include <asio.hpp>
+#include <random>
 #include "Networking/NetworkClientInterface.h"
+#include "Networking/OutputQueue.h"
+#include "Networking/ChunkAssembler.h"
+#include "Networking/SentLog.h"
+#include "Networking/FrameCompression.h"
 
 namespace Core
 {
 	class AsioClientInterface : public NetworkClientInterface
 	{
 	public:
+		static inline uint32_t ReconnectBaseDelay = 250; // ms, delay before first reconnect, doubled with every failed one
+		static inline uint32_t ReconnectMaxDelay = 30000; // ms
+
 		AsioClientInterface(const char* domain, uint16_t port, MessageQueue& inputMessageQueue);
 		~AsioClientInterface();
 
@@ -20,7 +28,13 @@ namespace Core
 		virtual void ReadMessagePackets() override;
 	private:
 		void Connect(const asio::ip::tcp::resolver::results_type& endpoints, uint16_t port);
+		void ConnectionLost(uint32_t lostConnection);
+		void SendResumeMessage();
+		void Resume(const ResumeInfo& info);
 		void SendMessageQueue();
+		void ReadMessageChunk();
+		void ReadCompressedFrame();
+		void AcceptMessage(Ref<Message>& message);
 
 		asio::error_code errorCode;
 		asio::io_context context;
@@ -30,13 +44,30 @@ namespace Core
 
 		std::thread contextThread;
 
+		asio::steady_timer reconnectTimer;
+		uint32_t reconnectAttempts = 0; // Failed since last connection
+		std::mt19937 random = std::mt19937(std::random_device()());
+
 		Ref<Message> tempMessage = CreateRef<Message>();
 		MessageQueue& inputMessageQueue;
-		MessageQueue outputMessageQueue;
+		OutputQueue outputMessageQueue;
+		ChunkAssembler chunkAssembler;
+
+		// Session is resumed after reconnect, messages lost with connection are sent again by both sides
+		MessageHeader resumeHeader;
+		ResumeInfo resumeInfo;
+		uint64_t receivedCount = 0; // Messages received in session
+		SentLog sentLog;
+		uint32_t connection = 0; // Incremented with every lost connection, handlers of older connection are ignored
+
+		uint32_t features = 0; // Mask of ConnectionFeatures agreed with server
+		MessageHeader compressedHeader;
+		std::vector<uint8_t> compressedOutput;
+		std::vector<uint8_t> compressedInput;
 
 		const char* domain;
 		uint16_t port;
 
-		bool isConnected = false;
+		std::atomic<bool> isConnected = false; // Set after session is resumed or started
 	};
 }
\ No newline at end of file
@@ -1,10 +1,57 @@
 #include "pch.h"
 #include "AsioServerInterface.h"
+#include "AsioSession.h"
 #include "AsioUtilities.h"
 #include "Core/Application.h"
+#include "Debugging/Log.h"
+#include "Debugging/Metrics.h"
 
 namespace Core
 {
+	// Connection of stats endpoint, request is read whole and answered with one response
+	struct StatsConnection
+	{
+		StatsConnection(asio::ip::tcp::socket Socket) : Socket(std::move(Socket)) {}
+
+		asio::ip::tcp::socket Socket;
+		asio::streambuf Request = asio::streambuf(8 * 1024);
+		std::string Response;
+	};
+
+	static void ServeStats(Ref<StatsConnection> connection)
+	{
+		asio::async_read_until(connection->Socket, connection->Request, "\r\n\r\n", [connection](std::error_code errorCode, std::size_t length)
+		{
+			// Connection is closed with last reference
+			if (errorCode)
+				return;
+
+			std::istream request(&connection->Request);
+			std::string method, path;
+			request >> method >> path;
+
+			std::string status = "200 OK";
+			std::string body;
+			if (method != "GET")
+				status = "405 Method Not Allowed";
+			else if (path == "/metrics" || path == "/")
+				Metrics::WriteText(body);
+			else
+				status = "404 Not Found";
+
+			connection->Response = "HTTP/1.1 " + status + "\r\n"
+				"Content-Type: text/plain; version=0.0.4\r\n"
+				"Content-Length: " + std::to_string(body.size()) + "\r\n"
+				"Connection: close\r\n\r\n" + body;
+
+			asio::async_write(connection->Socket, asio::buffer(connection->Response), [connection](std::error_code errorCode, std::size_t length)
+			{
+				std::error_code ignored;
+				connection->Socket.shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+			});
+		});
+	}
+
 	Ref<NetworkServerInterface> NetworkServerInterface::Create(uint16_t port, Core::MessageQueue& inputMessageQueue, std::deque<Ref<Core::Session>>& sesionQueue)
 	{
 		return new AsioServerInterface(port, inputMessageQueue, sesionQueue);
@@ -22,65 +69,219 @@ namespace Core
 
 		if (contextThread.joinable())
 			contextThread.join();
+
+		// Sockets of sessions belong to context, so sessions are destroyed before it
+		resumableSessions.clear();
+		sessions.clear();
 	}
 
 	void AsioServerInterface::DisconnectAllClients()
 	{
-		for (Ref<Session> session : sessions)
 		{
-			if (session && session->IsOpen())
-				session->Disconnect();
+			std::scoped_lock lock(sessionsMutex);
+			for (const Ref<Session>& session : sessions)
+			{
+				if (session && session->IsOpen())
+					session->Disconnect();
+			}
 		}
+
+		// Clients have to start new sessions, state kept in old ones could be outdated
+		asio::post(context, [this]()
+		{
+			std::scoped_lock lock(sessionsMutex);
+			resumableSessions.clear();
+		});
 	}
 
+	// Messages for session which can be resumed are queued in it
 	void AsioServerInterface::SendMessagePackets(Ref<Message>& message)
 	{
-		Ref<Session> session = FindSessionById(message->GetSessionId());
+		std::scoped_lock lock(sessionsMutex);
+
+		auto session = std::find_if(sessions.begin(), sessions.end(), [&](const Ref<Session>& session) {
+			return session->GetId() == message->GetSessionId();
+		});
 
-		if (session && session->IsOpen())
-			session->SendMessagePackets(message);
+		if (session == sessions.end())
+			return;
+
+		if ((*session)->IsOpen() || (*session)->IsResumable())
+			(*session)->SendMessagePackets(message);
 		else
-			sessions.erase(std::remove(sessions.begin(), sessions.end(), session), sessions.end());
+			sessions.erase(session);
 	}
 
 	void AsioServerInterface::SendMessagePacketsToAllClients(Ref<Message>& message)
 	{
-		for (Ref<Session> session : sessions)
+		std::scoped_lock lock(sessionsMutex);
+		for (const Ref<Session>& session : sessions)
 		{
-			if (session && session->IsOpen())
+			if (session && (session->IsOpen() || session->IsResumable()))
 				session->SendMessagePackets(message);
 		}
 	}
 
 	Ref<Session> AsioServerInterface::FindSessionById(uint32_t SessionId)
 	{
-		auto session = std::find_if(sessions.begin(), sessions.end(), [&](Ref<Session> session) {
+		std::scoped_lock lock(sessionsMutex);
+		auto session = std::find_if(sessions.begin(), sessions.end(), [&](const Ref<Session>& session) {
 			return session->GetId() == SessionId;
 		});
 
 		return session != sessions.end() ? *session : Ref<Session>();
 	}
 
+	// Sessions are added on network thread, so none is added after this runs
+	void AsioServerInterface::StopAccepting()
+	{
+		asio::post(context, [this]()
+		{
+			std::error_code ignored;
+			acceptor.close(ignored);
+
+			std::scoped_lock lock(sessionsMutex);
+			for (const Ref<Session>& session : sessions)
+				session->StopReceiving();
+		});
+	}
+
+	// Messages of lost connections wait for resume which won't come
+	uint32_t AsioServerInterface::GetQueuedCount()
+	{
+		std::scoped_lock lock(sessionsMutex);
+
+		uint32_t count = 0;
+		for (const Ref<Session>& session : sessions)
+		{
+			if (session && session->IsOpen() && !session->IsResumable())
+				count += session->GetQueuedCount();
+		}
+
+		return count;
+	}
+
+	bool AsioServerInterface::StartStatsEndpoint(uint16_t port)
+	{
+		// Only reachable from the machine itself, metrics are not meant to be public
+		asio::ip::tcp::endpoint endpoint(asio::ip::address_v4::loopback(), port);
+
+		statsAcceptor = new asio::ip::tcp::acceptor(context);
+		statsAcceptor->open(endpoint.protocol(), errorCode);
+		if (!errorCode)
+			statsAcceptor->set_option(asio::ip::tcp::acceptor::reuse_address(true), errorCode);
+		if (!errorCode)
+			statsAcceptor->bind(endpoint, errorCode);
+		if (!errorCode)
+			statsAcceptor->listen(asio::socket_base::max_listen_connections, errorCode);
+
+		if (errorCode)
+		{
+			ERROR("Stats endpoint could not be started on port {0}: {1}", port, errorCode.message());
+			return false;
+		}
+
+		// Accepting is started on network thread, acceptor is used only there
+		asio::post(context, [this]() { AcceptStatsClient(); });
+
+		INFO("Stats endpoint running on http://127.0.0.1:{0}/metrics", port);
+		return true;
+	}
+
+	void AsioServerInterface::AcceptStatsClient()
+	{
+		statsAcceptor->async_accept([this](std::error_code errorCode, asio::ip::tcp::socket socket)
+		{
+			if (!statsAcceptor->is_open())
+				return;
+
+			if (!errorCode)
+				ServeStats(new StatsConnection(std::move(socket)));
+
+			AcceptStatsClient();
+		});
+	}
+
 	void AsioServerInterface::AcceptClient()
 	{
 		acceptor.async_accept([this](std::error_code errorCode, asio::ip::tcp::socket socket)
 		{
+			if (!acceptor.is_open())
+				return;
+
 			if (!errorCode)
+				Handshake(new PendingConnection(std::move(socket)));
+
+			AcceptClient();
+		});
+	}
+
+	// Client starts every connection with Resume message, session is continued if it's token belongs to session which is still kept
+	void AsioServerInterface::Handshake(Ref<PendingConnection> connection)
+	{
+		std::array<asio::mutable_buffer, 2> buffers = {
+			asio::buffer(&connection->Header, sizeof(MessageHeader)),
+			asio::buffer(&connection->Info, sizeof(ResumeInfo))
+		};
+
+		asio::async_read(connection->Socket, buffers, [this, connection](std::error_code errorCode, std::size_t length)
+		{
+			// Connection is closed with last reference, connections accepted before StopAccepting are dropped too
+			if (errorCode || !acceptor.is_open() || connection->Header.Type != MessageType::Resume || connection->Header.Size != sizeof(ResumeInfo))
+				return;
+
+			asio::ip::tcp::endpoint endpoint = connection->Socket.remote_endpoint(errorCode);
+			if (errorCode)
+				return;
+
+			const std::string& sessionDomain = endpoint.address().to_string();
+			uint16_t port = endpoint.port();
+
+			// Compression is used only if client supports it too
+			uint32_t features = connection->Info.Features & FrameCompression::GetFeatures();
+
+			bool resumed;
 			{
-				const std::string& sessionDomain = socket.remote_endpoint().address().to_string();
-				uint16_t port = socket.remote_endpoint().port();
+				// Session references are counted without atomics, so they are copied and released only under lock
+				std::scoped_lock lock(sessionsMutex);
+
+				// Sessions which were not resumed in time are forgotten
+				std::erase_if(resumableSessions, [](const auto& entry) { return !entry.second->IsOpen() && !entry.second->IsResumable(); });
 
-				AsioContext con(context);
-				AsioSocket soc(socket);
+				Ref<Session> session;
+				auto resumable = resumableSessions.find(connection->Info.Token);
+				if (resumable != resumableSessions.end())
+				{
+					session = resumable->second;
+					resumableSessions.erase(resumable);
 
-				Ref<Session> session = Session::Create(&con, &soc, inputMessageQueue);
-				sessions.push_back(session);
+					if (!((AsioSession*)session.GetPtr())->Resume(connection->Socket, connection->Info.Received, features))
+						session = Ref<Session>();
+				}
 
-				ConnectedEvent event(sessionDomain.c_str(), port);
-				Application::Get().OnEvent(event);
+				resumed = session;
+				if (resumed)
+				{
+					// Main thread could have removed session right when it expired
+					if (std::find(sessions.begin(), sessions.end(), session) == sessions.end())
+						sessions.push_back(session);
+				}
+				else
+				{
+					AsioContext con(context);
+					AsioSocket soc(connection->Socket);
+
+					session = Session::Create(&con, &soc, inputMessageQueue);
+					sessions.push_back(session);
+
+					((AsioSession*)session.GetPtr())->Start(features);
+				}
+
+				resumableSessions[session->GetResumeToken()] = session;
 			}
 
-			AcceptClient();
+			ConnectedEvent event(sessionDomain.c_str(), port, resumed);
+			Application::Get().OnEvent(event);
 		});
 	}
 }
\ No newline at end of file
@@ -19,16 +19,37 @@ namespace Core
 		virtual void SendMessagePacketsToAllClients(Ref<Message>& message) override;
 
 		virtual Ref<Session> FindSessionById(uint32_t SessionId) override;
+
+		virtual void StopAccepting() override;
+		virtual uint32_t GetQueuedCount() override;
+
+		virtual bool StartStatsEndpoint(uint16_t port) override;
 	private:
+		// Connection before it's Resume message is read
+		struct PendingConnection
+		{
+			PendingConnection(asio::ip::tcp::socket Socket) : Socket(std::move(Socket)) {}
+
+			asio::ip::tcp::socket Socket;
+			MessageHeader Header;
+			ResumeInfo Info;
+		};
+
 		void AcceptClient();
+		void AcceptStatsClient();
+		void Handshake(Ref<PendingConnection> connection);
 
 		asio::error_code errorCode;
 		asio::io_context context;
 		asio::ip::tcp::acceptor acceptor;
+		Ref<asio::ip::tcp::acceptor> statsAcceptor;
 
 		std::thread contextThread;
 
 		Core::MessageQueue& inputMessageQueue;
+		// Sessions are added on network thread and removed on main thread, both containers are guarded by sessionsMutex
+		std::mutex sessionsMutex;
 		std::deque<Ref<Session>>& sessions;
+		std::unordered_map<uint64_t, Ref<Session>> resumableSessions; // By resume token
 	};
 }
\ No newline at end of file
@@ -1,90 +1,223 @@
 #include "pch.h"
 #include "AsioSession.h"
+#include <random>
 #include "AsioUtilities.h"
 #include "Core/Application.h"
 #include "Event/NetworkEvent.h"
+#include "Debugging/Metrics.h"
+#include "Debugging/Tracing.h"
 
 namespace Core
 {
+	static Counter receivedBytes = Metrics::GetCounter("net_received_bytes_total");
+	static Counter receivedMessages = Metrics::GetCounter("net_received_messages_total");
+	static Counter sentBytes = Metrics::GetCounter("net_sent_bytes_total");
+	static Counter sentMessages = Metrics::GetCounter("net_sent_messages_total");
+	static Counter sessionsTotal = Metrics::GetCounter("net_sessions_total");
+	static Gauge sessionsOpen = Metrics::GetGauge("net_sessions_open");
+	static Counter sessionsResumed = Metrics::GetCounter("net_sessions_resumed_total");
+
+	static int64_t GetSeconds()
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Token is the only proof of session ownership, so it has to be unpredictable
+	static uint64_t CreateResumeToken()
+	{
+		static std::random_device device;
+
+		uint64_t token = 0;
+		while (!token)
+			token = ((uint64_t)device() << 32) | device();
+
+		return token;
+	}
+
 	Ref<Session> Session::Create(Context* context, Socket* socket, MessageQueue& inputMessageQueue)
 	{
 		return new AsioSession(((AsioContext*)context)->context, std::move(((AsioSocket*)socket)->socket), inputMessageQueue);
 	}
 
-	AsioSession::AsioSession(asio::io_context& Context, asio::ip::tcp::socket Socket, MessageQueue& inputMessageQueue) : Session(), context(Context), socket(std::move(Socket)), inputMessageQueue(inputMessageQueue)
+	AsioSession::AsioSession(asio::io_context& Context, asio::ip::tcp::socket Socket, MessageQueue& inputMessageQueue) : Session(), context(Context), socket(std::move(Socket)), inputMessageQueue(inputMessageQueue), resumeToken(CreateResumeToken())
 	{
+		sessionsTotal.Add();
+		sessionsOpen.Add();
+
 		ReadMessagePackets();
 	}
 
+	const bool AsioSession::IsResumable() const
+	{
+		return disconnected.load() && GetSeconds() - disconnectedAt.load() < ResumeTimeout;
+	}
+
+	void AsioSession::Start(uint32_t Features)
+	{
+		features = Features;
+		SendResumeMessage(false, {});
+	}
+
+	bool AsioSession::Resume(asio::ip::tcp::socket& Socket, uint64_t peerReceived, uint32_t Features)
+	{
+		std::vector<Ref<Message>> unreceived;
+		if (!sentLog.GetUnreceived(peerReceived, unreceived))
+			return false;
+
+		// Old connection can be still open if it's loss wasn't noticed yet
+		connection++;
+		std::error_code ignored;
+		socket.close(ignored);
+		socket = std::move(Socket);
+
+		if (disconnected.exchange(false))
+			sessionsOpen.Add();
+
+		// Drop partially read message and send partially written one again from start
+		tempMessage = CreateRef<Message>();
+		chunkAssembler.Reset();
+		outputMessageQueue.Rewind();
+
+		sessionsResumed.Add();
+		features = Features;
+
+		SendResumeMessage(true, unreceived);
+		ReadMessagePackets();
+
+		return true;
+	}
+
+	// Answer goes before messages client missed and messages queued meanwhile, no write can be in progress
+	void AsioSession::SendResumeMessage(bool resumed, const std::vector<Ref<Message>>& unreceived)
+	{
+		Ref<Message> message = CreateRef<Message>();
+		message->Header.Type = MessageType::Resume;
+		message->Header.SessionId = id;
+		message->CreateBody(ResumeInfo{ resumeToken, receivedCount, resumed, features });
+
+		std::vector<Ref<Message>> messages = { message };
+		messages.insert(messages.end(), unreceived.begin(), unreceived.end());
+		outputMessageQueue.Resend(messages);
+
+		SendMessageQueue();
+	}
+
 	void Core::AsioSession::SendMessagePackets(Ref<Message>& message)
 	{
+		if (message->TraceId)
+			message->QueuedAt = Tracing::GetTime();
+
+		posted.fetch_add(1, std::memory_order_relaxed);
+
 		asio::post(context, [this, message]()
 		{
-			if (!outputMessageQueue.GetCount())
-			{
-				outputMessageQueue.Add(message);
+			bool idle = !outputMessageQueue.GetCount();
+			outputMessageQueue.Add(message);
+			posted.fetch_sub(1, std::memory_order_release);
+
+			// Messages for lost connection wait for resume
+			if (idle && !disconnected)
 				SendMessageQueue();
-			}
-			else
-				outputMessageQueue.Add(message);
 		});
 	}
 
 	void AsioSession::SendMessageQueue()
 	{
-		asio::async_write(socket, asio::buffer(&outputMessageQueue.Get().Header, sizeof(MessageHeader)), [&](std::error_code errorCode, std::size_t length)
+		const OutputFrame& frame = outputMessageQueue.Front();
+
+		// Write header and body of the frame at once
+		std::array<asio::const_buffer, 2> buffers = {
+			asio::buffer(&frame.Header, sizeof(MessageHeader)),
+			asio::buffer(frame.Data, frame.Header.Size)
+		};
+
+		if ((features & (uint32_t)ConnectionFeatures::Compression) && FrameCompression::Compress(frame, compressedHeader, compressedOutput))
+			buffers = { asio::buffer(&compressedHeader, sizeof(MessageHeader)), asio::buffer(compressedOutput.data(), compressedHeader.Size) };
+
+		asio::async_write(socket, buffers, [this, current = connection.load()](std::error_code errorCode, std::size_t length)
 		{
+			// Connection was replaced by resume
+			if (current != connection)
+				return;
+
 			if (errorCode)
 			{
 				Disconnect();
 				return;
 			}
 
-			asio::async_write(socket, asio::buffer(outputMessageQueue.Get().Body.Content->GetDataAs<uint8_t>(), outputMessageQueue.Get().Header.Size), [&](asio::error_code errorCode, std::size_t length)
+			sentBytes.Add(length);
+
+			const OutputFrame& frame = outputMessageQueue.GetCurrentFrame();
+			if (frame.IsLast)
 			{
-				if (errorCode)
-				{
-					Disconnect();
-					return;
-				}
+				sentMessages.Add();
 
-				MessageSentEvent event(outputMessageQueue.Get());
+				// Resume answers are not part of session, client doesn't count them
+				if (frame.Source->GetType() != MessageType::Resume)
+					sentLog.Add(frame.Source);
+
+				if (frame.Source->TraceId)
+					Tracing::Record("net.write", frame.Source->TraceId, frame.Source->QueuedAt, Tracing::GetTime());
+
+				MessageSentEvent event(frame.Source.Get());
 				Application::Get().OnEvent(event);
+			}
 
-				outputMessageQueue.Pop();
+			outputMessageQueue.Pop();
 
-				if (outputMessageQueue.GetCount())
-					SendMessageQueue();
-			});
+			if (outputMessageQueue.GetCount())
+				SendMessageQueue();
 		});
 	}
 
 	void AsioSession::ReadMessagePackets()
 	{
-		asio::async_read(socket, asio::buffer(&tempMessage->Header, sizeof(MessageHeader)), [&](std::error_code errorCode, std::size_t length)
+		asio::async_read(socket, asio::buffer(&tempMessage->Header, sizeof(MessageHeader)), [this, current = connection.load()](std::error_code errorCode, std::size_t length)
 		{
+			if (current != connection)
+				return;
+
 			if (errorCode)
 			{
 				Disconnect();
 				return;
 			}
 
+			receivedBytes.Add(length);
+
+			if (Tracing::IsEnabled())
+				tempMessage->ReceivedAt = Tracing::GetTime();
+
+			if (tempMessage->HasFlag(MessageFlags::Compressed))
+			{
+				ReadCompressedFrame();
+				return;
+			}
+
+			if (tempMessage->HasFlag(MessageFlags::Chunk))
+			{
+				ReadMessageChunk();
+				return;
+			}
+
 			tempMessage->Body.Content = CreateRef<Buffer>(tempMessage->Header.Size);
 			tempMessage->Header.SessionId = id;
 
-			asio::async_read(socket, asio::buffer(tempMessage->Body.Content->GetDataAs<uint8_t>(), tempMessage->Header.Size), [&](std::error_code errorCode, std::size_t length)
+			asio::async_read(socket, asio::buffer(tempMessage->Body.Content->GetDataAs<uint8_t>(), tempMessage->Header.Size), [this, current](std::error_code errorCode, std::size_t length)
 			{
+				if (current != connection)
+					return;
+
 				if (errorCode)
 				{
 					Disconnect();
 					return;
 				}
 
-				inputMessageQueue.Add(tempMessage);
-
-				MessageAcceptedEvent event(tempMessage.Get());
-				Application::Get().OnEvent(event);
+				receivedBytes.Add(length);
 
+				AcceptMessage(tempMessage);
 				tempMessage = CreateRef<Message>();
 
 				ReadMessagePackets();
@@ -92,11 +225,150 @@ namespace Core
 		});
 	}
 
+	void AsioSession::ReadMessageChunk()
+	{
+		// Chunk body is read straight into reassembled message
+		uint8_t* target = chunkAssembler.Prepare(tempMessage->Header);
+		if (!target)
+		{
+			Disconnect();
+			return;
+		}
+
+		asio::async_read(socket, asio::buffer(target, tempMessage->Header.Size), [this, current = connection.load()](std::error_code errorCode, std::size_t length)
+		{
+			if (current != connection)
+				return;
+
+			if (errorCode)
+			{
+				Disconnect();
+				return;
+			}
+
+			receivedBytes.Add(length);
+
+			Ref<Message> message = chunkAssembler.Complete(tempMessage->Header);
+			if (message)
+				AcceptMessage(message);
+
+			ReadMessagePackets();
+		});
+	}
+
+	// Frame is read whole and decompressed into body of message or it's chunk
+	void AsioSession::ReadCompressedFrame()
+	{
+		compressedInput.resize(tempMessage->Header.Size);
+
+		asio::async_read(socket, asio::buffer(compressedInput), [this, current = connection.load()](std::error_code errorCode, std::size_t length)
+		{
+			if (current != connection)
+				return;
+
+			if (errorCode)
+			{
+				Disconnect();
+				return;
+			}
+
+			receivedBytes.Add(length);
+
+			MessageHeader& header = tempMessage->Header;
+			header.Size = FrameCompression::GetRawSize(compressedInput);
+			header.Flags &= ~(uint32_t)MessageFlags::Compressed;
+
+			bool chunk = tempMessage->HasFlag(MessageFlags::Chunk);
+			uint8_t* target = nullptr;
+			if (header.Size && chunk)
+				target = chunkAssembler.Prepare(header);
+			else if (header.Size)
+			{
+				tempMessage->Body.Content = CreateRef<Buffer>(header.Size);
+				target = tempMessage->Body.Content->GetDataAs<uint8_t>();
+			}
+
+			if (!target || !FrameCompression::Decompress(compressedInput, target, header.Size))
+			{
+				Disconnect();
+				return;
+			}
+
+			if (chunk)
+			{
+				Ref<Message> message = chunkAssembler.Complete(header);
+				if (message)
+					AcceptMessage(message);
+			}
+			else
+			{
+				AcceptMessage(tempMessage);
+				tempMessage = CreateRef<Message>();
+			}
+
+			ReadMessagePackets();
+		});
+	}
+
+	void AsioSession::AcceptMessage(Ref<Message>& message)
+	{
+		// Only the first message of connection can be Resume, it's read before session is found
+		if (message->GetType() == MessageType::Resume)
+			return;
+
+		// Server is stopping, message is lost like messages of session which is not resumed
+		if (!receiving)
+			return;
+
+		message->Header.SessionId = id;
+		receivedCount++;
+
+		// Framing span covers reading header and body (all chunks)
+		message->TraceId = Tracing::Sample();
+		if (message->TraceId)
+		{
+			message->QueuedAt = Tracing::GetTime();
+			Tracing::Record("net.read", message->TraceId, message->ReceivedAt, message->QueuedAt);
+		}
+
+		inputMessageQueue.Add(message);
+		receivedMessages.Add();
+
+		MessageAcceptedEvent event(message.Get());
+		Application::Get().OnEvent(event);
+	}
+
+	// Socket is still read, so client's writes don't stall and lost connection is noticed
+	void AsioSession::StopReceiving()
+	{
+		receiving = false;
+	}
+
+	// Posted count is read first, message leaves it only after it's added to queue
+	const uint32_t AsioSession::GetQueuedCount()
+	{
+		uint32_t count = posted.load(std::memory_order_acquire);
+		return count + outputMessageQueue.GetCount();
+	}
+
 	void AsioSession::Disconnect()
 	{
-		asio::post(context, [this]() { socket.close(); });
+		// Disconnect is called by every failed operation, session is counted only once
+		// Time is set before flag, so session is never seen disconnected without it
+		if (!disconnected)
+			disconnectedAt = GetSeconds();
+
+		if (!disconnected.exchange(true))
+			sessionsOpen.Sub();
+
+		// Socket of connection which replaced this one by resume is not closed
+		asio::post(context, [this, current = connection.load()]()
+		{
+			if (current == connection)
+				socket.close();
+		});
 
 		DisconnectedEvent event;
 		Application::Get().OnEvent(event);
 	}
-}
\ No newline at end of file
+}
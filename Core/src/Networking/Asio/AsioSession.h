@@ -1,6 +1,10 @@
 #pragma once
 #include <asio.hpp>
 #include "Networking/Session.h"
+#include "Networking/OutputQueue.h"
+#include "Networking/ChunkAssembler.h"
+#include "Networking/SentLog.h"
+#include "Networking/FrameCompression.h"
 
 namespace Core
 {
@@ -10,19 +14,51 @@ namespace Core
 		AsioSession(asio::io_context& Context, asio::ip::tcp::socket Socket, MessageQueue& inputMessageQueue);
 
 		inline virtual const bool IsOpen() const override { return socket.is_open(); };
+		virtual const bool IsResumable() const override;
+		inline virtual const uint64_t GetResumeToken() const override { return resumeToken; }
 
 		virtual void SendMessagePackets(Ref<Message>& message) override;
 		virtual void ReadMessagePackets() override;
 
 		virtual void Disconnect() override;
+
+		virtual void StopReceiving() override; // Called on network thread
+		virtual const uint32_t GetQueuedCount() override;
+
+		// Called on network thread after client's Resume message, both send Resume answer before everything else
+		// Features are the ones both sides support
+		void Start(uint32_t features);
+		bool Resume(asio::ip::tcp::socket& Socket, uint64_t peerReceived, uint32_t features); // False if messages client missed are not kept anymore
 	private:
+		void SendResumeMessage(bool resumed, const std::vector<Ref<Message>>& unreceived);
 		void SendMessageQueue();
+		void ReadMessageChunk();
+		void ReadCompressedFrame();
+		void AcceptMessage(Ref<Message>& message);
 
 		asio::ip::tcp::socket socket;
 		asio::io_context& context;
 
 		Ref<Message> tempMessage = CreateRef<Message>();
 		Core::MessageQueue& inputMessageQueue;
-		Core::MessageQueue outputMessageQueue;
+		Core::OutputQueue outputMessageQueue;
+		Core::ChunkAssembler chunkAssembler;
+
+		std::atomic<uint32_t> posted = 0; // Messages passed to SendMessagePackets, not added to output queue yet
+		bool receiving = true;
+
+		std::atomic<bool> disconnected = false;
+		std::atomic<int64_t> disconnectedAt = 0; // Steady clock seconds
+
+		uint64_t resumeToken = 0;
+		uint64_t receivedCount = 0; // Messages received in session
+		SentLog sentLog;
+
+		uint32_t features = 0; // Mask of ConnectionFeatures used with client
+		MessageHeader compressedHeader;
+		std::vector<uint8_t> compressedOutput;
+		std::vector<uint8_t> compressedInput;
+
+		std::atomic<uint32_t> connection = 0; // Incremented with every resume, handlers of older connection are ignored
 	};
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include "Message.h"
+#include "Debugging/Tracing.h"
+#include "Utils/File.h"
+#include "Utils/SHA256.h"
+
+namespace Core
+{
+	// Reassembles chunked messages from incoming frames
+	// Only one chunked message can be in flight per connection, as bulk lane is written in order
+	// Content of uploaded file is hashed as it's chunks arrive, so server can store it by hash without reading it again
+	class ChunkAssembler
+	{
+	public:
+		static inline uint32_t MaxMessageSize = 64 * 1024 * 1024; // 64MB
+
+		// Returns pointer where body of the frame should be read, nullptr if frame is not valid
+		uint8_t* Prepare(const MessageHeader& header)
+		{
+			if (!message)
+			{
+				if (header.TotalSize > MaxMessageSize)
+					return nullptr;
+
+				message = CreateRef<Message>();
+				message->Header = header;
+				message->Header.Size = header.TotalSize;
+				message->Header.Flags = (uint32_t)MessageFlags::None;
+				message->Body.Content = CreateRef<Buffer>(header.TotalSize);
+				message->ReceivedAt = Tracing::IsEnabled() ? Tracing::GetTime() : 0;
+				offset = 0;
+				hashed = 0;
+				hash.Reset();
+			}
+
+			if (header.TotalSize != message->Header.Size || offset + header.Size > message->Header.Size)
+				return nullptr;
+
+			return message->Body.Content->GetDataAs<uint8_t>() + offset;
+		}
+
+		// Returns whole message after it's last frame has been read
+		Ref<Message> Complete(const MessageHeader& header)
+		{
+			offset += header.Size;
+
+			if (message->Header.Type == MessageType::UploadFile)
+				HashContent();
+
+			if (!(header.Flags & (uint32_t)MessageFlags::LastChunk))
+				return Ref<Message>();
+
+			if (message->Header.Type == MessageType::UploadFile && hashed)
+				message->ContentHash = hash.FinishHex();
+
+			Ref<Message> result = message;
+			message = Ref<Message>();
+			offset = 0;
+
+			return result;
+		}
+
+		inline void Reset() { message = Ref<Message>(); offset = 0; }
+	private:
+		// Hashes read part of body past file header, header can be split between chunks
+		void HashContent()
+		{
+			const char* body = message->Body.Content->GetData();
+
+			if (!hashed)
+			{
+				hashed = File::GetDataOffset(body, offset);
+				if (!hashed)
+					return;
+			}
+
+			hash.Update((const uint8_t*)body + hashed, offset - hashed);
+			hashed = offset;
+		}
+
+		Ref<Message> message;
+		uint32_t offset = 0;
+
+		SHA256 hash;
+		uint32_t hashed = 0; // End of hashed part of body, 0 until file header is read
+	};
+}
@@ -0,0 +1,53 @@
+#include "pch.h"
+#include "FrameCompression.h"
+#include "ChunkAssembler.h"
+#include "Utils/LZ4.h"
+#include "Debugging/Metrics.h"
+
+namespace Core
+{
+	static Counter compressedFrames = Metrics::GetCounter("net_compressed_frames_total");
+	static Counter savedBytes = Metrics::GetCounter("net_compression_saved_bytes_total");
+
+	bool FrameCompression::Compress(const OutputFrame& frame, MessageHeader& header, std::vector<uint8_t>& buffer)
+	{
+		if (!Threshold || frame.Header.Size < Threshold)
+			return false;
+
+		// Compression stops as soon as output exceeds capacity, so incompressible data (images, archives) cost little
+		uint32_t capacity = frame.Header.Size - frame.Header.Size / 16;
+		buffer.resize(sizeof(uint32_t) + capacity);
+
+		// Files are compressed thoroughly, they are already sent in chunks between interactive frames
+		bool thorough = OutputQueue::GetPriority(frame.Source.Get()) == MessagePriority::Bulk;
+
+		uint32_t size = LZ4::Compress(frame.Data, frame.Header.Size, buffer.data() + sizeof(uint32_t), capacity, thorough);
+		if (!size)
+			return false;
+
+		memcpy(buffer.data(), &frame.Header.Size, sizeof(uint32_t));
+
+		header = frame.Header;
+		header.Size = sizeof(uint32_t) + size;
+		header.Flags |= (uint32_t)MessageFlags::Compressed;
+
+		compressedFrames.Add();
+		savedBytes.Add(frame.Header.Size - header.Size);
+
+		return true;
+	}
+
+	uint32_t FrameCompression::GetRawSize(const std::vector<uint8_t>& body)
+	{
+		uint32_t rawSize = 0;
+		if (body.size() > sizeof(uint32_t))
+			memcpy(&rawSize, body.data(), sizeof(uint32_t));
+
+		return rawSize <= ChunkAssembler::MaxMessageSize ? rawSize : 0;
+	}
+
+	bool FrameCompression::Decompress(const std::vector<uint8_t>& body, uint8_t* destination, uint32_t rawSize)
+	{
+		return LZ4::Decompress(body.data() + sizeof(uint32_t), (uint32_t)body.size() - sizeof(uint32_t), destination, rawSize);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+#include "OutputQueue.h"
+
+namespace Core
+{
+	// Frames bigger than threshold are compressed one by one with LZ4 if both sides agreed on it when connecting
+	// Body of compressed frame is raw size followed by LZ4 block, header keeps everything else of the raw frame
+	class FrameCompression
+	{
+		FrameCompression() = delete;
+	public:
+		static inline uint32_t Threshold = 1024; // Smaller frames are sent raw, 0 disables compression
+
+		inline static const uint32_t GetFeatures() { return Threshold ? (uint32_t)ConnectionFeatures::Compression : 0; }
+
+		// Returns false if frame should be sent raw (small or compressed size would not be at least 1/16 smaller)
+		static bool Compress(const OutputFrame& frame, MessageHeader& header, std::vector<uint8_t>& buffer);
+
+		// Raw size is 0 if body is not valid
+		static uint32_t GetRawSize(const std::vector<uint8_t>& body);
+		static bool Decompress(const std::vector<uint8_t>& body, uint8_t* destination, uint32_t rawSize);
+	};
+}
\ No newline at end of file
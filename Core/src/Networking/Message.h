@@ -11,6 +11,31 @@ namespace Core
 		UploadFile,
 		DownloadFile,
 		ReadFileName,
+		Sync, // Body is array of SyncEntry
+		Resume, // Body is ResumeInfo, first message of every connection and server's answer to it
+	};
+
+	static constexpr uint32_t MessageTypeCount = 7;
+
+	inline const char* GetMessageTypeName(MessageType type)
+	{
+		static const char* names[] = { "Command", "Response", "UploadFile", "DownloadFile", "ReadFileName", "Sync", "Resume" };
+		return (uint32_t)type < MessageTypeCount ? names[(uint32_t)type] : "Unknown";
+	}
+
+	enum class MessageFlags : uint32_t
+	{
+		None = 0,
+		Chunk = 1 << 0, // Frame carries part of message body
+		LastChunk = 1 << 1, // Frame carries last part of message body
+		Compressed = 1 << 2, // Frame body is compressed (see FrameCompression)
+	};
+
+	// Optional protocol features, client offers them in Resume message and server answers with those it uses too
+	enum class ConnectionFeatures : uint32_t
+	{
+		None = 0,
+		Compression = 1 << 0,
 	};
 
 	struct MessageHeader
@@ -19,7 +44,20 @@ namespace Core
 
 		MessageType Type;
 		uint32_t SessionId;
-		uint32_t Size;
+		uint32_t Size; // Size of body in this frame
+		uint32_t RequestId = 0; // Sequence id of request, echoed back in it's response (0 for unsolicited messages)
+		uint32_t Flags = 0;
+		uint32_t TotalSize = 0; // Size of whole body of chunked message
+	};
+
+	// Client sends token of it's last session (0 if there is none) and number of messages it received in it
+	// Server answers with token of continued or new session and number of messages it received, unreceived messages are sent again
+	struct ResumeInfo
+	{
+		uint64_t Token = 0;
+		uint64_t Received = 0;
+		uint32_t Resumed = 0; // Session was continued, otherwise new one was started
+		uint32_t Features = 0; // Mask of ConnectionFeatures
 	};
 
 	struct MessageBody
@@ -34,7 +72,9 @@ namespace Core
 	{
 		inline const uint32_t GetSize() const { return sizeof(MessageHeader) + Header.Size; }
 		inline const uint32_t GetSessionId() const { return Header.SessionId; }
+		inline const uint32_t GetRequestId() const { return Header.RequestId; }
 		inline const MessageType GetType() const { return Header.Type; }
+		inline const bool HasFlag(MessageFlags flag) const { return Header.Flags & (uint32_t)flag; }
 
 		template<typename T>
 		void CreateBody(const T& content)
@@ -46,5 +86,11 @@ namespace Core
 
 		MessageHeader Header;
 		MessageBody Body;
+
+		// Local only, not sent (see Tracing)
+		uint64_t TraceId = 0; // 0 if message is not traced
+		int64_t ReceivedAt = 0; // Header read from socket
+		int64_t QueuedAt = 0; // Added to input or output queue
+		std::string ContentHash; // SHA-256 of uploaded file content hashed while it's chunks were read, empty if it wasn't (see ChunkAssembler)
 	};
 }
\ No newline at end of file
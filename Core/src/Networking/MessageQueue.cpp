@@ -1,23 +1,38 @@
 #include "pch.h"
 #include "MessageQueue.h"
+#include "Debugging/Metrics.h"
 
 namespace Core
 {
+	static Counter addedMessages = Metrics::GetCounter("message_queue_added_total");
+	static Gauge queuedMessages = Metrics::GetGauge("message_queue_depth"); // All queues together
+
+	MessageQueue::~MessageQueue()
+	{
+		Clear();
+	}
+
 	void MessageQueue::Add(Ref<Message> message)
 	{
 		std::scoped_lock lock(mutex);
-		queue.push_back(message);
+		queue.push_back(std::move(message));
+
+		addedMessages.Add();
+		queuedMessages.Add();
 	}
 
 	void MessageQueue::Pop()
 	{
 		std::scoped_lock lock(mutex);
 		queue.pop_front();
+
+		queuedMessages.Sub();
 	}
 
 	void MessageQueue::Clear()
 	{
 		std::scoped_lock lock(mutex);
+		queuedMessages.Sub(queue.size());
 		queue.clear();
 	}
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace Core
 	public:
 		MessageQueue() = default;
 		MessageQueue(const MessageQueue&& other) = delete;
+		~MessageQueue();
 
 		void Add(Ref<Message> message);
 		void Pop();
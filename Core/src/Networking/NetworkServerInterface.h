@@ -20,6 +20,13 @@ namespace Core
 
 		virtual Ref<Session> FindSessionById(uint32_t SessionId) = 0;
 
+		// Closes listening socket and stops receiving messages of connected clients, used to drain server before it stops
+		virtual void StopAccepting() = 0;
+		virtual uint32_t GetQueuedCount() = 0; // Messages not written to connected clients yet
+
+		// Serves metrics in Prometheus text format over HTTP on loopback port
+		virtual bool StartStatsEndpoint(uint16_t port) = 0;
+
 		static Ref<NetworkServerInterface> Create(uint16_t port, Core::MessageQueue& inputMessageQueue, std::deque<Ref<Core::Session>>& sesionQueue);
 	};
 }
\ No newline at end of file
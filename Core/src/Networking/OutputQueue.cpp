@@ -0,0 +1,159 @@
+#include "pch.h"
+#include "OutputQueue.h"
+#include "Debugging/Metrics.h"
+
+namespace Core
+{
+	// All sessions together
+	static Gauge queuedInteractive = Metrics::GetGauge("output_queue_depth{lane=\"interactive\"}");
+	static Gauge queuedBulk = Metrics::GetGauge("output_queue_depth{lane=\"bulk\"}");
+
+	OutputQueue::~OutputQueue()
+	{
+		Clear();
+	}
+
+	void OutputQueue::Add(Ref<Message> message)
+	{
+		std::scoped_lock lock(mutex);
+
+		if (GetPriority(message.Get()) == MessagePriority::Bulk)
+		{
+			bulk.push_back(message);
+			queuedBulk.Add();
+		}
+		else
+		{
+			interactive.push_back(message);
+			queuedInteractive.Add();
+		}
+	}
+
+	void OutputQueue::Clear()
+	{
+		std::scoped_lock lock(mutex);
+
+		queuedInteractive.Sub(interactive.size());
+		queuedBulk.Sub(bulk.size());
+
+		interactive.clear();
+		bulk.clear();
+		bulkOffset = 0;
+		interactiveStreak = 0;
+	}
+
+	void OutputQueue::Rewind()
+	{
+		std::scoped_lock lock(mutex);
+
+		bulkOffset = 0;
+		interactiveStreak = 0;
+	}
+
+	void OutputQueue::Resend(const std::vector<Ref<Message>>& messages)
+	{
+		std::scoped_lock lock(mutex);
+
+		for (auto message = messages.rbegin(); message != messages.rend(); message++)
+		{
+			if (GetPriority(message->Get()) == MessagePriority::Bulk)
+			{
+				bulk.push_front(*message);
+				queuedBulk.Add();
+			}
+			else
+			{
+				interactive.push_front(*message);
+				queuedInteractive.Add();
+			}
+		}
+	}
+
+	const OutputFrame& OutputQueue::Front()
+	{
+		std::scoped_lock lock(mutex);
+
+		// Prefer interactive lane, but let bulk chunk through after every InteractiveWeight frames
+		bool useBulk = !bulk.empty() && (interactive.empty() || interactiveStreak >= InteractiveWeight);
+
+		if (!useBulk)
+		{
+			frameLane = MessagePriority::Interactive;
+
+			Ref<Message>& message = interactive.front();
+			frame.Header = message->Header;
+			frame.Data = message->Body.Content ? message->Body.Content->GetDataAs<uint8_t>() : nullptr;
+			frame.Source = message;
+			frame.IsLast = true;
+
+			return frame;
+		}
+
+		frameLane = MessagePriority::Bulk;
+
+		Ref<Message>& message = bulk.front();
+		frame.Header = message->Header;
+		frame.Source = message;
+
+		// Send small bulk messages whole
+		if (message->Header.Size <= ChunkSize)
+		{
+			frame.Data = message->Body.Content ? message->Body.Content->GetDataAs<uint8_t>() : nullptr;
+			frame.IsLast = true;
+
+			return frame;
+		}
+
+		uint32_t remaining = message->Header.Size - bulkOffset;
+
+		frame.Header.Size = std::min(remaining, ChunkSize);
+		frame.Header.TotalSize = message->Header.Size;
+		frame.Header.Flags |= (uint32_t)MessageFlags::Chunk;
+		frame.Data = message->Body.Content->GetDataAs<uint8_t>() + bulkOffset;
+		frame.IsLast = remaining <= ChunkSize;
+
+		if (frame.IsLast)
+			frame.Header.Flags |= (uint32_t)MessageFlags::LastChunk;
+
+		return frame;
+	}
+
+	void OutputQueue::Pop()
+	{
+		std::scoped_lock lock(mutex);
+
+		if (frameLane == MessagePriority::Interactive)
+		{
+			interactive.pop_front();
+			interactiveStreak++;
+			queuedInteractive.Sub();
+		}
+		else
+		{
+			interactiveStreak = 0;
+
+			if (frame.IsLast)
+			{
+				bulk.pop_front();
+				bulkOffset = 0;
+				queuedBulk.Sub();
+			}
+			else
+				bulkOffset += frame.Header.Size;
+		}
+
+		frame.Source = Ref<Message>();
+	}
+
+	MessagePriority OutputQueue::GetPriority(const Message& message)
+	{
+		switch (message.GetType())
+		{
+		case MessageType::UploadFile:
+		case MessageType::DownloadFile:
+			return MessagePriority::Bulk;
+		default:
+			return MessagePriority::Interactive;
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "Message.h"
+
+namespace Core
+{
+	enum class MessagePriority
+	{
+		Interactive = 0, // Commands, responses and notifications
+		Bulk, // File transfers
+	};
+
+	// Part of message written to socket at once
+	struct OutputFrame
+	{
+		MessageHeader Header;
+		const uint8_t* Data = nullptr;
+
+		Ref<Message> Source; // Message which the frame belongs to
+		bool IsLast = true; // Last frame of source message
+	};
+
+	// Outbound message queue with interactive and bulk lane
+	// Bulk messages are cut into chunks and interleaved with interactive messages by weighted round robin
+	class OutputQueue
+	{
+	public:
+		static inline uint32_t ChunkSize = 64 * 1024; // 64KB
+		static inline uint32_t InteractiveWeight = 8; // Interactive frames written between two bulk chunks
+
+		OutputQueue() = default;
+		OutputQueue(const OutputQueue&& other) = delete;
+		~OutputQueue();
+
+		void Add(Ref<Message> message);
+		void Clear();
+		void Rewind(); // Restart partially written bulk message (after reconnect)
+		void Resend(const std::vector<Ref<Message>>& messages); // Put messages in order before queued ones (after resume)
+
+		// Selects next frame to write, it's not removed from queue until Pop is called
+		const OutputFrame& Front();
+		void Pop();
+
+		// Frame selected by last Front call
+		inline const OutputFrame& GetCurrentFrame() const { return frame; }
+
+		inline const uint32_t GetCount() { std::scoped_lock lock(mutex); return interactive.size() + bulk.size(); }
+
+		static MessagePriority GetPriority(const Message& message);
+	private:
+		std::mutex mutex;
+		std::deque<Ref<Message>> interactive;
+		std::deque<Ref<Message>> bulk;
+
+		OutputFrame frame;
+		MessagePriority frameLane = MessagePriority::Interactive;
+
+		uint32_t bulkOffset = 0; // Bytes of first bulk message already written
+		uint32_t interactiveStreak = 0; // Interactive frames written since last bulk chunk
+	};
+}
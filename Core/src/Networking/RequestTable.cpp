@@ -0,0 +1,56 @@
+#include "pch.h"
+#include "RequestTable.h"
+
+namespace Core
+{
+	uint32_t RequestTable::Register(const ResponseCallback& callback)
+	{
+		std::scoped_lock lock(mutex);
+
+		// Skip 0, it's reserved for unsolicited messages
+		if (!idCounter)
+			idCounter++;
+
+		uint32_t requestId = idCounter++;
+		pending[requestId] = callback;
+
+		return requestId;
+	}
+
+	bool RequestTable::Complete(Message& message)
+	{
+		if (!message.GetRequestId())
+			return false;
+
+		ResponseCallback callback;
+		{
+			std::scoped_lock lock(mutex);
+
+			auto request = pending.find(message.GetRequestId());
+			if (request == pending.end())
+				return false;
+
+			callback = std::move(request->second);
+			pending.erase(request);
+		}
+
+		// Call outside of lock, callback can register new requests
+		if (!callback)
+			return false;
+
+		callback(message);
+		return true;
+	}
+
+	void RequestTable::Cancel(uint32_t requestId)
+	{
+		std::scoped_lock lock(mutex);
+		pending.erase(requestId);
+	}
+
+	void RequestTable::Clear()
+	{
+		std::scoped_lock lock(mutex);
+		pending.clear();
+	}
+}
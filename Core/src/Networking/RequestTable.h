@@ -0,0 +1,31 @@
+#pragma once
+#include "Message.h"
+
+namespace Core
+{
+	// Table of requests waiting for response, matched by request id from message header
+	class RequestTable
+	{
+		using ResponseCallback = std::function<void(Message&)>;
+	public:
+		RequestTable() = default;
+		RequestTable(const RequestTable&& other) = delete;
+
+		// Returns new request id, callback is called once response with the same id is completed
+		uint32_t Register(const ResponseCallback& callback = ResponseCallback());
+
+		// Returns true if response has been handled by callback
+		bool Complete(Message& message);
+
+		void Cancel(uint32_t requestId);
+		void Clear();
+
+		inline const bool IsPending(uint32_t requestId) { std::scoped_lock lock(mutex); return pending.contains(requestId); }
+		inline const uint32_t GetCount() { std::scoped_lock lock(mutex); return pending.size(); }
+	private:
+		std::mutex mutex;
+		std::unordered_map<uint32_t, ResponseCallback> pending;
+
+		uint32_t idCounter = 1;
+	};
+}
@@ -0,0 +1,35 @@
+#include "pch.h"
+#include "SentLog.h"
+
+namespace Core
+{
+	void SentLog::Add(const Ref<Message>& message)
+	{
+		messages.push_back(message);
+		size += message->Header.Size;
+
+		// Message bigger than limit is not kept either (download), peer which missed it starts new session
+		while (messages.size() > MaxMessages || size > MaxSize)
+		{
+			size -= messages.front()->Header.Size;
+			messages.pop_front();
+			dropped++;
+		}
+	}
+
+	void SentLog::Clear()
+	{
+		messages.clear();
+		dropped = 0;
+		size = 0;
+	}
+
+	bool SentLog::GetUnreceived(uint64_t received, std::vector<Ref<Message>>& unreceived) const
+	{
+		if (received < dropped || received > GetCount())
+			return false;
+
+		unreceived.assign(messages.begin() + (received - dropped), messages.end());
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#include "Message.h"
+
+namespace Core
+{
+	// Messages written to socket, kept until peer tells on resume how many of them it received
+	// Only the last ones are kept, session can't be resumed if peer missed older ones
+	// Log doesn't pin more than MaxSize of message bodies, message bigger than that is dropped right away
+	class SentLog
+	{
+	public:
+		static inline uint32_t MaxMessages = 256;
+		static inline uint64_t MaxSize = 4 * 1024 * 1024; // 4MB
+
+		void Add(const Ref<Message>& message);
+		void Clear();
+
+		// Messages written after the first received ones, false if some of them are not kept anymore
+		bool GetUnreceived(uint64_t received, std::vector<Ref<Message>>& unreceived) const;
+
+		// Messages written since session started
+		inline const uint64_t GetCount() const { return dropped + messages.size(); }
+	private:
+		std::deque<Ref<Message>> messages;
+		uint64_t dropped = 0; // Messages removed from front
+		uint64_t size = 0;
+	};
+}
\ No newline at end of file
@@ -7,16 +7,25 @@ namespace Core
 	class Session
 	{
 	public:
+		static inline uint32_t ResumeTimeout = 60; // Seconds, session of lost connection is kept for client to resume it
+
 		Session() : id(idCounter++) {}
+		virtual ~Session() = default;
 
 		inline const uint32_t GetId() const { return id; }
 		inline virtual const bool IsOpen() const = 0;
+		inline virtual const bool IsResumable() const = 0; // Connection is lost, but client can still resume session
+		inline virtual const uint64_t GetResumeToken() const = 0;
 
 		virtual void SendMessagePackets(Ref<Message>& message) = 0;
 		virtual void ReadMessagePackets() = 0;
 
 		virtual void Disconnect() = 0;
 
+		// Messages received afterwards are dropped, queued ones are still sent
+		virtual void StopReceiving() = 0;
+		virtual const uint32_t GetQueuedCount() = 0; // Messages not written to socket yet
+
 		static Ref<Session> Create(Context* context, Socket* socket, MessageQueue& inputMessageQueue);
 	protected:
 		uint32_t id = 0;
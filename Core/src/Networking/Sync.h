@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+namespace Core
+{
+	// Data change is recorded for user or team it belongs to, clients ask only for changes of their scopes
+	enum class ChangeScope : uint8_t
+	{
+		User = 0, Team
+	};
+
+	// Kinds of client data, combined into mask of changes
+	enum class ChangeEntity : uint32_t
+	{
+		Teams = 1 << 0,
+		Messages = 1 << 1,
+		Users = 1 << 2,
+		Invites = 1 << 3,
+		Notifications = 1 << 4,
+		Assignments = 1 << 5,
+	};
+
+	static constexpr uint32_t ChangeEntityCount = 6;
+	static constexpr uint32_t AllChangeEntities = (1 << ChangeEntityCount) - 1;
+
+	// Body of Sync message is array of entries, request carries sequence of last sync of scope (0 if there was none)
+	// Response carries current sequence and changes made since requested one
+	struct SyncEntry
+	{
+		uint64_t Sequence = 0;
+		uint32_t Id = 0; // User or team id
+		ChangeScope Scope = ChangeScope::User;
+		uint8_t FullResync = 0; // Changes since requested sequence are not known (server restarted), everything has to be read again
+		uint16_t Reserved = 0;
+		uint32_t Changes = 0; // Mask of ChangeEntity
+		uint32_t Reserved2 = 0;
+	};
+
+	static constexpr uint32_t MaxSyncEntries = 1024;
+}
\ No newline at end of file
@@ -1,11 +1,23 @@
 #include "pch.h"
 #include "Buffer.h"
+#include "FileMapping.h"
+#include "Debugging/Metrics.h"
+
+static Core::Counter allocatedBytes = Core::Metrics::GetCounter("buffer_allocated_bytes_total");
+static Core::Gauge liveBuffers = Core::Metrics::GetGauge("buffer_live_count");
+static Core::Gauge liveBytes = Core::Metrics::GetGauge("buffer_live_bytes");
 
 Buffer::Buffer(uint32_t Size)
 {
 	Allocate(Size);
 }
 
+Buffer::Buffer(const std::shared_ptr<const FileMapping>& Mapping) : mapping(Mapping)
+{
+	data = (uint8_t*)mapping->GetData();
+	size = mapping->GetSize();
+}
+
 void Buffer::Allocate(uint32_t Size)
 {
 	Release();
@@ -13,11 +25,30 @@ void Buffer::Allocate(uint32_t Size)
 	size = Size;
 	data = (uint8_t*)malloc(size);
 
+	allocatedBytes.Add(size);
+	liveBuffers.Add();
+	liveBytes.Add(size);
+
 	WriteZeros();
 }
 
 void Buffer::Release()
 {
+	// Mapping is released with the last buffer viewing it
+	if (mapping)
+	{
+		mapping.reset();
+		data = nullptr;
+		size = 0;
+		return;
+	}
+
+	if (data)
+	{
+		liveBuffers.Sub();
+		liveBytes.Sub(size);
+	}
+
 	free(data);
 	data = nullptr;
 	size = 0;
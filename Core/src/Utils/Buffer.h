@@ -1,10 +1,18 @@
 #pragma once
+#include <memory>
+
+class FileMapping;
 
 class Buffer
 {
 public:
 	Buffer() = default;
 	Buffer(uint32_t Size);
+	// Read only view of mapped file, it's data must not be written
+	Buffer(const std::shared_ptr<const FileMapping>& Mapping);
+	~Buffer() { Release(); }
+
+	Buffer(const Buffer&) = delete;
 
 	void Allocate(uint32_t Size);
 	void Release();
@@ -17,9 +25,12 @@ public:
 
 	inline const uint32_t GetSize() const { return size; }
 	inline const bool IsEmpty() const { return !*data; }
+	inline const bool IsMapped() const { return (bool)mapping; }
 
 	operator bool() const { return (bool)data; }
 private:
 	uint8_t* data = nullptr;
 	uint32_t size = 0;
+
+	std::shared_ptr<const FileMapping> mapping; // Set if data is view of mapped file, not allocated by buffer
 };
\ No newline at end of file
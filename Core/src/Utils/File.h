@@ -70,6 +70,21 @@ public:
 		is.read(&nameBuffer[0], nameSize);
 		name = nameBuffer;
 	}
+
+	// Offset of file content in serialized file, 0 if size doesn't cover whole header yet
+	static uint32_t GetDataOffset(const char* serialized, uint32_t size)
+	{
+		uint32_t nameOffset = sizeof(int) + sizeof(bool) + sizeof(size_t);
+		if (size < nameOffset)
+			return 0;
+
+		size_t nameSize;
+		memcpy(&nameSize, serialized + sizeof(int) + sizeof(bool), sizeof(size_t));
+		if (nameSize > size - nameOffset || size - nameOffset - nameSize < sizeof(uint32_t))
+			return 0;
+
+		return nameOffset + (uint32_t)nameSize + sizeof(uint32_t);
+	}
 private:
 	bool byUser;
 	int id = -1; // Used either for assignment_id
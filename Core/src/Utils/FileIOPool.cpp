@@ -0,0 +1,90 @@
+#include "pch.h"
+#include "FileIOPool.h"
+#include "Debugging/Metrics.h"
+
+static Core::Gauge pendingJobs = Core::Metrics::GetGauge("file_io_pending");
+static Core::Histogram jobDuration = Core::Metrics::GetHistogram("file_io_duration_us");
+
+FileIOPool::FileIOPool(uint32_t threadCount)
+{
+	for (uint32_t i = 0; i < std::max(threadCount, 1u); i++)
+		threads.emplace_back([this]() { Run(); });
+}
+
+FileIOPool::~FileIOPool()
+{
+	{
+		std::scoped_lock lock(jobsMutex);
+		stopping = true;
+	}
+
+	jobsCondition.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+void FileIOPool::Submit(Job&& job)
+{
+	pending.fetch_add(1, std::memory_order_relaxed);
+	pendingJobs.Add();
+
+	{
+		std::scoped_lock lock(jobsMutex);
+		jobs.push_back(std::move(job));
+	}
+
+	jobsCondition.notify_one();
+}
+
+void FileIOPool::Complete(Job&& completion)
+{
+	pending.fetch_add(1, std::memory_order_relaxed);
+
+	std::scoped_lock lock(completionsMutex);
+	completions.push_back(std::move(completion));
+}
+
+uint32_t FileIOPool::ProcessCompletions()
+{
+	std::deque<Job> ready;
+	{
+		std::scoped_lock lock(completionsMutex);
+		ready.swap(completions);
+	}
+
+	for (Job& completion : ready)
+	{
+		completion();
+		pending.fetch_sub(1, std::memory_order_release);
+	}
+
+	return (uint32_t)ready.size();
+}
+
+void FileIOPool::Run()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock lock(jobsMutex);
+			jobsCondition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+
+			if (jobs.empty())
+				return;
+
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+
+		{
+			Core::ScopedTimer timer(jobDuration);
+			job();
+		}
+
+		// Job's completion (if any) is already counted
+		pending.fetch_sub(1, std::memory_order_release);
+		pendingJobs.Sub();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads for disk reads and writes, so thread processing messages never waits for disk
+// Jobs run on workers, completions they post are run by owning thread in ProcessCompletions
+// Ref counts are not atomic, job has to move every Ref it holds into it's completion, so only owning thread releases them
+class FileIOPool
+{
+public:
+	using Job = std::function<void()>;
+
+	FileIOPool(uint32_t threadCount);
+	~FileIOPool(); // Finishes queued jobs, their completions are not run
+
+	void Submit(Job&& job);
+	void Complete(Job&& completion); // Called by job on worker thread
+
+	// Returns number of completions run
+	uint32_t ProcessCompletions();
+
+	// Submitted jobs whose completions were not run yet
+	inline const uint32_t GetPendingCount() const { return pending.load(std::memory_order_acquire); }
+private:
+	void Run();
+
+	std::vector<std::thread> threads;
+
+	std::mutex jobsMutex;
+	std::condition_variable jobsCondition;
+	std::deque<Job> jobs;
+	bool stopping = false;
+
+	std::mutex completionsMutex;
+	std::deque<Job> completions;
+
+	std::atomic<uint32_t> pending = 0;
+};
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "FileMapping.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+FileMapping::~FileMapping()
+{
+#ifdef PLATFORM_WINDOWS
+	if (data)
+		UnmapViewOfFile(data);
+
+	if (mapping)
+		CloseHandle(mapping);
+#else
+	if (data)
+		munmap(data, size);
+#endif
+}
+
+std::shared_ptr<const FileMapping> FileMapping::Open(const std::filesystem::path& path)
+{
+	std::shared_ptr<FileMapping> result = std::make_shared<FileMapping>();
+
+#ifdef PLATFORM_WINDOWS
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || !fileSize.QuadPart || fileSize.QuadPart > UINT32_MAX)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// Mapping keeps file open, it's handle isn't needed anymore
+	result->mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!result->mapping)
+		return nullptr;
+
+	result->data = (char*)MapViewOfFile(result->mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!result->data)
+		return nullptr;
+
+	result->size = (uint32_t)fileSize.QuadPart;
+
+	WIN32_MEMORY_RANGE_ENTRY range = { result->data, result->size };
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		return nullptr;
+
+	struct stat status;
+	if (fstat(file, &status) || !status.st_size || status.st_size > UINT32_MAX)
+	{
+		close(file);
+		return nullptr;
+	}
+
+	// Populated mapping reads whole file now, on calling thread
+	void* address = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED | MAP_POPULATE, file, 0);
+	close(file);
+	if (address == MAP_FAILED)
+		return nullptr;
+
+	result->data = (char*)address;
+	result->size = (uint32_t)status.st_size;
+#endif
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#include <filesystem>
+#include <memory>
+
+// Whole file mapped read only, it's pages are shared with page cache and every other mapping of the file
+// Shared by buffers viewing it (see Buffer), shared_ptr keeps it alive as they are released on different threads
+class FileMapping
+{
+public:
+	FileMapping() = default;
+	~FileMapping();
+
+	FileMapping(const FileMapping&) = delete;
+
+	// Returns nullptr if file can't be mapped (missing, empty or larger than 4GB)
+	// File is read into memory before it returns, so later access to it doesn't wait for disk
+	static std::shared_ptr<const FileMapping> Open(const std::filesystem::path& path);
+
+	inline const char* GetData() const { return data; }
+	inline const uint32_t GetSize() const { return size; }
+private:
+	char* data = nullptr;
+	uint32_t size = 0;
+
+#ifdef PLATFORM_WINDOWS
+	void* mapping = nullptr;
+#endif
+};
\ No newline at end of file
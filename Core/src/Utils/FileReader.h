@@ -15,7 +15,10 @@ public:
 		std::ifstream stream(path, std::ios::binary);
 
         if (!stream)
-            error = true;
+        {
+            ERROR("Failed to open file!");
+            return Ref<Buffer>();
+        }
 
         // Read file size
         stream.seekg(0, std::ios::end);
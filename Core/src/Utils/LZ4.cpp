@@ -0,0 +1,258 @@
+#include "pch.h"
+#include "LZ4.h"
+
+namespace LZ4
+{
+	static constexpr uint32_t MinMatch = 4;
+	static constexpr uint32_t LastLiterals = 5; // Block ends with literals
+	static constexpr uint32_t MatchStartLimit = 12; // Last match starts at least this far from end of block
+	static constexpr uint32_t MaxOffset = 65535;
+	static constexpr uint32_t WindowMask = 65535;
+
+	static constexpr uint32_t HashBits = 14;
+	static constexpr uint32_t ChainDepth = 32; // Candidates checked in thorough mode
+	static constexpr uint32_t SkipStrength = 6; // Search steps faster through data without matches
+	static constexpr uint32_t NoPosition = UINT32_MAX;
+
+	static inline uint32_t Read32(const uint8_t* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static inline uint32_t Hash(const uint8_t* data)
+	{
+		return (Read32(data) * 2654435761u) >> (32 - HashBits);
+	}
+
+	static inline uint32_t GetMatchLength(const uint8_t* position, const uint8_t* candidate, const uint8_t* limit)
+	{
+		const uint8_t* start = position;
+		while (position < limit && *position == *candidate)
+		{
+			position++;
+			candidate++;
+		}
+
+		return (uint32_t)(position - start);
+	}
+
+	// Length over 15 continues in bytes of 255 ended by smaller one
+	static inline void WriteLength(uint8_t*& output, uint32_t length)
+	{
+		for (; length >= 255; length -= 255)
+			*output++ = 255;
+
+		*output++ = (uint8_t)length;
+	}
+
+	// Match length 0 writes last sequence with literals only
+	static bool WriteSequence(uint8_t*& output, const uint8_t* outputEnd, const uint8_t* literals, uint32_t literalCount, uint32_t offset, uint32_t matchLength)
+	{
+		size_t required = 1 + literalCount / 255 + 1 + literalCount + 2 + matchLength / 255 + 1;
+		if ((size_t)(outputEnd - output) < required)
+			return false;
+
+		uint8_t* token = output++;
+		*token = (uint8_t)(std::min(literalCount, 15u) << 4);
+		if (literalCount >= 15)
+			WriteLength(output, literalCount - 15);
+
+		if (literalCount)
+			memcpy(output, literals, literalCount);
+		output += literalCount;
+
+		if (!matchLength)
+			return true;
+
+		*output++ = (uint8_t)offset;
+		*output++ = (uint8_t)(offset >> 8);
+
+		uint32_t length = matchLength - MinMatch;
+		*token |= (uint8_t)std::min(length, 15u);
+		if (length >= 15)
+			WriteLength(output, length - 15);
+
+		return true;
+	}
+
+	// Tables are reused by every block compressed on the thread
+	struct SearchTables
+	{
+		uint32_t Head[1 << HashBits]; // Last position of hash
+		uint32_t Chain[WindowMask + 1]; // Previous position with the same hash, only in thorough mode
+	};
+
+	uint32_t Compress(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t capacity, bool thorough)
+	{
+		static thread_local std::unique_ptr<SearchTables> tables = std::make_unique<SearchTables>();
+		std::fill(std::begin(tables->Head), std::end(tables->Head), NoPosition);
+
+		const uint8_t* end = source + size;
+		const uint8_t* anchor = source; // Start of literals not written yet
+		uint8_t* output = destination;
+		const uint8_t* outputEnd = destination + capacity;
+
+		if (size > MatchStartLimit)
+		{
+			const uint8_t* startLimit = end - MatchStartLimit;
+			const uint8_t* matchLimit = end - LastLiterals;
+			const uint8_t* position = source;
+			uint32_t inserted = 0; // Positions below are in chains
+			uint32_t misses = 0;
+
+			while (position <= startLimit)
+			{
+				uint32_t current = (uint32_t)(position - source);
+				const uint8_t* match = nullptr;
+				uint32_t matchLength = 0;
+
+				if (thorough)
+				{
+					// Every position is added to chain, so candidates are found even inside of skipped matches
+					for (; inserted <= current; inserted++)
+					{
+						uint32_t hash = Hash(source + inserted);
+						tables->Chain[inserted & WindowMask] = tables->Head[hash];
+						tables->Head[hash] = inserted;
+					}
+
+					uint32_t candidate = tables->Chain[current & WindowMask];
+					for (uint32_t depth = 0; depth < ChainDepth && candidate != NoPosition && current - candidate <= MaxOffset; depth++)
+					{
+						if (Read32(source + candidate) == Read32(position))
+						{
+							uint32_t length = MinMatch + GetMatchLength(position + MinMatch, source + candidate + MinMatch, matchLimit);
+							if (length > matchLength)
+							{
+								match = source + candidate;
+								matchLength = length;
+							}
+						}
+
+						candidate = tables->Chain[candidate & WindowMask];
+					}
+				}
+				else
+				{
+					uint32_t hash = Hash(position);
+					uint32_t candidate = tables->Head[hash];
+					tables->Head[hash] = current;
+
+					if (candidate != NoPosition && current - candidate <= MaxOffset && Read32(source + candidate) == Read32(position))
+					{
+						match = source + candidate;
+						matchLength = MinMatch + GetMatchLength(position + MinMatch, match + MinMatch, matchLimit);
+					}
+				}
+
+				if (!match)
+				{
+					position += 1 + (misses++ >> SkipStrength);
+					continue;
+				}
+
+				misses = 0;
+
+				// Match can start before position if preceding literals match too
+				while (position > anchor && match > source && position[-1] == match[-1])
+				{
+					position--;
+					match--;
+					matchLength++;
+				}
+
+				if (!WriteSequence(output, outputEnd, anchor, (uint32_t)(position - anchor), (uint32_t)(position - match), matchLength))
+					return 0;
+
+				position += matchLength;
+				anchor = position;
+
+				// Position just before end of match is likely to start next one
+				if (!thorough && position - 2 >= source && position - 2 <= startLimit)
+					tables->Head[Hash(position - 2)] = (uint32_t)(position - 2 - source);
+			}
+		}
+
+		if (!WriteSequence(output, outputEnd, anchor, (uint32_t)(end - anchor), 0, 0))
+			return 0;
+
+		return (uint32_t)(output - destination);
+	}
+
+	static inline bool ReadLength(const uint8_t*& input, const uint8_t* inputEnd, size_t& length)
+	{
+		uint8_t value;
+		do
+		{
+			if (input == inputEnd)
+				return false;
+
+			value = *input++;
+			length += value;
+		} while (value == 255);
+
+		return true;
+	}
+
+	bool Decompress(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t rawSize)
+	{
+		const uint8_t* input = source;
+		const uint8_t* inputEnd = source + size;
+		uint8_t* output = destination;
+		uint8_t* outputEnd = destination + rawSize;
+
+		while (input < inputEnd)
+		{
+			uint8_t token = *input++;
+
+			size_t literalCount = token >> 4;
+			if (literalCount == 15 && !ReadLength(input, inputEnd, literalCount))
+				return false;
+
+			if (literalCount > (size_t)(inputEnd - input) || literalCount > (size_t)(outputEnd - output))
+				return false;
+
+			if (literalCount)
+				memcpy(output, input, literalCount);
+			output += literalCount;
+			input += literalCount;
+
+			// Last sequence has no match
+			if (input == inputEnd)
+				return output == outputEnd;
+
+			if (inputEnd - input < 2)
+				return false;
+
+			size_t offset = input[0] | (input[1] << 8);
+			input += 2;
+
+			if (!offset || offset > (size_t)(output - destination))
+				return false;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !ReadLength(input, inputEnd, matchLength))
+				return false;
+
+			matchLength += MinMatch;
+			if (matchLength > (size_t)(outputEnd - output))
+				return false;
+
+			// Match can overlap output (repeated pattern), it's copied byte by byte then
+			const uint8_t* match = output - offset;
+			if (offset >= matchLength)
+				memcpy(output, match, matchLength);
+			else
+			{
+				for (size_t i = 0; i < matchLength; i++)
+					output[i] = match[i];
+			}
+
+			output += matchLength;
+		}
+
+		return false;
+	}
+}
\ No newline at end of file
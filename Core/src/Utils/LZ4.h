@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+// LZ4 block format (without frame format), every block is compressed and decompressed whole
+// Block is sequence of literals and matches (offset up to 64KB back), the last 5 bytes are always literals
+namespace LZ4
+{
+	// Highest compressed size of incompressible data
+	constexpr uint32_t GetMaxCompressedSize(uint32_t size) { return size + size / 255 + 16; }
+
+	// Returns compressed size, 0 if it doesn't fit into capacity
+	// Thorough mode searches more candidates for every match, it's slower, but compresses better (for files)
+	uint32_t Compress(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t capacity, bool thorough = false);
+
+	// Returns false if block is corrupted or it doesn't decompress exactly to rawSize bytes
+	bool Decompress(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t rawSize);
+}
\ No newline at end of file
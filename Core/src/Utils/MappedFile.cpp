@@ -0,0 +1,154 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const char* path, size_t chunkSize)
+{
+	Open(path, chunkSize);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const char* path, size_t chunkSize)
+{
+	Close();
+	chunk = chunkSize;
+
+#ifdef PLATFORM_WINDOWS
+	HANDLE handle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+
+	file = handle;
+#else
+	file = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (file < 0)
+		return false;
+#endif
+
+	if (!Map(chunk))
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	Unmap();
+
+#ifdef PLATFORM_WINDOWS
+	if (file)
+	{
+		// Cut unused part of last chunk
+		LARGE_INTEGER size;
+		size.QuadPart = written;
+		SetFilePointerEx(file, size, nullptr, FILE_BEGIN);
+		SetEndOfFile(file);
+
+		CloseHandle(file);
+		file = nullptr;
+	}
+#else
+	if (file >= 0)
+	{
+		// Cut unused part of last chunk
+		if (ftruncate(file, written)) {}
+
+		close(file);
+		file = -1;
+	}
+#endif
+
+	mappedSize = 0;
+	written = 0;
+}
+
+char* MappedFile::Reserve(size_t size)
+{
+	if (!data)
+		return nullptr;
+
+	if (written + size > mappedSize)
+	{
+		size_t newSize = mappedSize;
+		while (written + size > newSize)
+			newSize += chunk;
+
+		Unmap();
+		if (!Map(newSize))
+			return nullptr;
+	}
+
+	return data + written;
+}
+
+bool MappedFile::Write(const void* source, size_t size)
+{
+	char* destination = Reserve(size);
+	if (!destination)
+		return false;
+
+	memcpy(destination, source, size);
+	Commit(size);
+
+	return true;
+}
+
+bool MappedFile::Map(size_t size)
+{
+#ifdef PLATFORM_WINDOWS
+	// Mapping larger than file extends the file
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)size, nullptr);
+	if (!mapping)
+		return false;
+
+	data = (char*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+	if (!data)
+	{
+		CloseHandle(mapping);
+		mapping = nullptr;
+		return false;
+	}
+#else
+	if (ftruncate(file, size))
+		return false;
+
+	void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	if (address == MAP_FAILED)
+		return false;
+
+	data = (char*)address;
+#endif
+
+	mappedSize = size;
+	return true;
+}
+
+void MappedFile::Unmap()
+{
+	if (!data)
+		return;
+
+#ifdef PLATFORM_WINDOWS
+	UnmapViewOfFile(data);
+	CloseHandle(mapping);
+	mapping = nullptr;
+#else
+	munmap(data, mappedSize);
+#endif
+
+	data = nullptr;
+}
\ No newline at end of file
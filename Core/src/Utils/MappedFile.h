@@ -0,0 +1,42 @@
+#pragma once
+
+// File mapped into memory for writing, grows by whole chunks and is truncated to written size when closed
+// Written data is in page cache immediately, so it survives crash of the process
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const char* path, size_t chunkSize = 16 * 1024 * 1024);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+
+	bool Open(const char* path, size_t chunkSize = 16 * 1024 * 1024);
+	void Close();
+
+	// Returns space for size bytes at end of written data, nullptr if file can't grow
+	char* Reserve(size_t size);
+	// Marks reserved bytes as written
+	inline void Commit(size_t size) { written += size; }
+
+	bool Write(const void* data, size_t size);
+
+	inline const size_t GetWrittenSize() const { return written; }
+
+	operator bool() const { return (bool)data; }
+private:
+	bool Map(size_t size);
+	void Unmap();
+
+	char* data = nullptr;
+	size_t mappedSize = 0;
+	size_t written = 0;
+	size_t chunk = 0;
+
+#ifdef PLATFORM_WINDOWS
+	void* file = nullptr;
+	void* mapping = nullptr;
+#else
+	int file = -1;
+#endif
+};
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "SHA256.h"
+
+static constexpr uint32_t roundConstants[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t RotateRight(uint32_t value, uint32_t count) { return (value >> count) | (value << (32 - count)); }
+
+void SHA256::Reset()
+{
+	static constexpr uint32_t initialState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+	memcpy(state, initialState, sizeof(state));
+	blockSize = 0;
+	length = 0;
+}
+
+void SHA256::Update(const uint8_t* data, size_t size)
+{
+	length += size;
+
+	// Fill partial block first, whole blocks are then transformed directly from data
+	if (blockSize)
+	{
+		size_t count = std::min(size, (size_t)(sizeof(block) - blockSize));
+		memcpy(block + blockSize, data, count);
+		blockSize += (uint32_t)count;
+		data += count;
+		size -= count;
+
+		if (blockSize < sizeof(block))
+			return;
+
+		Transform(block);
+		blockSize = 0;
+	}
+
+	while (size >= sizeof(block))
+	{
+		Transform(data);
+		data += sizeof(block);
+		size -= sizeof(block);
+	}
+
+	if (size)
+	{
+		memcpy(block, data, size);
+		blockSize = (uint32_t)size;
+	}
+}
+
+void SHA256::Finish(uint8_t digest[DigestSize])
+{
+	uint64_t bitLength = length * 8;
+
+	// Padding is 0x80, zeros up to 56 bytes of block and message length in bits (big endian)
+	uint8_t padding[sizeof(block) + 8] = { 0x80 };
+	size_t paddingSize = (blockSize < 56 ? 56 : 120) - blockSize;
+	for (uint32_t i = 0; i < 8; i++)
+		padding[paddingSize + i] = (uint8_t)(bitLength >> (56 - i * 8));
+
+	Update(padding, paddingSize + 8);
+
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		digest[i * 4] = (uint8_t)(state[i] >> 24);
+		digest[i * 4 + 1] = (uint8_t)(state[i] >> 16);
+		digest[i * 4 + 2] = (uint8_t)(state[i] >> 8);
+		digest[i * 4 + 3] = (uint8_t)state[i];
+	}
+}
+
+std::string SHA256::FinishHex()
+{
+	static constexpr char digits[] = "0123456789abcdef";
+
+	uint8_t digest[DigestSize];
+	Finish(digest);
+
+	std::string text(DigestSize * 2, '0');
+	for (uint32_t i = 0; i < DigestSize; i++)
+	{
+		text[i * 2] = digits[digest[i] >> 4];
+		text[i * 2 + 1] = digits[digest[i] & 15];
+	}
+
+	return text;
+}
+
+bool SHA256::IsHexDigest(const std::string& text)
+{
+	return text.size() == DigestSize * 2 && std::all_of(text.begin(), text.end(), [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); });
+}
+
+void SHA256::Transform(const uint8_t* data)
+{
+	uint32_t words[64];
+	for (uint32_t i = 0; i < 16; i++)
+		words[i] = (uint32_t)data[i * 4] << 24 | (uint32_t)data[i * 4 + 1] << 16 | (uint32_t)data[i * 4 + 2] << 8 | data[i * 4 + 3];
+
+	for (uint32_t i = 16; i < 64; i++)
+	{
+		uint32_t s0 = RotateRight(words[i - 15], 7) ^ RotateRight(words[i - 15], 18) ^ (words[i - 15] >> 3);
+		uint32_t s1 = RotateRight(words[i - 2], 17) ^ RotateRight(words[i - 2], 19) ^ (words[i - 2] >> 10);
+		words[i] = words[i - 16] + s0 + words[i - 7] + s1;
+	}
+
+	uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+
+	for (uint32_t i = 0; i < 64; i++)
+	{
+		uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+		uint32_t choice = (e & f) ^ (~e & g);
+		uint32_t temp1 = h + s1 + choice + roundConstants[i] + words[i];
+		uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+		uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+		uint32_t temp2 = s0 + majority;
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + temp1;
+		d = c;
+		c = b;
+		b = a;
+		a = temp1 + temp2;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// SHA-256 (FIPS 180-4), data can be added in parts as it arrives
+class SHA256
+{
+public:
+	static constexpr uint32_t DigestSize = 32;
+
+	SHA256() { Reset(); }
+
+	void Reset();
+	void Update(const uint8_t* data, size_t size);
+
+	// Finishes hash, object has to be reset before next use
+	void Finish(uint8_t digest[DigestSize]);
+	std::string FinishHex(); // Lowercase, 64 characters
+
+	static std::string Hash(const uint8_t* data, size_t size)
+	{
+		SHA256 hash;
+		hash.Update(data, size);
+		return hash.FinishHex();
+	}
+
+	// Text is 64 lowercase hex characters, like result of FinishHex
+	static bool IsHexDigest(const std::string& text);
+private:
+	void Transform(const uint8_t* block);
+
+	uint32_t state[8];
+	uint8_t block[64];
+	uint32_t blockSize;
+	uint64_t length; // Bytes
+};
\ No newline at end of file
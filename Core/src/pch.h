@@ -12,10 +12,12 @@
 // Data structers
 #include <deque>
 #include <string>
+#include <cstring>
 #include <sstream>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <map>
 
 // Files
 #include <fstream>
@@ -23,6 +25,8 @@
 
 // Others
 #include <mutex>
+#include <thread>
+#include <iomanip>
 
 #include <regex>
 #include <ctime>
@@ -0,0 +1,144 @@
+#include "pch.h"
+#include "Benchmark.h"
+
+namespace Bench
+{
+	static constexpr uint64_t MaxIterations = 1'000'000'000;
+
+	void Runner::Register(const std::string& name, BenchmarkFunction function)
+	{
+		benchmarks.emplace_back(name, std::move(function));
+	}
+
+	// Returns seconds of one run
+	double Runner::Measure(const BenchmarkFunction& function, uint64_t iterations, Ref<State>& state)
+	{
+		state = CreateRef<State>(iterations);
+
+		function(*state);
+		state->StopTimer();
+
+		return std::chrono::duration<double>(state->stop - state->start).count();
+	}
+
+	std::vector<Result> Runner::Run(const std::string& filter, double minTime, uint32_t repetitions)
+	{
+		std::vector<Result> results;
+
+		for (const auto& [name, function] : benchmarks)
+		{
+			if (!filter.empty() && name.find(filter) == std::string::npos)
+				continue;
+
+			Ref<State> state;
+
+			uint64_t iterations = 1;
+			double elapsed = Measure(function, iterations, state);
+			while (elapsed < minTime && iterations < MaxIterations)
+			{
+				// Aim a bit above min time, but don't grow more than 10x from unreliable short run
+				double factor = elapsed > 0 ? minTime * 1.4 / elapsed : 10;
+				iterations = std::min(MaxIterations, (uint64_t)(iterations * std::clamp(factor, 2.0, 10.0)));
+				elapsed = Measure(function, iterations, state);
+			}
+
+			std::vector<double> times;
+			for (uint32_t i = 0; i < repetitions; i++)
+				times.push_back(Measure(function, iterations, state) * 1e9 / iterations);
+
+			std::sort(times.begin(), times.end());
+
+			Result result;
+			result.Name = name;
+			result.Iterations = iterations;
+			result.Repetitions = repetitions;
+			result.NsPerOp = times[times.size() / 2];
+			result.NsPerOpMin = times.front();
+			result.NsPerOpMax = times.back();
+			result.BytesPerSecond = state->bytesPerIteration * 1e9 / result.NsPerOp;
+			result.Counters = state->counters;
+
+			fprintf(stderr, "%-40s %12.1f ns/op  (min %.1f, max %.1f, %llu iterations)", name.c_str(), result.NsPerOp, result.NsPerOpMin, result.NsPerOpMax, (unsigned long long)iterations);
+			if (result.BytesPerSecond)
+				fprintf(stderr, "  %.1f MB/s", result.BytesPerSecond / (1024 * 1024));
+			fprintf(stderr, "\n");
+
+			results.push_back(std::move(result));
+		}
+
+		return results;
+	}
+
+	static void WriteString(std::ostream& os, const std::string& text)
+	{
+		os << '"';
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+				os << '\\';
+			os << c;
+		}
+		os << '"';
+	}
+
+	void Runner::WriteJson(std::ostream& os, const std::vector<Result>& results, const std::string& label, double minTime)
+	{
+#if defined(DEBUG_CONFIG)
+		const char* configuration = "Debug";
+#elif defined(RELEASE_CONFIG)
+		const char* configuration = "Release";
+#else
+		const char* configuration = "Distribution";
+#endif
+
+#ifdef PLATFORM_WINDOWS
+		const char* platform = "windows";
+#else
+		const char* platform = "linux";
+#endif
+
+		char date[32];
+		std::time_t now = std::time(nullptr);
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+		os << std::setprecision(6) << std::fixed;
+		os << "{\n";
+		os << "  \"context\": {\n";
+		os << "    \"label\": "; WriteString(os, label); os << ",\n";
+		os << "    \"date\": \"" << date << "\",\n";
+		os << "    \"configuration\": \"" << configuration << "\",\n";
+		os << "    \"platform\": \"" << platform << "\",\n";
+		os << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+		os << "    \"min_time\": " << minTime << "\n";
+		os << "  },\n";
+		os << "  \"benchmarks\": [";
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const Result& result = results[i];
+
+			os << (i ? ",\n" : "\n") << "    {\n";
+			os << "      \"name\": "; WriteString(os, result.Name); os << ",\n";
+			os << "      \"iterations\": " << result.Iterations << ",\n";
+			os << "      \"repetitions\": " << result.Repetitions << ",\n";
+			os << "      \"ns_per_op\": " << result.NsPerOp << ",\n";
+			os << "      \"ns_per_op_min\": " << result.NsPerOpMin << ",\n";
+			os << "      \"ns_per_op_max\": " << result.NsPerOpMax << ",\n";
+			os << "      \"bytes_per_second\": " << result.BytesPerSecond << ",\n";
+			os << "      \"counters\": {";
+
+			bool first = true;
+			for (const auto& [name, value] : result.Counters)
+			{
+				os << (first ? " " : ", ");
+				WriteString(os, name);
+				os << ": " << value;
+				first = false;
+			}
+
+			os << (first ? "}" : " }") << "\n    }";
+		}
+
+		os << "\n  ]\n}\n";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include "Utils/Memory.h"
+
+#ifdef PLATFORM_WINDOWS
+	#include <intrin.h>
+#endif
+
+namespace Bench
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Keeps compiler from removing computation whose result is not used
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#ifdef PLATFORM_WINDOWS
+		static const void* volatile sink;
+		sink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	// Passed to benchmark function, which runs measured code Iterations times
+	// Setup done before ResetTimer and teardown after StopTimer is not measured
+	class State
+	{
+	public:
+		State(uint64_t iterations) : Iterations(iterations), start(Clock::now()) {}
+
+		const uint64_t Iterations;
+
+		inline void ResetTimer() { start = Clock::now(); }
+		inline void StopTimer() { if (stop == Clock::time_point()) stop = Clock::now(); }
+
+		// Bytes processed by one iteration, reported as throughput
+		inline void SetBytesPerIteration(uint64_t bytes) { bytesPerIteration = bytes; }
+		inline void SetCounter(const std::string& name, double value) { counters[name] = value; }
+	private:
+		Clock::time_point start;
+		Clock::time_point stop;
+		uint64_t bytesPerIteration = 0;
+		std::map<std::string, double> counters;
+
+		friend class Runner;
+	};
+
+	using BenchmarkFunction = std::function<void(State&)>;
+
+	struct Result
+	{
+		std::string Name;
+		uint64_t Iterations = 0;
+		uint32_t Repetitions = 0;
+		double NsPerOp = 0; // Median of repetitions
+		double NsPerOpMin = 0;
+		double NsPerOpMax = 0;
+		double BytesPerSecond = 0;
+		std::map<std::string, double> Counters; // From last repetition
+	};
+
+	// Benchmarks are registered by name before run, filter selects those containing given text
+	class Runner
+	{
+	public:
+		static void Register(const std::string& name, BenchmarkFunction function);
+
+		// Iterations are doubled until one run takes at least minTime, then measured in several repetitions
+		static std::vector<Result> Run(const std::string& filter, double minTime, uint32_t repetitions);
+
+		static void WriteJson(std::ostream& os, const std::vector<Result>& results, const std::string& label, double minTime);
+	private:
+		static double Measure(const BenchmarkFunction& function, uint64_t iterations, Ref<State>& state);
+
+		static inline std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+	};
+}
\ No newline at end of file
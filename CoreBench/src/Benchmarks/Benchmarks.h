@@ -0,0 +1,9 @@
+#pragma once
+
+// Every file registers it's benchmarks, called from main in this order
+void RegisterBufferBenchmarks();
+void RegisterRefBenchmarks();
+void RegisterMessageQueueBenchmarks();
+void RegisterSerializationBenchmarks();
+void RegisterFileBenchmarks();
+void RegisterLoggerBenchmarks();
\ No newline at end of file
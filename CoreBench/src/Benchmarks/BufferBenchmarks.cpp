@@ -0,0 +1,42 @@
+#include "pch.h"
+#include "Benchmarks.h"
+#include "Bench/Benchmark.h"
+#include "Utils/Buffer.h"
+
+using namespace Bench;
+
+static void Allocate(State& state, uint32_t size)
+{
+	Buffer buffer;
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		buffer.Allocate(size);
+		DoNotOptimize(buffer.GetData());
+	}
+
+	state.SetBytesPerIteration(size);
+}
+
+static void Write(State& state, uint32_t size)
+{
+	std::vector<char> source(size, 'x');
+	Buffer buffer;
+
+	state.ResetTimer();
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		buffer.Write(source.data(), size);
+		DoNotOptimize(buffer.GetData());
+	}
+
+	state.SetBytesPerIteration(size);
+}
+
+void RegisterBufferBenchmarks()
+{
+	for (uint32_t size : { 64, 4 * 1024, 64 * 1024 })
+	{
+		Runner::Register("Buffer/Allocate/" + std::to_string(size), [size](State& state) { Allocate(state, size); });
+		Runner::Register("Buffer/Write/" + std::to_string(size), [size](State& state) { Write(state, size); });
+	}
+}
\ No newline at end of file
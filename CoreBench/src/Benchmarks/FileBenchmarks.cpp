@@ -0,0 +1,54 @@
+#include "pch.h"
+#include "Benchmarks.h"
+#include "Bench/Benchmark.h"
+#include "Utils/File.h"
+
+using namespace Bench;
+
+static File CreateTestFile(uint32_t size)
+{
+	Ref<Buffer> data = CreateRef<Buffer>(size);
+	memset(data->GetData(), 'x', size);
+
+	return File("assignment_submission.pdf", data, true);
+}
+
+static void Serialize(State& state, uint32_t size)
+{
+	File file = CreateTestFile(size);
+	Ref<Buffer> buffer;
+
+	state.ResetTimer();
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		file.Serialize(buffer);
+		DoNotOptimize(buffer->GetData());
+	}
+
+	state.SetBytesPerIteration(size);
+}
+
+static void Deserialize(State& state, uint32_t size)
+{
+	Ref<Buffer> buffer;
+	CreateTestFile(size).Serialize(buffer);
+
+	state.ResetTimer();
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		File file;
+		file.Deserialize(buffer);
+		DoNotOptimize(file.GetData()->GetData());
+	}
+
+	state.SetBytesPerIteration(size);
+}
+
+void RegisterFileBenchmarks()
+{
+	for (uint32_t size : { 1024, 64 * 1024, 1024 * 1024, 20 * 1024 * 1024 })
+	{
+		Runner::Register("File/Serialize/" + std::to_string(size), [size](State& state) { Serialize(state, size); });
+		Runner::Register("File/Deserialize/" + std::to_string(size), [size](State& state) { Deserialize(state, size); });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "pch.h"
+#include "Benchmarks.h"
+#include "Bench/Benchmark.h"
+#include "Debugging/Log.h"
+
+using namespace Bench;
+
+// Messages below logger level, cost paid by every disabled TRACE
+static void Filtered(State& state)
+{
+	Logger::level = Level::Debug;
+
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		TRACE("Message {0} of session {1}", i, 42u);
+		DoNotOptimize(i);
+	}
+}
+
+// Threads log in bursts of half the ring and wait for logger thread between them (Flush)
+// Time includes writing everything, so it's sustained throughput and not only cost of push
+static void Throughput(State& state, uint32_t threadCount)
+{
+	Logger::level = Level::Debug;
+
+	uint64_t perThread = std::max<uint64_t>(state.Iterations / threadCount, 1);
+	uint64_t burst = Logger::Capacity / 2 / threadCount;
+	uint64_t droppedBefore = Logger::GetDroppedCount();
+
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([perThread, burst]() {
+			for (uint64_t i = 0; i < perThread; i++)
+			{
+				INFO("Message {0} of session {1} ({2})", i, 42u, "chat");
+
+				if (i % burst == burst - 1)
+					FlushLogger();
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	FlushLogger();
+	state.StopTimer();
+
+	state.SetCounter("dropped", (double)(Logger::GetDroppedCount() - droppedBefore));
+}
+
+void RegisterLoggerBenchmarks()
+{
+	Runner::Register("Logger/Filtered", Filtered);
+
+	for (uint32_t threads : { 1, 4 })
+		Runner::Register("Logger/Throughput/" + std::to_string(threads), [threads](State& state) { Throughput(state, threads); });
+}
\ No newline at end of file
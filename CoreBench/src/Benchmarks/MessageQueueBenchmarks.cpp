@@ -0,0 +1,69 @@
+#include "pch.h"
+#include "Benchmarks.h"
+#include "Bench/Benchmark.h"
+#include "Networking/MessageQueue.h"
+
+using namespace Bench;
+
+// Producers add prepared messages (network threads), benchmark thread pops them like server's update loop
+// One iteration is one message passing through queue
+static void AddPop(State& state, uint32_t producerCount)
+{
+	Core::MessageQueue queue;
+
+	uint64_t perProducer = std::max<uint64_t>(state.Iterations / producerCount, 1);
+	uint64_t total = perProducer * producerCount;
+
+	std::vector<std::vector<Ref<Core::Message>>> messages(producerCount);
+	for (auto& producerMessages : messages)
+	{
+		producerMessages.reserve(perProducer);
+		for (uint64_t i = 0; i < perProducer; i++)
+			producerMessages.push_back(CreateRef<Core::Message>());
+	}
+
+	std::atomic<bool> start = false;
+	std::vector<std::thread> producers;
+	for (auto& producerMessages : messages)
+	{
+		producers.emplace_back([&queue, &start, &producerMessages]() {
+			while (!start.load(std::memory_order_acquire))
+				std::this_thread::yield();
+
+			for (auto& message : producerMessages)
+				queue.Add(std::move(message));
+		});
+	}
+
+	state.ResetTimer();
+	start.store(true, std::memory_order_release);
+
+	uint64_t popped = 0;
+	uint64_t emptyPolls = 0;
+	while (popped < total)
+	{
+		if (!queue.GetCount())
+		{
+			emptyPolls++;
+			std::this_thread::yield();
+			continue;
+		}
+
+		DoNotOptimize(queue.Get().Header);
+		queue.Pop();
+		popped++;
+	}
+
+	state.StopTimer();
+
+	for (auto& producer : producers)
+		producer.join();
+
+	state.SetCounter("empty_polls", (double)emptyPolls);
+}
+
+void RegisterMessageQueueBenchmarks()
+{
+	for (uint32_t producers : { 1, 2, 4, 8 })
+		Runner::Register("MessageQueue/AddPop/" + std::to_string(producers), [producers](State& state) { AddPop(state, producers); });
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "pch.h"
+#include "Benchmarks.h"
+#include "Bench/Benchmark.h"
+#include "Utils/Memory.h"
+
+using namespace Bench;
+
+struct Payload
+{
+	uint64_t Values[4] = {};
+};
+
+static void Copy(State& state)
+{
+	Ref<Payload> ref = CreateRef<Payload>();
+
+	state.ResetTimer();
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		Ref<Payload> copy(ref);
+		DoNotOptimize(copy.GetPtr());
+	}
+}
+
+static void Move(State& state)
+{
+	Ref<Payload> first = CreateRef<Payload>();
+	Ref<Payload> second;
+
+	state.ResetTimer();
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		second = std::move(first);
+		first = std::move(second);
+		DoNotOptimize(first.GetPtr());
+	}
+}
+
+// Allocation of object and it's reference count, and both deletes
+static void CreateDestroy(State& state)
+{
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		Ref<Payload> ref = CreateRef<Payload>();
+		DoNotOptimize(ref.GetPtr());
+	}
+}
+
+void RegisterRefBenchmarks()
+{
+	Runner::Register("Ref/Copy", Copy);
+	Runner::Register("Ref/Move", Move);
+	Runner::Register("Ref/CreateDestroy", CreateDestroy);
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "Benchmarks.h"
+#include "Bench/Benchmark.h"
+#include "Database/Command.h"
+#include "Database/Response.h"
+#include "Database/Statements.h"
+
+using namespace Bench;
+
+// Chat message sent by client
+static Core::Command CreateCommand()
+{
+	Core::Command command(1);
+	command.SetType(Core::CommandType::Command);
+	command.SetCommandString(Core::Statements::InsertMessage);
+	command.AddString("Hello team, the assignment is due on friday");
+	command.AddInt(12);
+	command.AddInt(345);
+
+	return command;
+}
+
+// Rows of chat history (id, content, author, sent at)
+static Core::Response CreateResponse(uint32_t rows)
+{
+	Core::Response response(1);
+	for (uint32_t i = 0; i < rows; i++)
+	{
+		response.AddInt(i);
+		response.AddString("Hello team, the assignment is due on friday");
+		response.AddInt(345);
+		response.AddTimestamp(1700000000 + i);
+	}
+
+	return response;
+}
+
+static void Serialize(State& state, const Core::CommandBase& command)
+{
+	Ref<Buffer> buffer;
+
+	state.ResetTimer();
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		command.Serialize(buffer);
+		DoNotOptimize(buffer->GetData());
+	}
+
+	state.SetBytesPerIteration(buffer->GetSize());
+}
+
+template<typename T>
+static void Deserialize(State& state, const T& command)
+{
+	Ref<Buffer> buffer;
+	command.Serialize(buffer);
+
+	state.ResetTimer();
+	for (uint64_t i = 0; i < state.Iterations; i++)
+	{
+		T result;
+		result.Deserialize(buffer);
+		DoNotOptimize(result.GetDataCount());
+	}
+
+	state.SetBytesPerIteration(buffer->GetSize());
+}
+
+void RegisterSerializationBenchmarks()
+{
+	Runner::Register("Command/Serialize", [](State& state) { Serialize(state, CreateCommand()); });
+	Runner::Register("Command/Deserialize", [](State& state) { Deserialize(state, CreateCommand()); });
+
+	// Single row, one page of chat and whole assignment list of big team
+	for (uint32_t rows : { 1, 40, 1000 })
+	{
+		Runner::Register("Response/Serialize/" + std::to_string(rows), [rows](State& state) { Serialize(state, CreateResponse(rows)); });
+		Runner::Register("Response/Deserialize/" + std::to_string(rows), [rows](State& state) { Deserialize(state, CreateResponse(rows)); });
+	}
+}
\ No newline at end of file
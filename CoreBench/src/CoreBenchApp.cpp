@@ -0,0 +1,73 @@
+#include "pch.h"
+#include "Debugging/Log.h"
+#include "Bench/Benchmark.h"
+#include "Benchmarks/Benchmarks.h"
+
+// Microbenchmarks of Core building blocks, results are written as JSON to compare builds
+// Usage: CoreBench [--filter <text>] [--out <file>] [--min-time <seconds>] [--repetitions <n>] [--label <text>]
+
+static void PrintUsage()
+{
+	printf("Usage: CoreBench [--filter <text>] [--out <file>] [--min-time <seconds>] [--repetitions <n>] [--label <text>]\n");
+	printf("  --filter       only benchmarks with name containing text\n");
+	printf("  --out          JSON results file (default corebench.json)\n");
+	printf("  --min-time     minimal duration of one repetition (default 0.05)\n");
+	printf("  --repetitions  measured repetitions, median is reported (default 5)\n");
+	printf("  --label        stored with results, e.g. version or commit\n");
+}
+
+int main(int argc, char** argv)
+{
+	std::string filter;
+	std::string outputPath = "corebench.json";
+	std::string label;
+	double minTime = 0.05;
+	uint32_t repetitions = 5;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+			filter = argv[++i];
+		else if (!strcmp(argv[i], "--out") && i + 1 < argc)
+			outputPath = argv[++i];
+		else if (!strcmp(argv[i], "--min-time") && i + 1 < argc)
+			minTime = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--repetitions") && i + 1 < argc)
+			repetitions = std::max(atoi(argv[++i]), 1);
+		else if (!strcmp(argv[i], "--label") && i + 1 < argc)
+			label = argv[++i];
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	SetLoggerTitle("CoreBench");
+
+	// Logger benchmarks write to binary log, so console stays readable and console speed is not measured
+	std::filesystem::path logPath = std::filesystem::temp_directory_path() / "corebench.blog";
+	if (!OpenLoggerBinaryFile(logPath.string().c_str()))
+		fprintf(stderr, "Binary log %s could not be opened, logger writes to console\n", logPath.string().c_str());
+
+	RegisterBufferBenchmarks();
+	RegisterRefBenchmarks();
+	RegisterMessageQueueBenchmarks();
+	RegisterSerializationBenchmarks();
+	RegisterFileBenchmarks();
+	RegisterLoggerBenchmarks();
+
+	std::vector<Bench::Result> results = Bench::Runner::Run(filter, minTime, repetitions);
+
+	std::ofstream file(outputPath);
+	if (!file)
+	{
+		fprintf(stderr, "Results file %s could not be opened\n", outputPath.c_str());
+		return 1;
+	}
+
+	Bench::Runner::WriteJson(file, results, label, minTime);
+	fprintf(stderr, "%zu results written to %s\n", results.size(), outputPath.c_str());
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+project "LoadGen"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+	staticruntime "off"
+
+    targetdir (outputdir .. "%{cfg.buildcfg}/%{prj.name}")
+	objdir (intoutputdir .. "%{cfg.buildcfg}/%{prj.name}")
+
+    pchheader "pch.h"
+	pchsource "src/pch.cpp"
+
+    files
+	{
+		"src/**.h",
+		"src/**.cpp",
+	}
+
+    includedirs
+    {
+        "src",
+        "%{wks.location}/Core/src",
+        "%{wks.location}/Client/src", -- Shared MessageResponses
+    }
+
+    links
+    {
+        "Core"
+    }
+
+    defines { "SYSTEM_CONSOLE" }
+
+    -- Static libraries don't carry their dependencies with gmake, Core's are linked here
+    filter "system:linux"
+        links { "bcrypt", "mysqlcppconn-static", "ssl", "crypto", "resolv", "pthread", "dl" }
+
+    filter { "system:linux", "options:asio-io-uring" }
+        links "uring"
+
+    filter "configurations:Debug"
+		defines "DEBUG_CONFIG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "RELEASE_CONFIG"
+		runtime "Release"
+        optimize "on"
+
+    filter "configurations:Distribution"
+		defines "DISTRIBUTION_CONFIG"
+		runtime "Release"
+        optimize "on"
\ No newline at end of file
@@ -0,0 +1,30 @@
+-- Seeds local dmp database with LoadGen users (loadgen0@dmp.test ... loadgen999@dmp.test)
+-- Every 50 users share a team owned by the first of them, each team has 3 assignments linked to all it's users
+-- Usage: mysql -u dmp -p dmp < LoadGen/seed.sql (keep users count in sync with loadgen.cfg)
+
+SET @users = 1000;
+SET @team_size = 50;
+SET SESSION cte_max_recursion_depth = 1000000;
+
+INSERT INTO users (first_name, last_name, email, password)
+WITH RECURSIVE seq (n) AS (SELECT 0 UNION ALL SELECT n + 1 FROM seq WHERE n + 1 < @users)
+SELECT 'Load', CONCAT('Gen', n), CONCAT('loadgen', n, '@dmp.test'), '' FROM seq;
+
+CREATE TEMPORARY TABLE loadgen_users AS
+SELECT id, CAST(SUBSTRING(email, 8, LOCATE('@', email) - 8) AS UNSIGNED) AS n FROM users WHERE email LIKE 'loadgen%@dmp.test';
+
+INSERT INTO teams (name, owner_id)
+SELECT CONCAT('LoadGen ', n DIV @team_size), id FROM loadgen_users WHERE n MOD @team_size = 0;
+
+INSERT INTO users_teams (user_id, team_id)
+SELECT loadgen_users.id, teams.id FROM loadgen_users JOIN teams ON teams.name = CONCAT('LoadGen ', loadgen_users.n DIV @team_size);
+
+INSERT INTO assignments (team_id, name, description, deadline)
+SELECT teams.id, CONCAT('LoadGen assignment ', numbers.n), 'Generated by LoadGen/seed.sql', NOW() + INTERVAL 30 DAY
+FROM teams CROSS JOIN (SELECT 1 AS n UNION ALL SELECT 2 UNION ALL SELECT 3) AS numbers WHERE teams.name LIKE 'LoadGen %';
+
+INSERT INTO users_assignments (user_id, assignment_id)
+SELECT users_teams.user_id, assignments.id FROM assignments JOIN users_teams ON users_teams.team_id = assignments.team_id
+WHERE assignments.description = 'Generated by LoadGen/seed.sql';
+
+DROP TEMPORARY TABLE loadgen_users;
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "pch.h"
+#include "LatencyRecorder.h"
+#include "Debugging/Log.h"
+#include "Client/MessageResponses.h"
+
+#include <cmath>
+
+namespace LoadGen
+{
+	void LatencyRecorder::Record(uint32_t taskId, std::chrono::steady_clock::duration latency)
+	{
+		TaskStats& stats = tasks[taskId];
+		stats.Latencies.push_back((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+		stats.Count++;
+
+		responseCount++;
+	}
+
+	void LatencyRecorder::Count(uint32_t taskId)
+	{
+		tasks[taskId].Count++;
+		responseCount++;
+	}
+
+	void LatencyRecorder::CountSent(const char* name)
+	{
+		sent[name]++;
+	}
+
+	void LatencyRecorder::Report(double duration)
+	{
+		if (duration <= 0.0)
+			return;
+
+		INFO("Report after {0} s, {1} responses ({2} responses/s)", duration, (size_t)responseCount, responseCount / duration);
+
+		for (auto& [taskId, stats] : tasks)
+		{
+			const char* name = Client::GetMessageResponseName((Client::MessageResponses)taskId);
+			double throughput = stats.Count / duration;
+
+			// Server broadcasts don't belong to any request, only their throughput is known
+			if (stats.Latencies.empty())
+			{
+				INFO("{0}: {1} received, {2}/s", name, (size_t)stats.Count, throughput);
+				continue;
+			}
+
+			std::sort(stats.Latencies.begin(), stats.Latencies.end());
+			INFO("{0}: {1} responses, {2}/s, p50 {3} ms, p99 {4} ms, p999 {5} ms, max {6} ms", name, (size_t)stats.Count, throughput,
+				GetPercentile(stats.Latencies, 0.5), GetPercentile(stats.Latencies, 0.99), GetPercentile(stats.Latencies, 0.999), stats.Latencies.back() / 1000.0);
+		}
+
+		for (auto& [name, count] : sent)
+			INFO("{0}: {1} sent, {2}/s", name, (size_t)count, count / duration);
+	}
+
+	// Nearest rank percentile in milliseconds
+	double LatencyRecorder::GetPercentile(const std::vector<uint32_t>& sorted, double percentile)
+	{
+		size_t rank = (size_t)std::ceil(percentile * sorted.size());
+		size_t index = rank ? std::min(rank - 1, sorted.size() - 1) : 0;
+
+		return sorted[index] / 1000.0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace LoadGen
+{
+	// Collects latencies of responses by their task id (MessageResponses) and counts of fire and forget traffic
+	// Used only from main thread
+	class LatencyRecorder
+	{
+	public:
+		LatencyRecorder() = default;
+
+		void Record(uint32_t taskId, std::chrono::steady_clock::duration latency);
+		void Count(uint32_t taskId); // Responses without request (server broadcasts)
+		void CountSent(const char* name); // Messages without response (chat messages, uploads)
+
+		// Prints throughput and latency percentiles of everything recorded during duration
+		void Report(double duration);
+
+		inline const uint64_t GetResponseCount() const { return responseCount; }
+	private:
+		struct TaskStats
+		{
+			std::vector<uint32_t> Latencies; // Microseconds
+			uint64_t Count = 0;
+		};
+
+		static double GetPercentile(const std::vector<uint32_t>& sorted, double percentile);
+
+		std::map<uint32_t, TaskStats> tasks;
+		std::map<std::string, uint64_t> sent;
+
+		uint64_t responseCount = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace LoadGen
+{
+	// Settings of simulated sessions, loaded from loadgen.cfg
+	struct ScriptSettings
+	{
+		std::string Address;
+		uint32_t Port = 0;
+
+		uint32_t Sessions = 0; // Count of simulated sessions
+		uint32_t RampUp = 100; // Sessions started per second, 0 starts all at once
+		uint32_t Duration = 60; // Seconds
+
+		// Sessions log in as <UserPrefix><n>@<UserDomain> where n = session index % Users (see LoadGen/seed.sql)
+		std::string UserPrefix = "loadgen";
+		std::string UserDomain = "dmp.test";
+		uint32_t Users = 1000;
+
+		uint32_t ThinkTime = 1000; // Milliseconds between script steps, randomized by +-50%
+		uint32_t ChatBurst = 5; // Messages sent in one chat step
+		uint32_t UploadEvery = 5; // Upload attachment every n-th iteration, 0 disables uploads
+		uint32_t UploadSize = 16 * 1024; // Bytes
+		bool ReactToUpdates = true; // Reload messages and assignments on server updates like ClientApp does
+	};
+}
\ No newline at end of file
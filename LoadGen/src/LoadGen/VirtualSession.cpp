@@ -0,0 +1,398 @@
+#include "pch.h"
+#include "VirtualSession.h"
+#include "Debugging/Log.h"
+#include "Database/Statements.h"
+#include "Client/MessageResponses.h"
+#include "Utils/File.h"
+
+using Client::MessageResponses;
+
+namespace LoadGen
+{
+	VirtualSession::VirtualSession(uint32_t index, const ScriptSettings& settings, LatencyRecorder& recorder)
+		: settings(settings), recorder(recorder), index(index), random(index)
+	{
+		email = settings.UserPrefix + std::to_string(settings.Users ? index % settings.Users : index) + "@" + settings.UserDomain;
+
+		std::string address = settings.Address;
+		networkInterface = Core::NetworkClientInterface::Create(address, settings.Port, messageQueue);
+	}
+
+	bool VirtualSession::Update(Clock::time_point now)
+	{
+		bool busy = false;
+
+		// Connection state is polled, connection events of all sessions go through the same application
+		if (networkInterface->IsConnected() != connected)
+		{
+			connected = !connected;
+
+			if (!connected)
+				OnConnectionLost();
+			else
+				StartStep(ScriptStep::Connecting);
+
+			busy = true;
+		}
+
+		while (messageQueue.GetCount())
+		{
+			ProcessMessage(messageQueue.Get());
+			messageQueue.Pop();
+
+			busy = true;
+		}
+
+		if (!connected || pending || step == ScriptStep::Failed)
+			return busy;
+
+		// Think after finished step like user would do
+		if (!stepFinished)
+		{
+			stepFinished = true;
+
+			if (step >= ScriptStep::LoadTeam)
+			{
+				uint32_t thinkTime = settings.ThinkTime / 2 + (settings.ThinkTime ? random() % settings.ThinkTime : 0);
+				nextStepTime = now + std::chrono::milliseconds(thinkTime);
+			}
+			else
+				nextStepTime = now;
+		}
+
+		if (now >= nextStepTime)
+		{
+			NextStep();
+			busy = true;
+		}
+
+		return busy;
+	}
+
+	void VirtualSession::ProcessMessage(Core::Message& message)
+	{
+		// Responses to requests are handled by their callbacks
+		if (requests.Complete(message))
+			return;
+
+		if (message.GetType() != Core::MessageType::Response)
+			return;
+
+		Core::Response response;
+		response.Deserialize(message.Body.Content);
+		recorder.Count(response.GetTaskId());
+
+		// Reload data on server updates like ClientApp does
+		if (!settings.ReactToUpdates || !teamId)
+			return;
+
+		switch ((MessageResponses)response.GetTaskId())
+		{
+			case MessageResponses::UpdateMessages:
+			{
+				if (!messagesReloading)
+					ReadSelectedTeamMessages();
+
+				break;
+			}
+			case MessageResponses::UpdateAssignments:
+			{
+				if (!assignmentsReloading)
+					ReadUsersAssignments();
+
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	// Everything in flight is lost with connection, script starts again with login after reconnect
+	void VirtualSession::OnConnectionLost()
+	{
+		requests.Clear();
+		messageQueue.Clear();
+
+		pending = 0;
+		messagesReloading = false;
+		assignmentsReloading = false;
+
+		userId = 0;
+		teamId = 0;
+		assignmentIds.clear();
+
+		StartStep(ScriptStep::Connecting);
+	}
+
+	void VirtualSession::NextStep()
+	{
+		switch (step)
+		{
+			case ScriptStep::Connecting:
+			{
+				StartStep(ScriptStep::Login);
+				SendLoginMessage();
+
+				break;
+			}
+			case ScriptStep::Login:
+			{
+				if (!userId)
+				{
+					WARN("Session {0} failed to login as {1}", index, email);
+					StartStep(ScriptStep::Failed);
+
+					break;
+				}
+
+				StartStep(ScriptStep::LoadTeams);
+				ReadUsersTeams();
+
+				break;
+			}
+			case ScriptStep::LoadTeams:
+			{
+				if (!teamId)
+				{
+					WARN("Session {0} ({1}) is not member of any team", index, email);
+					StartStep(ScriptStep::Failed);
+
+					break;
+				}
+
+				StartStep(ScriptStep::LoadTeam);
+				ReadSelectedTeamMessages();
+				ReadSelectedTeamUsers();
+				ReadUsersAssignments();
+
+				break;
+			}
+			case ScriptStep::LoadTeam:
+			case ScriptStep::Upload:
+			{
+				StartStep(ScriptStep::Chat);
+
+				for (uint32_t i = 0; i < settings.ChatBurst; i++)
+					SendChatMessage(i);
+
+				break;
+			}
+			case ScriptStep::Chat:
+			{
+				StartStep(ScriptStep::FetchAssignments);
+				ReadUsersAssignments();
+
+				break;
+			}
+			case ScriptStep::FetchAssignments:
+			{
+				iteration++;
+
+				if (settings.UploadEvery && iteration % settings.UploadEvery == 0 && !assignmentIds.empty())
+				{
+					StartStep(ScriptStep::Upload);
+					SendAttachment(assignmentIds[random() % assignmentIds.size()]);
+				}
+				else
+				{
+					StartStep(ScriptStep::Chat);
+
+					for (uint32_t i = 0; i < settings.ChatBurst; i++)
+						SendChatMessage(i);
+				}
+
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	void VirtualSession::StartStep(ScriptStep next)
+	{
+		step = next;
+		stepFinished = false;
+	}
+
+	void VirtualSession::SendRequest(Ref<Core::Message>& message, uint32_t taskId, const ResponseCallback& callback)
+	{
+		Clock::time_point sendTime = Clock::now();
+
+		message->Header.RequestId = requests.Register([this, taskId, sendTime, callback](Core::Message& responseMessage) {
+			recorder.Record(taskId, Clock::now() - sendTime);
+			pending--;
+
+			if (callback)
+			{
+				Core::Response response;
+				response.Deserialize(responseMessage.Body.Content);
+				callback(response);
+			}
+		});
+
+		pending++;
+		networkInterface->SendMessagePackets(message);
+	}
+
+	void VirtualSession::SendCommandMessage(Core::Command& command, const ResponseCallback& callback)
+	{
+		Ref<Core::Message> message = CreateRef<Core::Message>();
+		message->Header.Type = Core::MessageType::Command;
+		command.Serialize(message->Body.Content);
+		message->Header.Size = message->Body.Content->GetSize();
+
+		SendRequest(message, command.GetTaskId(), callback);
+	}
+
+	void VirtualSession::SendMessageWithoutResponse(Ref<Core::Message>& message, const char* name)
+	{
+		recorder.CountSent(name);
+		networkInterface->SendMessagePackets(message);
+	}
+
+	// Commands are the same as ClientApp sends
+
+	void VirtualSession::SendLoginMessage()
+	{
+		Core::Command command((uint32_t)MessageResponses::Login);
+		command.SetType(Core::CommandType::Query);
+
+		command.SetCommandString(Core::Statements::SelectLogin);
+		command.AddString(email);
+
+		// Password hash is not validated, it would measure bcrypt on load generator instead of the server
+		SendCommandMessage(command, [this](Core::Response& response) {
+			if (response.HasData())
+				userId = response.GetInt(0);
+		});
+	}
+
+	void VirtualSession::ReadUsersTeams()
+	{
+		Core::Command command((uint32_t)MessageResponses::ProcessTeams);
+		command.SetType(Core::CommandType::Query);
+
+		command.SetCommandString(Core::Statements::SelectUserTeams);
+		command.AddInt(userId);
+
+		SendCommandMessage(command, [this](Core::Response& response) {
+			if (response.HasData()) // Response: id , owner_id, name
+				teamId = response.GetInt(0);
+		});
+	}
+
+	void VirtualSession::ReadSelectedTeamMessages()
+	{
+		Core::Command command((uint32_t)MessageResponses::ProcessTeamMessages);
+		command.SetType(Core::CommandType::Query);
+
+		command.SetCommandString(Core::Statements::SelectTeamMessages);
+		command.AddInt(teamId);
+
+		messagesReloading = true;
+		SendCommandMessage(command, [this](Core::Response& response) { messagesReloading = false; });
+	}
+
+	void VirtualSession::ReadSelectedTeamUsers()
+	{
+		Core::Command command((uint32_t)MessageResponses::ProcessTeamUsers);
+		command.SetType(Core::CommandType::Query);
+
+		command.SetCommandString(Core::Statements::SelectTeamMembers);
+		command.AddInt(teamId);
+
+		SendCommandMessage(command);
+	}
+
+	// Like ClientApp, users and attachments of every assignment are read after assignments arrive
+	void VirtualSession::ReadUsersAssignments()
+	{
+		Core::Command command((uint32_t)MessageResponses::ProcessAssignments);
+		command.SetType(Core::CommandType::Query);
+
+		command.SetCommandString(Core::Statements::SelectUserAssignments);
+		command.AddInt(userId);
+		command.AddInt(teamId);
+
+		assignmentsReloading = true;
+		SendCommandMessage(command, [this](Core::Response& response) {
+			assignmentsReloading = false;
+			assignmentIds.clear();
+
+			for (uint32_t i = 0; i < response.GetDataCount(); i += 8) // Response: id, name, description, status, rating, rating_description, deadline, submitted_at
+			{
+				uint32_t assignmentId = response.GetInt(i);
+				assignmentIds.push_back(assignmentId);
+
+				ReadAssignmentsUsers(assignmentId);
+				ReadAssignmentsAttachments(assignmentId);
+			}
+		});
+	}
+
+	void VirtualSession::ReadAssignmentsUsers(uint32_t assignmentId)
+	{
+		Core::Command command((uint32_t)MessageResponses::ProcessAssignmentsUsers);
+		command.SetType(Core::CommandType::Query);
+
+		command.SetCommandString(Core::Statements::SelectAssignmentUsers);
+		command.AddInt(assignmentId);
+
+		SendCommandMessage(command);
+	}
+
+	void VirtualSession::ReadAssignmentsAttachments(uint32_t assignmentId)
+	{
+		Ref<Core::Message> message = CreateRef<Core::Message>();
+		message->Header.Type = Core::MessageType::ReadFileName;
+		message->CreateBody<uint32_t>(assignmentId);
+
+		SendRequest(message, (uint32_t)MessageResponses::ProcessAssignmentAttachments, ResponseCallback());
+	}
+
+	// Chat messages are not responded, server broadcasts UpdateMessages instead
+	void VirtualSession::SendChatMessage(uint32_t number)
+	{
+		std::string content = "LoadGen message " + std::to_string(number) + " from session " + std::to_string(index);
+
+		Core::Command command((uint32_t)MessageResponses::None);
+		command.SetType(Core::CommandType::Command);
+
+		command.SetCommandString(Core::Statements::InsertMessage);
+		command.AddString(content);
+		command.AddInt(teamId);
+		command.AddInt(userId);
+
+		Ref<Core::Message> message = CreateRef<Core::Message>();
+		message->Header.Type = Core::MessageType::Command;
+		command.Serialize(message->Body.Content);
+		message->Header.Size = message->Body.Content->GetSize();
+
+		SendMessageWithoutResponse(message, "ChatMessage");
+	}
+
+	// Uploads are not responded, server broadcasts UpdateAssignments instead
+	void VirtualSession::SendAttachment(uint32_t assignmentId)
+	{
+		if (!uploadData)
+		{
+			uploadData = CreateRef<Buffer>();
+
+			std::vector<char> content(settings.UploadSize);
+			for (uint32_t i = 0; i < settings.UploadSize; i++)
+				content[i] = 'a' + (i + index) % 26;
+
+			uploadData->Write(content.data(), content.size());
+		}
+
+		File attachment(("loadgen" + std::to_string(index) + ".txt").c_str(), uploadData, true);
+		attachment.SetId(assignmentId);
+
+		Ref<Core::Message> message = CreateRef<Core::Message>();
+		message->Header.Type = Core::MessageType::UploadFile;
+		attachment.Serialize(message->Body.Content);
+		message->Header.Size = message->Body.Content->GetSize();
+
+		SendMessageWithoutResponse(message, "UploadFile");
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+#include "Networking/NetworkClientInterface.h"
+#include "Networking/MessageQueue.h"
+#include "Networking/RequestTable.h"
+#include "Database/Command.h"
+#include "Database/Response.h"
+#include "LoadGen/ScriptSettings.h"
+#include "LoadGen/LatencyRecorder.h"
+
+namespace LoadGen
+{
+	// Steps of the script every session runs, steps after LoadTeam repeat until the end of the run
+	enum class ScriptStep
+	{
+		Connecting = 0,
+		Login,
+		LoadTeams,
+		LoadTeam, // Messages, users and assignments of the first team
+		Chat,
+		FetchAssignments,
+		Upload,
+		Failed, // Login or team load failed, session stays connected but idle
+	};
+
+	// Single simulated client with it's own connection, sending the same commands as ClientApp
+	class VirtualSession
+	{
+		using Clock = std::chrono::steady_clock;
+		using ResponseCallback = std::function<void(Core::Response&)>;
+	public:
+		VirtualSession(uint32_t index, const ScriptSettings& settings, LatencyRecorder& recorder);
+
+		// Processes received messages and advances script, returns true if anything has been done
+		bool Update(Clock::time_point now);
+
+		inline const bool IsConnected() const { return connected; }
+		inline const ScriptStep GetStep() const { return step; }
+		inline const uint32_t GetPendingCount() const { return pending; }
+	private:
+		void ProcessMessage(Core::Message& message);
+		void OnConnectionLost();
+
+		void NextStep();
+		void StartStep(ScriptStep next);
+
+		// Sending methods, requests are measured from sending until their response is processed
+		void SendRequest(Ref<Core::Message>& message, uint32_t taskId, const ResponseCallback& callback);
+		void SendCommandMessage(Core::Command& command, const ResponseCallback& callback = ResponseCallback());
+		void SendMessageWithoutResponse(Ref<Core::Message>& message, const char* name);
+
+		void SendLoginMessage();
+		void ReadUsersTeams();
+		void ReadSelectedTeamMessages();
+		void ReadSelectedTeamUsers();
+		void ReadUsersAssignments();
+		void ReadAssignmentsUsers(uint32_t assignmentId);
+		void ReadAssignmentsAttachments(uint32_t assignmentId);
+		void SendChatMessage(uint32_t number);
+		void SendAttachment(uint32_t assignmentId);
+
+		const ScriptSettings& settings;
+		LatencyRecorder& recorder;
+
+		uint32_t index;
+		std::string email;
+
+		// Queue has to outlive network interface, which fills it from it's own thread
+		Core::MessageQueue messageQueue;
+		Core::RequestTable requests;
+		Ref<Core::NetworkClientInterface> networkInterface;
+		bool connected = false;
+
+		ScriptStep step = ScriptStep::Connecting;
+		bool stepFinished = false;
+		uint32_t pending = 0; // Requests waiting for response, next step starts once all are completed
+		uint32_t iteration = 0;
+		Clock::time_point nextStepTime;
+		std::mt19937 random;
+
+		// Reloads triggered by server updates are coalesced, one of each kind can be pending
+		bool messagesReloading = false;
+		bool assignmentsReloading = false;
+
+		uint32_t userId = 0;
+		uint32_t teamId = 0;
+		std::vector<uint32_t> assignmentIds;
+		Ref<Buffer> uploadData;
+	};
+}
\ No newline at end of file
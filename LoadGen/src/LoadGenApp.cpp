@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "Core/EntryPoint.h"
+#include "Debugging/Log.h"
+#include "LoadGenApp.h"
+
+namespace LoadGen
+{
+	LoadGenApp::LoadGenApp(const Core::ApplicationSpecifications& specs) : Core::Application(specs)
+	{
+		SetLoggerTitle("LoadGen");
+
+		// Own config, so load generator can be run from server's directory
+		configFilePath = std::filesystem::current_path() / "loadgen.cfg";
+		LoadConfig();
+
+		sessions.reserve(settings.Sessions);
+
+		startTime = Clock::now();
+		lastProgressTime = startTime;
+
+		INFO("Running {0} sessions against {1}:{2} for {3} s", settings.Sessions, settings.Address, settings.Port, settings.Duration);
+	}
+
+	// Report is printed also when run is interrupted
+	LoadGenApp::~LoadGenApp()
+	{
+		recorder.Report(std::chrono::duration<double>(Clock::now() - startTime).count());
+
+		sessions.clear();
+	}
+
+	// Format (property: value), see ScriptSettings
+	void LoadGenApp::ReadConfigFile()
+	{
+		std::ifstream file(configFilePath);
+
+		std::string property;
+		while (file >> property)
+		{
+			if (property == "address:")
+				file >> settings.Address;
+			else if (property == "port:")
+				file >> settings.Port;
+			else if (property == "sessions:")
+				file >> settings.Sessions;
+			else if (property == "ramp_up:")
+				file >> settings.RampUp;
+			else if (property == "duration:")
+				file >> settings.Duration;
+			else if (property == "user_prefix:")
+				file >> settings.UserPrefix;
+			else if (property == "user_domain:")
+				file >> settings.UserDomain;
+			else if (property == "users:")
+				file >> settings.Users;
+			else if (property == "think_time:")
+				file >> settings.ThinkTime;
+			else if (property == "chat_burst:")
+				file >> settings.ChatBurst;
+			else if (property == "upload_every:")
+				file >> settings.UploadEvery;
+			else if (property == "upload_size:")
+				file >> settings.UploadSize;
+			else if (property == "react_to_updates:")
+				file >> settings.ReactToUpdates;
+			else
+				break;
+		}
+
+		if (!settings.Port || settings.Address.empty() || !settings.Sessions)
+		{
+			WriteConfigFile();
+			ReadConfigFile();
+		}
+	}
+
+	void LoadGenApp::WriteConfigFile()
+	{
+		std::ofstream file(configFilePath);
+		ScriptSettings defaults;
+
+		// Write default local target and script
+		file << "address: " << "127.0.0.1" << std::endl;
+		file << "port: " << 20000 << std::endl;
+		file << "sessions: " << 1000 << std::endl;
+		file << "ramp_up: " << defaults.RampUp << std::endl;
+		file << "duration: " << defaults.Duration << std::endl;
+		file << "user_prefix: " << defaults.UserPrefix << std::endl;
+		file << "user_domain: " << defaults.UserDomain << std::endl;
+		file << "users: " << defaults.Users << std::endl;
+		file << "think_time: " << defaults.ThinkTime << std::endl;
+		file << "chat_burst: " << defaults.ChatBurst << std::endl;
+		file << "upload_every: " << defaults.UploadEvery << std::endl;
+		file << "upload_size: " << defaults.UploadSize << std::endl;
+		file << "react_to_updates: " << defaults.ReactToUpdates << std::endl;
+	}
+
+	void LoadGenApp::ProcessMessageQueue()
+	{
+		Clock::time_point now = Clock::now();
+
+		StartSessions(now);
+
+		bool busy = false;
+		for (auto& session : sessions)
+			busy |= session->Update(now);
+
+		PrintProgress(now);
+
+		if (now - startTime >= std::chrono::seconds(settings.Duration))
+		{
+			isRunning = false;
+			isApplicationRunning = false;
+		}
+
+		// Don't spin while all sessions are thinking
+		if (!busy)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// Sessions are started gradually, so the server is not flooded by connects
+	void LoadGenApp::StartSessions(Clock::time_point now)
+	{
+		uint32_t target = settings.Sessions;
+		if (settings.RampUp)
+		{
+			double elapsed = std::chrono::duration<double>(now - startTime).count();
+			target = std::min(settings.Sessions, (uint32_t)(elapsed * settings.RampUp) + 1);
+		}
+
+		while (sessions.size() < target)
+			sessions.push_back(new VirtualSession(sessions.size(), settings, recorder));
+	}
+
+	void LoadGenApp::PrintProgress(Clock::time_point now)
+	{
+		if (now - lastProgressTime < std::chrono::seconds(5))
+			return;
+
+		uint32_t connected = 0;
+		uint32_t failed = 0;
+		uint32_t pending = 0;
+		for (auto& session : sessions)
+		{
+			connected += session->IsConnected();
+			failed += session->GetStep() == ScriptStep::Failed;
+			pending += session->GetPendingCount();
+		}
+
+		double interval = std::chrono::duration<double>(now - lastProgressTime).count();
+		double throughput = (recorder.GetResponseCount() - lastProgressResponses) / interval;
+
+		INFO("{0}/{1} sessions connected, {2} failed, {3} requests pending, {4} responses/s", connected, (uint32_t)sessions.size(), failed, pending, throughput);
+
+		lastProgressTime = now;
+		lastProgressResponses = recorder.GetResponseCount();
+	}
+}
+
+Core::Application* Core::CreateApplication(const Core::CommandArgs& args)
+{
+	Core::ApplicationSpecifications specs;
+	specs.Title = "LoadGen";
+	specs.Args = args;
+	specs.HasWindow = false;
+
+	return new LoadGen::LoadGenApp(specs);
+}
\ No newline at end of file
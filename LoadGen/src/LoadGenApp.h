@@ -0,0 +1,35 @@
+#pragma once
+#include "Core/Application.h"
+#include "LoadGen/ScriptSettings.h"
+#include "LoadGen/LatencyRecorder.h"
+#include "LoadGen/VirtualSession.h"
+
+namespace LoadGen
+{
+	// Headless application simulating many client sessions against the server
+	class LoadGenApp : public Core::Application
+	{
+		using Clock = std::chrono::steady_clock;
+	public:
+		LoadGenApp(const Core::ApplicationSpecifications& specs);
+		~LoadGenApp();
+	private:
+		// Config file methods
+		void ReadConfigFile() override;
+		void WriteConfigFile() override;
+
+		// Runs sessions' scripts instead of processing single message queue
+		virtual void ProcessMessageQueue() override;
+
+		void StartSessions(Clock::time_point now);
+		void PrintProgress(Clock::time_point now);
+
+		ScriptSettings settings;
+		LatencyRecorder recorder;
+		std::vector<Ref<VirtualSession>> sessions;
+
+		Clock::time_point startTime;
+		Clock::time_point lastProgressTime;
+		uint64_t lastProgressResponses = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+// Precompiled headers for LoadGen
+
+// Basic usage
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+// Data structers
+#include <deque>
+#include <string>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+
+// Files
+#include <fstream>
+#include <filesystem>
+
+// Others
+#include <mutex>
+#include <thread>
+#include <iomanip>
+#include <chrono>
+#include <random>
+
+#include <regex>
+#include <ctime>
+#include <any>
+
+// Data types typedefs
+#include <cstdint>
\ No newline at end of file
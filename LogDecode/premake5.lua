@@ -0,0 +1,37 @@
+project "LogDecode"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+	staticruntime "off"
+
+    targetname "logdecode"
+    targetdir (outputdir .. "%{cfg.buildcfg}/%{prj.name}")
+	objdir (intoutputdir .. "%{cfg.buildcfg}/%{prj.name}")
+
+    files
+	{
+		"src/**.h",
+		"src/**.cpp",
+	}
+
+    -- Only header-only log format is used, Core is not linked
+    includedirs
+    {
+        "src",
+        "%{wks.location}/Core/src",
+    }
+
+    filter "configurations:Debug"
+		defines "DEBUG_CONFIG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "RELEASE_CONFIG"
+		runtime "Release"
+        optimize "on"
+
+    filter "configurations:Distribution"
+		defines "DISTRIBUTION_CONFIG"
+		runtime "Release"
+        optimize "on"
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+
+#include "Debugging/BinaryLog.h"
+#include "Debugging/LogRecord.h"
+
+// Renders binary log written by Logger as the same text Logger writes to console
+// Usage: logdecode <file> [--plain] [--level <trace|debug|info|warning|error>]
+
+struct DecodedFormat
+{
+	std::string Text;
+	CompiledFormat Format;
+};
+
+static void PrintUsage()
+{
+	printf("Usage: logdecode <file> [--plain] [--level <trace|debug|info|warning|error>]\n");
+	printf("  --plain  no color codes\n");
+	printf("  --level  only messages with at least this level\n");
+}
+
+int main(int argc, char** argv)
+{
+	const char* path = nullptr;
+	bool colors = true;
+	Level minimalLevel = Level::Trace;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--plain"))
+			colors = false;
+		else if (!strcmp(argv[i], "--level") && i + 1 < argc)
+			minimalLevel = GetLevel(argv[++i]);
+		else if (!path && argv[i][0] != '-')
+			path = argv[i];
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (!path)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		fprintf(stderr, "File %s could not be opened\n", path);
+		return 1;
+	}
+
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	BinaryLog::FileHeader fileHeader;
+	if (data.size() < sizeof(fileHeader) || memcmp(data.data(), BinaryLog::Magic, sizeof(BinaryLog::Magic)))
+	{
+		fprintf(stderr, "%s is not binary log\n", path);
+		return 1;
+	}
+
+	memcpy(&fileHeader, data.data(), sizeof(fileHeader));
+	if (fileHeader.Version != BinaryLog::Version)
+	{
+		fprintf(stderr, "Unsupported binary log version %u (expected %u)\n", fileHeader.Version, BinaryLog::Version);
+		return 1;
+	}
+
+	// Nodes of unordered_map don't move, so formats can point to their own text
+	std::unordered_map<uint64_t, DecodedFormat> formats;
+	std::unordered_map<uint64_t, std::string> titles;
+
+	std::string output;
+	LogRecord record;
+	uint64_t messageCount = 0;
+
+	size_t position = sizeof(fileHeader);
+	while (position < data.size())
+	{
+		BinaryLog::RecordType type = (BinaryLog::RecordType)data[position];
+
+		if (type == BinaryLog::RecordType::Format || type == BinaryLog::RecordType::Title)
+		{
+			BinaryLog::StringRecord header;
+			if (position + sizeof(header) > data.size())
+				break;
+
+			memcpy(&header, data.data() + position, sizeof(header));
+			if (position + sizeof(header) + header.Length > data.size())
+				break;
+
+			std::string text(data.data() + position + sizeof(header), header.Length);
+			position += sizeof(header) + header.Length;
+
+			if (type == BinaryLog::RecordType::Title)
+				titles[header.Id] = text;
+			else
+			{
+				DecodedFormat& format = formats[header.Id];
+				format.Text = text;
+				ParseFormat(format.Format, format.Text.c_str(), LogRecord::MaxArgs);
+			}
+		}
+		else if (type == BinaryLog::RecordType::Message)
+		{
+			BinaryLog::MessageRecord header;
+			if (position + sizeof(header) > data.size())
+				break;
+
+			memcpy(&header, data.data() + position, sizeof(header));
+			if (header.Size > LogRecord::DataSize || position + sizeof(header) + header.Size > data.size())
+				break;
+
+			const char* arguments = data.data() + position + sizeof(header);
+			position += sizeof(header) + header.Size;
+
+			if ((Level)header.MessageLevel < minimalLevel)
+				continue;
+
+			auto format = formats.find(header.FormatId);
+			if (format == formats.end())
+			{
+				fprintf(stderr, "Unknown format id %llx\n", (unsigned long long)header.FormatId);
+				continue;
+			}
+
+			auto title = titles.find(header.TitleId);
+
+			record.MessageLevel = (Level)header.MessageLevel;
+			record.Core = header.Core;
+			record.ArgCount = header.ArgCount;
+			record.Size = header.Size;
+			record.Time = header.Time;
+			record.Title = title != titles.end() ? title->second.c_str() : nullptr;
+			record.Format = format->second.Format;
+			memcpy(record.Data, arguments, header.Size);
+
+			record.AppendLine(output, colors);
+			messageCount++;
+
+			if (output.size() > 64 * 1024)
+			{
+				fwrite(output.data(), 1, output.size(), stdout);
+				output.clear();
+			}
+		}
+		else
+			break; // End of written data (zeros) or unfinished record
+	}
+
+	if (colors)
+		output += "\033[0m";
+
+	fwrite(output.data(), 1, output.size(), stdout);
+	fprintf(stderr, "%llu messages decoded\n", (unsigned long long)messageCount);
+
+	return 0;
+}
\ No newline at end of file
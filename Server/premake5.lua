@@ -4,8 +4,8 @@ project "Server"
     cppdialect "C++20"
 	staticruntime "off"
 
-    targetdir (outputdir .. "$(Configuration)/$(ProjectName)")
-	objdir (intoutputdir .. "$(Configuration)/$(ProjectName)")
+    targetdir (outputdir .. "%{cfg.buildcfg}/%{prj.name}")
+	objdir (intoutputdir .. "%{cfg.buildcfg}/%{prj.name}")
 
     pchheader "pch.h"
 	pchsource "src/pch.cpp"
@@ -19,7 +19,7 @@ project "Server"
     includedirs
     {
         "src",
-        "$(SolutionDir)Core/src",
+        "%{wks.location}/Core/src",
     }
 
     links
@@ -29,6 +29,17 @@ project "Server"
 
     defines { "SYSTEM_CONSOLE" }
 
+    -- Static libraries don't carry their dependencies with gmake, Core's are linked here
+    -- Linux expects libbcrypt and mysql connector installed in system (see vendor/Bcrypt/README.md)
+    filter "system:linux"
+        links { "bcrypt", "mysqlcppconn-static", "ssl", "crypto", "resolv", "pthread", "dl" }
+
+    filter { "system:linux", "options:asio-io-uring" }
+        links "uring"
+
+    filter "options:sqlite"
+        links "sqlite3"
+
     filter "configurations:Debug"
 		defines "DEBUG_CONFIG"
 		runtime "Debug"
@@ -0,0 +1,246 @@
+#include "pch.h"
+#include "AttachmentStore.h"
+#include "Debugging/Log.h"
+#include "Debugging/Metrics.h"
+#include "Database/Command.h"
+#include "Database/Response.h"
+#include "Database/Statements.h"
+
+#include "Utils/File.h"
+#include "Utils/FileReader.h"
+#include "Utils/FileMapping.h"
+#include "Utils/SHA256.h"
+
+namespace Server
+{
+	static Core::Gauge storedContents = Core::Metrics::GetGauge("attachments_stored");
+	static Core::Counter deduplicatedUploads = Core::Metrics::GetCounter("attachments_deduplicated_total");
+	static Core::Counter mappingHits = Core::Metrics::GetCounter("attachments_mapping_hits_total");
+
+	void AttachmentStore::Load(Core::DatabaseInterface& database)
+	{
+		storedContents.Sub(references.size());
+		references.clear();
+		loaded = false;
+
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+
+		Core::Command command;
+		command.SetType(Core::CommandType::Query);
+		command.SetCommandString(Core::Statements::SelectAttachmentContents);
+
+		if (!database.Query(command))
+		{
+			ERROR("Attachments could not be read, unreferenced files are kept!");
+			return;
+		}
+
+		Core::Response response;
+		database.FetchData(response);
+
+		for (uint32_t i = 0; i < response.GetDataCount(); i += 2)
+		{
+			std::string path = response.GetString(i + 1);
+			if (SHA256::IsHexDigest(path))
+				AddReference(path);
+			else
+				MigrateAttachment(database, response.GetInt(i), path);
+		}
+
+		// Rows could have been deleted while server was not running (memory database loses all of them)
+		// Contents being written are not referenced yet, rows are inserted after they are written
+		for (auto& entry : std::filesystem::directory_iterator(directory, error))
+		{
+			std::string name = entry.path().filename().string();
+			std::string hash = name.ends_with(".tmp") ? name.substr(0, name.size() - 4) : name;
+
+			if (SHA256::IsHexDigest(hash) && !references.contains(name) && !writing.contains(hash))
+				std::filesystem::remove(entry.path(), error);
+		}
+
+		loaded = true;
+
+		INFO("{0} attachment files stored for {1} attachments", (uint32_t)references.size(), response.GetDataCount() / 2);
+	}
+
+	void AttachmentStore::Add(const std::string& hash, Ref<Buffer> body, uint32_t offset, uint32_t size, AddCallback&& completion)
+	{
+		if (references.contains(hash))
+		{
+			AddReference(hash);
+			deduplicatedUploads.Add();
+			completion(true);
+			return;
+		}
+
+		// Same content uploaded again before it was written waits for the first write
+		auto waiting = writing.find(hash);
+		if (waiting != writing.end())
+		{
+			waiting->second.push_back(std::move(completion));
+			deduplicatedUploads.Add();
+			return;
+		}
+
+		writing[hash].push_back(std::move(completion));
+
+		io.Submit([this, hash, body = std::move(body), offset, size]() mutable {
+			bool success = Write(hash, body->GetData() + offset, size);
+
+			io.Complete([this, hash, body = std::move(body), success]() { Stored(hash, success); });
+		});
+	}
+
+	void AttachmentStore::Stored(const std::string& hash, bool success)
+	{
+		auto waiting = writing.find(hash);
+		if (waiting == writing.end())
+			return;
+
+		std::vector<AddCallback> completions = std::move(waiting->second);
+		writing.erase(waiting);
+
+		for (AddCallback& completion : completions)
+		{
+			if (success)
+				AddReference(hash);
+
+			completion(success);
+		}
+	}
+
+	void AttachmentStore::Release(const std::string& hash)
+	{
+		auto reference = references.find(hash);
+		if (reference == references.end() || --reference->second)
+			return;
+
+		references.erase(reference);
+		storedContents.Sub();
+
+		// Without counts of all rows file could still be referred to by rows which were not counted
+		if (!loaded)
+			return;
+
+		// Removing is cheap and doing it here keeps it ordered with writes of the same content
+		// On Windows file viewed by download in progress can't be removed, it's removed on next start instead
+		mappings.erase(hash);
+
+		std::error_code error;
+		std::filesystem::remove(directory / hash, error);
+	}
+
+	void AttachmentStore::Read(const std::string& hash, ReadCallback&& completion)
+	{
+		// Popular file is mapped once, every download gets it's own buffer viewing the same mapping
+		auto cached = mappings.find(hash);
+		if (cached != mappings.end())
+		{
+			mappingHits.Add();
+
+			Ref<Buffer> data = CreateRef<Buffer>(cached->second);
+			completion(data);
+			return;
+		}
+
+		io.Submit([this, hash, path = directory / hash, completion = std::move(completion)]() mutable {
+			std::shared_ptr<const FileMapping> mapping = FileMapping::Open(path);
+
+			// Empty file can't be mapped
+			Ref<Buffer> data = mapping ? Ref<Buffer>() : FileReader::ReadFile(path);
+
+			io.Complete([this, hash = std::move(hash), mapping = std::move(mapping), data = std::move(data), completion = std::move(completion)]() mutable {
+				if (mapping)
+				{
+					CacheMapping(hash, mapping);
+					data = CreateRef<Buffer>(mapping);
+				}
+
+				completion(data);
+			});
+		});
+	}
+
+	// Mappings held only by cache are dropped when it's full, if all of them are in use, new one isn't cached
+	void AttachmentStore::CacheMapping(const std::string& hash, const std::shared_ptr<const FileMapping>& mapping)
+	{
+		if (!references.contains(hash))
+			return;
+
+		if (mappings.size() >= MaxMappings)
+			std::erase_if(mappings, [](const auto& entry) { return entry.second.use_count() == 1; });
+
+		if (mappings.size() < MaxMappings)
+			mappings[hash] = mapping;
+	}
+
+	void AttachmentStore::AddReference(const std::string& hash)
+	{
+		if (!references[hash]++)
+			storedContents.Add();
+	}
+
+	bool AttachmentStore::Write(const std::string& hash, const char* data, uint32_t size) const
+	{
+		// Content is written under temporary name, so partially written file is never taken for stored one
+		std::filesystem::path path = directory / hash;
+		std::filesystem::path temporaryPath = directory / (hash + ".tmp");
+
+		std::ofstream stream(temporaryPath, std::ios::binary);
+		bool success = stream && stream.write(data, size);
+		stream.close();
+
+		std::error_code error;
+		if (success)
+			std::filesystem::rename(temporaryPath, path, error);
+
+		if (!success || error)
+		{
+			ERROR("Attachment {0} could not be stored!", hash);
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		return true;
+	}
+
+	// Before store, attachment was serialized file with it's name, named by display name
+	// Old attachments are moved once, while loading on start, so it doesn't use I/O threads
+	void AttachmentStore::MigrateAttachment(Core::DatabaseInterface& database, int id, const std::string& fileName)
+	{
+		std::filesystem::path oldPath = directory / fileName;
+
+		Ref<Buffer> serialized = FileReader::ReadFile(oldPath);
+		if (!serialized)
+		{
+			WARN("Attachment {0} could not be moved into store, {1} could not be read", id, fileName);
+			return;
+		}
+
+		File file;
+		file.Deserialize(serialized);
+
+		std::string hash = SHA256::Hash(file.GetData()->GetDataAs<uint8_t>(), file.GetData()->GetSize());
+		if (!references.contains(hash) && !Write(hash, file.GetData()->GetData(), file.GetData()->GetSize()))
+			return;
+
+		AddReference(hash);
+
+		Core::Command command;
+		command.SetType(Core::CommandType::Update);
+		command.SetCommandString(Core::Statements::UpdateAttachment);
+		command.AddString(hash);
+		command.AddString(file.GetName());
+		command.AddInt(id);
+
+		if (!database.Update(command))
+		{
+			Release(hash);
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::remove(oldPath, error);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include "Database/DatabaseInterface.h"
+#include "Utils/Buffer.h"
+#include "Utils/Memory.h"
+#include "Utils/FileIOPool.h"
+#include "Utils/FileMapping.h"
+
+namespace Server
+{
+	// Content addressed store of attachment files, every content is stored once in directory/<SHA-256 of content>
+	// Rows of attachments table refer to their content by hash in file_path, name shown to users is in file_name
+	// Reference counts are rebuilt from attachments table on start, file is removed with the last row referring to it
+	// Contents are read and written on I/O threads, completions are called on processing thread
+	// Read contents are memory mapped, mappings of recently read ones are kept, so downloads of the same file share them
+	class AttachmentStore
+	{
+	public:
+		static inline uint32_t MaxMappings = 64;
+
+		using AddCallback = std::function<void(bool stored)>;
+		using ReadCallback = std::function<void(Ref<Buffer>& data)>;
+
+		AttachmentStore(const std::filesystem::path& directory, FileIOPool& io) : directory(directory), io(io) {}
+
+		// Counts references, moves files of old name addressed rows into store and removes unreferenced content
+		void Load(Core::DatabaseInterface& database);
+
+		// Adds reference to size bytes of body from offset, completion is called once content is stored (right away if it already is)
+		// Content is written only if it isn't stored or being written yet
+		void Add(const std::string& hash, Ref<Buffer> body, uint32_t offset, uint32_t size, AddCallback&& completion);
+		void Release(const std::string& hash);
+
+		// Completion gets read only buffer viewing mapped content, empty buffer if content couldn't be read
+		void Read(const std::string& hash, ReadCallback&& completion);
+	private:
+		void MigrateAttachment(Core::DatabaseInterface& database, int id, const std::string& fileName);
+
+		void AddReference(const std::string& hash);
+		void CacheMapping(const std::string& hash, const std::shared_ptr<const FileMapping>& mapping);
+		void Stored(const std::string& hash, bool success);
+
+		// Called from I/O threads too, uses only directory
+		bool Write(const std::string& hash, const char* data, uint32_t size) const;
+
+		std::filesystem::path directory;
+		FileIOPool& io;
+
+		std::unordered_map<std::string, uint32_t> references; // Hash to number of rows referring to it
+		std::unordered_map<std::string, std::vector<AddCallback>> writing; // Contents being written, with completions waiting for them
+		std::unordered_map<std::string, std::shared_ptr<const FileMapping>> mappings;
+		bool loaded = false; // All rows were counted, only then unreferenced files are removed
+	};
+}
\ No newline at end of file
@@ -5,9 +5,11 @@
 
 #include "Database/Command.h"
 #include "Database/Response.h"
+#include "Database/Statements.h"
+#include "Database/StatementParser.h"
+#include "Networking/FrameCompression.h"
 
-#include "Utils/FileWriter.h"
-#include "Utils/FileReader.h"
+#include "Utils/SHA256.h"
 
 namespace Server
 {
@@ -17,9 +19,48 @@ namespace Server
 
 		LoadConfig();
 
-		databaseInterface = Core::DatabaseInterface::Create("tcp://127.0.0.1:3306", "dmp", "dmp", "Tester_123");
+		SetLoggerLevel(logLevel);
+		if (logFile != "none")
+		{
+			if (OpenLoggerBinaryFile(logFile.c_str()))
+				INFO("Binary log written to {0}, only warnings and errors are written to console", logFile);
+			else
+				ERROR("Binary log {0} could not be opened!", logFile);
+		}
+
+		for (uint32_t i = 0; i <= Core::MessageTypeCount; i++)
+		{
+			std::string label = std::string("{type=\"") + Core::GetMessageTypeName((Core::MessageType)i) + "\"}";
+			processedMessages[i] = Core::Metrics::GetCounter("server_messages_total" + label);
+			messageDurations[i] = Core::Metrics::GetHistogram("server_message_duration_us" + label);
+		}
+
+		Core::Metrics::StartDump(metricsFile, metricsInterval);
+		Core::Tracing::Start(traceSample);
+
+		databaseInterface = Core::DatabaseInterface::Create(databaseSpecs);
+		Core::Metrics::GetGauge("db_pool_connections_max").Add(1);
+
+		queryCache = CreateRef<Core::QueryCache>((size_t)queryCacheSize * 1024 * 1024);
+		changeLog = CreateRef<Core::ChangeLog>();
+
+		fileIO = CreateRef<FileIOPool>(fileIOThreads);
+		attachmentStore = CreateRef<AttachmentStore>(dir, *fileIO);
+
 		networkInterface = Core::NetworkServerInterface::Create(port, messageQueue, sessions);
 		INFO("Running on port {0}", port);
+
+		if (statsPort)
+			networkInterface->StartStatsEndpoint(statsPort);
+	}
+
+	ServerApp::~ServerApp()
+	{
+		// Network thread is stopped before sessions it uses are released
+		networkInterface = Ref<Core::NetworkServerInterface>();
+
+		if (traceSample)
+			Core::Tracing::Export(traceFile);
 	}
 
 	void ServerApp::OnEvent(Core::Event& e)
@@ -32,16 +73,51 @@ namespace Server
 		Core::Event::Dispatch<Core::MessageAcceptedEvent>(e, [this](Core::MessageAcceptedEvent& e) { OnMessageAccepted(e); });
 	}
 
-	// Format (port: 20000)
+	// Format (property: value), database is one of mysql, sqlite, memory, log_level one of trace, debug, info, warning, error
 	void ServerApp::ReadConfigFile()
 	{
 		std::ifstream file(configFilePath);
 
 		std::string property;
-		file >> property;
-
-		if (property == "port:")
-			file >> port;
+		while (file >> property)
+		{
+			if (property == "port:")
+				file >> port;
+			else if (property == "database:")
+			{
+				std::string backend;
+				file >> backend;
+				databaseSpecs.Backend = Core::DatabaseInterface::GetBackend(backend);
+			}
+			else if (property == "database_file:")
+				file >> databaseSpecs.FilePath;
+			else if (property == "database_seed:")
+				file >> databaseSpecs.SeedUsers;
+			else if (property == "log_level:")
+				file >> logLevel;
+			else if (property == "log_file:")
+				file >> logFile;
+			else if (property == "metrics_file:")
+				file >> metricsFile;
+			else if (property == "metrics_interval:")
+				file >> metricsInterval;
+			else if (property == "stats_port:")
+				file >> statsPort;
+			else if (property == "trace_sample:")
+				file >> traceSample;
+			else if (property == "trace_file:")
+				file >> traceFile;
+			else if (property == "query_cache_size:")
+				file >> queryCacheSize;
+			else if (property == "compression_threshold:")
+				file >> Core::FrameCompression::Threshold;
+			else if (property == "file_io_threads:")
+				file >> fileIOThreads;
+			else if (property == "shutdown_timeout:")
+				file >> shutdownTimeout;
+			else
+				break;
+		}
 
 		if (!port)
 		{
@@ -50,13 +126,27 @@ namespace Server
 		}
 	}
 
-	// Format (port: 20000)
 	void ServerApp::WriteConfigFile()
 	{
 		std::ofstream file(configFilePath);
+		Core::DatabaseSpecifications defaults;
 
-		// Write default port
+		// Write default port and database
 		file << "port: " << 20000 << std::endl;
+		file << "database: " << Core::DatabaseInterface::GetBackendName(defaults.Backend) << std::endl;
+		file << "database_file: " << defaults.FilePath << std::endl;
+		file << "database_seed: " << defaults.SeedUsers << std::endl;
+		file << "log_level: " << "debug" << std::endl;
+		file << "log_file: " << "none" << std::endl;
+		file << "metrics_file: " << "metrics.txt" << std::endl;
+		file << "metrics_interval: " << 10 << std::endl;
+		file << "stats_port: " << 0 << std::endl;
+		file << "trace_sample: " << 0 << std::endl;
+		file << "trace_file: " << "trace.json" << std::endl;
+		file << "query_cache_size: " << 64 << std::endl;
+		file << "compression_threshold: " << 1024 << std::endl;
+		file << "file_io_threads: " << 2 << std::endl;
+		file << "shutdown_timeout: " << 30 << std::endl;
 	}
 
 	void ServerApp::OnClientConnected(Core::ConnectedEvent& e)
@@ -83,59 +173,150 @@ namespace Server
 	{
 		while (!databaseInterface->IsConnected())
 		{
+			if (databaseConnected)
+			{
+				databaseConnections.Sub();
+				databaseConnected = false;
+			}
+
+			databaseReconnects.Add();
 			networkInterface->DisconnectAllClients();
 			databaseInterface->Reconnect();
+
+			// Database could have changed while server was disconnected
+			queryCache->Clear();
+			changeLog->Reset();
+		}
+
+		if (!databaseConnected)
+		{
+			databaseConnections.Add();
+			databaseConnected = true;
+
+			// References are counted again, attachments could have changed while server was disconnected
+			attachmentStore->Load(*databaseInterface);
 		}
 
+		// Finished disk reads and writes continue where their messages stopped
+		fileIO->ProcessCompletions();
+
 		for (uint32_t i = 0; i < messageQueue.GetCount(); i++)
 			ProcessMessage();
+
+		if (draining)
+			Drain();
+	}
+
+	void ServerApp::OnShutdownRequested()
+	{
+		if (draining)
+		{
+			WARN("Shutdown requested again, stopping without drain");
+			Application::OnShutdownRequested();
+			return;
+		}
+
+		// Clients reconnect to other servers, ones connected here get responses of requests already accepted first
+		draining = true;
+		drainDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(shutdownTimeout);
+		networkInterface->StopAccepting();
+
+		INFO("Shutting down, draining {0} queued messages and {1} file operations", messageQueue.GetCount(), fileIO->GetPendingCount());
+	}
+
+	// Stops server once accepted messages are processed, their files written or read and responses written to sockets
+	void ServerApp::Drain()
+	{
+		uint32_t queuedMessages = messageQueue.GetCount();
+		uint32_t fileOperations = fileIO->GetPendingCount();
+		uint32_t queuedResponses = networkInterface->GetQueuedCount();
+
+		if (!queuedMessages && !fileOperations && !queuedResponses)
+			INFO("Drained, stopping");
+		else if (std::chrono::steady_clock::now() >= drainDeadline)
+			WARN("Shutdown timeout expired, dropping {0} queued messages, {1} file operations and {2} responses", queuedMessages, fileOperations, queuedResponses);
+		else
+			return;
+
+		Application::OnShutdownRequested();
 	}
 
 	void ServerApp::ProcessMessage()
 	{
 		Core::Message& message = messageQueue.Get();
 
+		// Type is sent by client, it doesn't have to be valid
+		uint32_t type = std::min((uint32_t)message.GetType(), Core::MessageTypeCount);
+		processedMessages[type].Add();
+		Core::ScopedTimer timer(messageDurations[type]);
+
+		// Database and serialization spans belong to trace of this message
+		Core::TraceScope trace(message.TraceId);
+		if (message.TraceId)
+			Core::Tracing::Record("queue.wait", message.TraceId, message.QueuedAt, Core::Tracing::GetTime());
+
+		Core::Span span("server.process");
+
 		if (message.GetType() == Core::MessageType::Command)
 		{
 			Core::Command command;
-			command.Deserialize(message.Body.Content);
+			{
+				Core::Span span("command.deserialize");
+				command.Deserialize(message.Body.Content);
+			}
 
 			switch (command.GetType())
 			{
 				case Core::CommandType::Query:
 				{
-					databaseInterface->Query(command);
-
 					Core::Response response(command.GetTaskId());
-					databaseInterface->FetchData(response);
 
-					SendResponse(response);
+					// Clients of one team ask for the same rows after every update broadcast
+					if (!queryCache->Get(command, response))
+					{
+						bool success = databaseInterface->Query(command);
+						databaseInterface->FetchData(response);
+
+						if (success)
+							queryCache->Add(command, response);
+					}
+
+					SendResponse(response, message);
 
 					break;
 				}
 				case Core::CommandType::Command:
 				{
+					// Contents of deleted attachments are released after their rows are deleted
+					std::vector<std::string> releasedContents;
+					ReadAttachmentContents(command, releasedContents);
+
 					bool success = databaseInterface->Execute(command);
+					if (success)
+					{
+						changeLog->Record(command);
+
+						for (const std::string& hash : releasedContents)
+							attachmentStore->Release(hash);
+					}
 
 					std::istringstream commandString(command.GetCommandString());
 					if (command.GetTaskId())
 					{
 						Core::Response response(command.GetTaskId());
-						response.AddData(new Core::DatabaseBool(success));
+						response.AddBool(success);
 
 						if (success && (commandString.str().starts_with("INSERT") || commandString.str().starts_with("insert")));
 						{
 							Core::Command com;
-							com.SetCommandString("SELECT LAST_INSERT_ID();");
+							com.SetCommandString(Core::Statements::LastInsertId);
 							databaseInterface->Query(com);
 							databaseInterface->FetchData(response);
 						}
-						SendResponse(response);
+						SendResponse(response, message);
 					}
 					
-					std::string tableName;
-					for (uint32_t i = 0; i < 3; i++) // filter 3rd word (INSERT INTO table)
-						commandString >> tableName;
+					std::string tableName = Core::StatementParser::GetWrittenTable(command.GetCommandString());
 					SendUpdateResponse(tableName);
 
 					break;
@@ -143,19 +324,18 @@ namespace Server
 				case Core::CommandType::Update:
 				{
 					bool success = databaseInterface->Update(command);
+					if (success)
+						changeLog->Record(command);
 
 					if (command.GetTaskId())
 					{
 						Core::Response response(command.GetTaskId());
-						response.AddData(new Core::DatabaseBool(success));
+						response.AddBool(success);
 
-						SendResponse(response);
+						SendResponse(response, message);
 					}
 					
-					std::istringstream commandString(command.GetCommandString());
-					std::string tableName;
-					for (uint32_t i = 0; i < 2; i++) // filter 2nd word (UPDATE table)
-						commandString >> tableName;
+					std::string tableName = Core::StatementParser::GetWrittenTable(command.GetCommandString());
 					SendUpdateResponse(tableName);
 
 					break;
@@ -169,30 +349,24 @@ namespace Server
 			Core::Command command;
 			command.SetType(Core::CommandType::Query);
 
-			command.SetCommandString("SELECT id, file_path, by_user FROM attachments WHERE assignment_id = ?;");
-			command.AddData(new Core::DatabaseInt(assignmentId));
+			command.SetCommandString(Core::Statements::SelectAssignmentAttachments);
+			command.AddInt(assignmentId);
 			databaseInterface->Query(command);
 
 			Core::Response internResponse;
 			databaseInterface->FetchData(internResponse);
 
+			// Names are in database, files are not read
 			Core::Response response(11);
 			for (uint32_t i = 0; i < internResponse.GetDataCount(); i += 3)
 			{
-				std::filesystem::path path = dir / (const char*)internResponse[i + 1].GetValue();
-				Ref<Buffer> serializedData = FileReader::ReadFile(path);
-
-				File file;
-				file.DeserializeWithoutData(serializedData);
-				response.AddData(new Core::DatabaseInt(file.GetId()));
-
-				file.SetId(*(int*)internResponse[i].GetValue());
-				response.AddData(new Core::DatabaseInt(file.GetId()));
-				response.AddData(new Core::DatabaseString(file.GetName()));
-				response.AddData(new Core::DatabaseBool(file.IsByUser()));
+				response.AddInt(assignmentId);
+				response.AddInt(internResponse.GetInt(i));
+				response.AddString(internResponse.GetString(i + 1));
+				response.AddBool(internResponse.GetBool(i + 2));
 			}
 
-			SendResponse(response);
+			SendResponse(response, message);
 		}
 		else if (message.GetType() == Core::MessageType::DownloadFile)
 		{
@@ -201,60 +375,79 @@ namespace Server
 			Core::Command command;
 			command.SetType(Core::CommandType::Query);
 
-			command.SetCommandString("SELECT file_path FROM attachments WHERE id = ?;");
-			command.AddData(new Core::DatabaseInt(attachmentId));
+			command.SetCommandString(Core::Statements::SelectAttachmentFile);
+			command.AddInt(attachmentId);
 			databaseInterface->Query(command);
 
 			Core::Response internResponse;
 			databaseInterface->FetchData(internResponse);
 
-			std::filesystem::path filePath = dir / (const char*)internResponse[0].GetValue();
-
-			Ref<Buffer> serializedData = FileReader::ReadFile(filePath);
-
-			File file;
-			file.Deserialize(serializedData);
+			// File is read on I/O thread, other messages are processed meanwhile
+			if (internResponse.HasData())
+			{
+				attachmentStore->Read(internResponse.GetString(0), [this, attachmentId, name = std::string(internResponse.GetString(1)), request = message.Header, traceId = message.TraceId](Ref<Buffer>& data) {
+					if (!data)
+					{
+						WARN("Attachment {0} could not be read!", attachmentId);
+						return;
+					}
 
-			SendFile(file);
+					File file(name.c_str(), data, false);
+					SendFile(file, request, traceId);
+				});
+			}
+			else
+				WARN("Attachment {0} doesn't exist!", attachmentId);
 		}
 		else if (message.GetType() == Core::MessageType::UploadFile)
 		{
-			// Deserialize file name and assignment id
-			File file;
-			file.DeserializeWithoutData(message.Body.Content);
-
-			if (!std::filesystem::exists(dir))
-				std::filesystem::create_directories(dir);
-
-			std::filesystem::path fileName = file.GetName();
-			std::filesystem::path filePath = dir / fileName;
-
-			// Resolve file name collisions
-			int counter = 1;
-			while (std::filesystem::exists(filePath))
+			// Serialized file starts with assignment id and name, content follows them
+			const char* body = message.Body.Content->GetData();
+			uint32_t bodySize = message.Body.Content->GetSize();
+			uint32_t dataOffset = File::GetDataOffset(body, bodySize);
+
+			uint32_t dataSize = 0;
+			if (dataOffset)
+				memcpy(&dataSize, body + dataOffset - sizeof(uint32_t), sizeof(uint32_t));
+
+			if (!dataOffset || dataSize != bodySize - dataOffset)
+				WARN("Invalid upload from session {0}!", message.GetSessionId());
+			else
 			{
-				filePath = dir / file.GetName();
-				fileName = filePath.filename().string() + "(" + std::to_string(counter) + ")";
-				filePath = dir / fileName;
-				counter++;
+				File file;
+				file.DeserializeWithoutData(message.Body.Content);
+
+				// Chunked uploads were hashed while their chunks were read
+				std::string hash = message.ContentHash.empty() ? SHA256::Hash((const uint8_t*)body + dataOffset, dataSize) : message.ContentHash;
+
+				// New content is written on I/O thread, attachment is created after it's stored
+				attachmentStore->Add(hash, message.Body.Content, dataOffset, dataSize, [this, hash, assignmentId = file.GetId(), name = std::string(file.GetName()), byUser = file.IsByUser()](bool stored) {
+					if (!stored)
+						return;
+
+					// Create attachment in db
+					Core::Command command;
+					command.SetType(Core::CommandType::Command);
+
+					command.SetCommandString(Core::Statements::InsertAttachment);
+					command.AddInt(assignmentId);
+					command.AddString(hash);
+					command.AddString(name);
+					command.AddBool(byUser);
+					if (databaseInterface->Execute(command))
+						changeLog->Record(command);
+					else
+						attachmentStore->Release(hash);
+
+					std::string tableName = "attachments";
+					SendUpdateResponse(tableName);
+				});
 			}
-
-			// Create attachment in db
-			Core::Command command;
-			command.SetType(Core::CommandType::Command);
-
-			command.SetCommandString("INSERT INTO attachments (assignment_id, file_path, by_user) VALUES (?, ?, ?);");
-			command.AddData(new Core::DatabaseInt(file.GetId()));
-			command.AddData(new Core::DatabaseString(fileName.string().c_str()));
-			command.AddData(new Core::DatabaseBool(file.IsByUser()));
-			databaseInterface->Execute(command);
-
-			FileWriter::WriteFile(filePath, message.Body.Content);
-
-			Core::Response response(10);
-			SendResponseToAllClients(response);
 		}
 
+		else if (message.GetType() == Core::MessageType::Sync)
+			SendSyncResponse(message);
+
 		messageQueue.Pop();
 		
 	#ifdef LOW_BANDWIDTH
@@ -262,15 +455,18 @@ namespace Server
 	#endif
 	}
 
-	void ServerApp::SendResponse(Core::Response& response)
+	void ServerApp::SendResponse(Core::Response& response, const Core::Message& request)
 	{
-		Core::Message& message = messageQueue.Get();
-
 		Ref<Core::Message> responseMessaage = CreateRef<Core::Message>();
 		responseMessaage->Header.Type = Core::MessageType::Response;
-		responseMessaage->Header.SessionId = message.GetSessionId();
+		responseMessaage->Header.SessionId = request.GetSessionId();
+		responseMessaage->Header.RequestId = request.GetRequestId();
+		responseMessaage->TraceId = request.TraceId;
 
-		response.Serialize(responseMessaage->Body.Content);
+		{
+			Core::Span span("response.serialize");
+			response.Serialize(responseMessaage->Body.Content);
+		}
 		responseMessaage->Header.Size = responseMessaage->Body.Content->GetSize();
 
 		networkInterface->SendMessagePackets(responseMessaage);
@@ -278,8 +474,6 @@ namespace Server
 
 	void ServerApp::SendResponseToAllClients(Core::Response& response)
 	{
-		Core::Message& message = messageQueue.Get();
-
 		Ref<Core::Message> responseMessaage = CreateRef<Core::Message>();
 		responseMessaage->Header.Type = Core::MessageType::Response;
 
@@ -291,6 +485,9 @@ namespace Server
 
 	void ServerApp::SendUpdateResponse(std::string& tableName)
 	{
+		// Before broadcast, so clients reloading after it don't get old rows
+		queryCache->Invalidate(tableName);
+
 		if (tableName == "messages")
 		{
 			Core::Response response(6);
@@ -345,13 +542,69 @@ namespace Server
 		}
 	}
 
-	void ServerApp::SendFile(File& file)
+	// Answers every scope of request with changes made since it's sequence, client then reads only changed data
+	void ServerApp::SendSyncResponse(const Core::Message& request)
 	{
-		Core::Message& message = messageQueue.Get();
+		uint32_t count = request.Body.Content ? request.Body.Content->GetSize() / sizeof(Core::SyncEntry) : 0;
+		count = std::min(count, Core::MaxSyncEntries);
+
+		Ref<Core::Message> responseMessaage = CreateRef<Core::Message>();
+		responseMessaage->Header.Type = Core::MessageType::Sync;
+		responseMessaage->Header.SessionId = request.GetSessionId();
+		responseMessaage->Header.RequestId = request.GetRequestId();
+		responseMessaage->TraceId = request.TraceId;
+
+		responseMessaage->Body.Content = CreateRef<Buffer>(count * sizeof(Core::SyncEntry));
+		responseMessaage->Header.Size = responseMessaage->Body.Content->GetSize();
+
+		// Body of request doesn't have to be aligned
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Core::SyncEntry entry;
+			memcpy(&entry, request.Body.Content->GetData() + i * sizeof(Core::SyncEntry), sizeof(entry));
+
+			entry = changeLog->GetChanges(entry);
+			memcpy(responseMessaage->Body.Content->GetData() + i * sizeof(Core::SyncEntry), &entry, sizeof(entry));
+		}
 
+		networkInterface->SendMessagePackets(responseMessaage);
+	}
+
+	// Select with the same condition as delete of attachments, before rows are deleted
+	void ServerApp::ReadAttachmentContents(const Core::Command& command, std::vector<std::string>& hashes)
+	{
+		std::string_view statement = command.GetCommandString();
+
+		Core::Command query;
+		query.SetType(Core::CommandType::Query);
+
+		if (statement == Core::Statements::DeleteAttachment)
+			query.SetCommandString(Core::Statements::SelectAttachmentContent);
+		else if (statement == Core::Statements::DeleteAssignmentAttachments)
+			query.SetCommandString(Core::Statements::SelectAssignmentAttachmentContents);
+		else
+			return;
+
+		query.AppendData(command);
+
+		if (!databaseInterface->Query(query))
+			return;
+
+		Core::Response response;
+		databaseInterface->FetchData(response);
+
+		for (uint32_t i = 0; i < response.GetDataCount(); i++)
+			hashes.push_back(response.GetString(i));
+	}
+
+	// Request header and trace id are kept by completion of file read, request message is gone by then
+	void ServerApp::SendFile(File& file, const Core::MessageHeader& request, uint64_t traceId)
+	{
 		Ref<Core::Message> responseMessaage = CreateRef<Core::Message>();
 		responseMessaage->Header.Type = Core::MessageType::DownloadFile;
-		responseMessaage->Header.SessionId = message.GetSessionId();
+		responseMessaage->Header.SessionId = request.SessionId;
+		responseMessaage->Header.RequestId = request.RequestId;
+		responseMessaage->TraceId = traceId;
 
 		responseMessaage->Body.Content = file.GetData();
 		responseMessaage->Header.Size = responseMessaage->Body.Content->GetSize();
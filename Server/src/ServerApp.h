@@ -4,7 +4,13 @@
 #include "Networking/MessageQueue.h"
 #include "Networking/Session.h"
 #include "Database/DatabaseInterface.h"
+#include "Database/QueryCache.h"
+#include "Database/ChangeLog.h"
+#include "AttachmentStore.h"
 #include "Utils/File.h"
+#include "Utils/FileIOPool.h"
+#include "Debugging/Metrics.h"
+#include "Debugging/Tracing.h"
 
 namespace Server
 {
@@ -12,6 +18,7 @@ namespace Server
 	{
 	public:
 		ServerApp(const Core::ApplicationSpecifications& specs);
+		~ServerApp();
 
 		virtual void OnEvent(Core::Event& e) override;
 	private:
@@ -29,19 +36,60 @@ namespace Server
 		void ProcessMessageQueue() override;
 		void ProcessMessage();
 
-		void SendResponse(Core::Response& response);
+		// First SIGINT or SIGTERM drains server, second one stops it right away
+		void OnShutdownRequested() override;
+		void Drain();
+
+		// Responses are routed by request message, so they can be completed in any order
+		void SendResponse(Core::Response& response, const Core::Message& request);
 		void SendResponseToAllClients(Core::Response& response);
 		void SendUpdateResponse(std::string& tableName);
-		void SendFile(File& file);
+		void SendFile(File& file, const Core::MessageHeader& request, uint64_t traceId);
+		void SendSyncResponse(const Core::Message& request);
+
+		void ReadAttachmentContents(const Core::Command& command, std::vector<std::string>& hashes);
 
 		std::filesystem::path dir = std::filesystem::current_path() / "Attachments";
+		Ref<AttachmentStore> attachmentStore;
+
+		Ref<FileIOPool> fileIO;
+		uint32_t fileIOThreads = 2; // Attachments are read and written on these threads
 
 		Ref<Core::NetworkServerInterface> networkInterface;
 		std::deque<Ref<Core::Session>> sessions;
 		Core::MessageQueue messageQueue;
 
 		Ref<Core::DatabaseInterface> databaseInterface;
+		Core::DatabaseSpecifications databaseSpecs;
+
+		Ref<Core::QueryCache> queryCache;
+		uint32_t queryCacheSize = 64; // MB, 0 disables cache
+
+		Ref<Core::ChangeLog> changeLog;
 
 		uint32_t port = 0;
+
+		uint32_t shutdownTimeout = 30; // Seconds to finish accepted messages and send their responses after shutdown is requested
+		std::chrono::steady_clock::time_point drainDeadline;
+		bool draining = false;
+
+		std::string logLevel = "debug";
+		std::string logFile = "none"; // Binary log, console only if none
+
+		std::string metricsFile = "metrics.txt";
+		uint32_t metricsInterval = 10; // Seconds, 0 dumps only on SIGUSR1
+		uint16_t statsPort = 0; // Loopback stats endpoint, disabled if 0
+
+		uint32_t traceSample = 0; // Every n-th request is traced, 0 disables tracing
+		std::string traceFile = "trace.json"; // Written when server stops
+
+		// Metrics of processed messages, indexed by MessageType, last one counts unknown types
+		Core::Counter processedMessages[Core::MessageTypeCount + 1];
+		Core::Histogram messageDurations[Core::MessageTypeCount + 1];
+
+		// Server has one database connection, reported as pool of one
+		Core::Gauge databaseConnections = Core::Metrics::GetGauge("db_pool_connections_open");
+		Core::Counter databaseReconnects = Core::Metrics::GetCounter("db_reconnects_total");
+		bool databaseConnected = false;
 	};
 }
\ No newline at end of file
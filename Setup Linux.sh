@@ -0,0 +1,6 @@
+#!/bin/sh
+# Generates makefiles for headless build (Core, Server and LoadGen), use --asio-io-uring for io_uring backend
+PREMAKE=vendor/premake/premake5
+[ -x "$PREMAKE" ] || PREMAKE=premake5
+
+$PREMAKE gmake2 --os=linux "$@"
@@ -1,6 +1,18 @@
+newoption
+{
+	trigger = "asio-io-uring",
+	description = "Use io_uring instead of epoll as asio backend on Linux (requires liburing)"
+}
+
+newoption
+{
+	trigger = "sqlite",
+	description = "Build SQLite database backend (requires sqlite3)"
+}
+
 workspace "DMP"
 	architecture "x64"
-	platforms { "Win64" }
+	platforms { "Win64", "Linux64" }
 
 	startproject "Client"
 
@@ -16,13 +28,26 @@ workspace "DMP"
 		"MultiProcessorCompile"
 	}
 
-	outputdir = "$(SolutionDir)bin/"
-	intoutputdir = "$(SolutionDir)bin-int/"
+	outputdir = "%{wks.location}/bin/"
+	intoutputdir = "%{wks.location}/bin-int/"
 
-	defines { "_CRT_SECURE_NO_WARNINGS" }
+	filter "platforms:Win64"
+		system "windows"
+
+	filter "platforms:Linux64"
+		system "linux"
 
 	filter "system:windows"
-		defines { "PLATFORM_WINDOWS" }
+		defines { "PLATFORM_WINDOWS", "_CRT_SECURE_NO_WARNINGS" }
+
+	filter "system:linux"
+		defines { "PLATFORM_LINUX" }
+
+	filter { "system:linux", "options:asio-io-uring" }
+		defines { "ASIO_HAS_IO_URING", "ASIO_DISABLE_EPOLL" }
+
+	filter "options:sqlite"
+		defines { "DATABASE_SQLITE" }
 
 	filter "configurations:Debug"
 			defines "DEBUG_CONFIG"
@@ -39,12 +64,21 @@ workspace "DMP"
 		runtime "Release"
 		optimize "on"
 
-group "vendor"
-	include "vendor/glfw"
-	include "vendor/imgui"
-	include "vendor/ImGuiDatePicker"
-group ""
+-- Client and it's graphics dependencies are built only on Windows, Linux build is headless
+if os.target() == "windows" then
+	group "vendor"
+		include "vendor/glfw"
+		include "vendor/imgui"
+		include "vendor/ImGuiDatePicker"
+	group ""
+end
 
 include "Core"
 include "Server"
-include "Client"
\ No newline at end of file
+include "LoadGen"
+include "LogDecode"
+include "CoreBench"
+
+if os.target() == "windows" then
+	include "Client"
+end